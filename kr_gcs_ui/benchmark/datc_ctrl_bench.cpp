@@ -0,0 +1,224 @@
+/**
+ * @file datc_ctrl_bench.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief DatcCtrl hot paths against the in-memory slave of mock_modbus.cpp: command encoding, status
+ *        decode, the range clamps, grp_state message construction and status copies. Baseline for
+ *        optimizations; run with --benchmark_out=<file> --benchmark_out_format=json to keep the results.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "datc_ros_interface.hpp"
+#include "mock_modbus.hpp"
+#include <benchmark/benchmark.h>
+
+// command() is protected
+class BenchDatcCtrl : public DatcCtrl {
+public:
+    using DatcCtrl::command;
+};
+
+const char *kBenchPort = "/dev/mock";
+
+struct CommandCase {
+    DATC_COMMAND cmd;
+    const char *name;
+};
+
+const CommandCase kCommandCases[] = {
+    {DATC_COMMAND::MOTOR_ENABLE,           "MOTOR_ENABLE"},
+    {DATC_COMMAND::MOTOR_STOP,             "MOTOR_STOP"},
+    {DATC_COMMAND::MOTOR_DISABLE,          "MOTOR_DISABLE"},
+    {DATC_COMMAND::MOTOR_POSITION_CONTROL, "MOTOR_POSITION_CONTROL"},
+    {DATC_COMMAND::MOTOR_VELOCITY_CONTROL, "MOTOR_VELOCITY_CONTROL"},
+    {DATC_COMMAND::MOTOR_CURRENT_CONTROL,  "MOTOR_CURRENT_CONTROL"},
+    {DATC_COMMAND::CHANGE_MODBUS_ADDRESS,  "CHANGE_MODBUS_ADDRESS"},
+    {DATC_COMMAND::GRIPPER_INITIALIZE,     "GRIPPER_INITIALIZE"},
+    {DATC_COMMAND::GRIPPER_OPEN,           "GRIPPER_OPEN"},
+    {DATC_COMMAND::GRIPPER_CLOSE,          "GRIPPER_CLOSE"},
+    {DATC_COMMAND::SET_FINGER_POSITION,    "SET_FINGER_POSITION"},
+    {DATC_COMMAND::VACUUM_GRIPPER_ON,      "VACUUM_GRIPPER_ON"},
+    {DATC_COMMAND::VACUUM_GRIPPER_OFF,     "VACUUM_GRIPPER_OFF"},
+    {DATC_COMMAND::IMPEDANCE_ON,           "IMPEDANCE_ON"},
+    {DATC_COMMAND::IMPEDANCE_OFF,          "IMPEDANCE_OFF"},
+    {DATC_COMMAND::SET_IMPEDANCE_PARAMS,   "SET_IMPEDANCE_PARAMS"},
+    {DATC_COMMAND::SET_MOTOR_TORQUE,       "SET_MOTOR_TORQUE"},
+    {DATC_COMMAND::SET_MOTOR_SPEED,        "SET_MOTOR_SPEED"},
+};
+
+const size_t kCommandCaseCount = sizeof(kCommandCases) / sizeof(kCommandCases[0]);
+
+// Status block of the default register map: closed, position control, enabled
+static void fillStatusRegisters(const RegisterMap &map) {
+    uint16_t *regs = mockModbusRegisters() + map.status_addr;
+
+    for (int i = 0; i < map.status_count; i++) {
+        regs[i] = 0;
+    }
+
+    regs[0] = 0x0045;
+
+    if (map.motor_pos >= 0)  regs[map.motor_pos]  = 90;
+    if (map.motor_cur >= 0)  regs[map.motor_cur]  = 250;
+    if (map.motor_vel >= 0)  regs[map.motor_vel]  = (uint16_t) -12;
+    if (map.finger_pos >= 0) regs[map.finger_pos] = 1000;
+    if (map.voltage >= 0)    regs[map.voltage]    = 240;
+}
+
+// One connected instance for all benchmarks. The log lines (connecting, clamps) go nowhere, so that a
+// clamped value costs what the logging threads pay and the output stays readable.
+static BenchDatcCtrl *getDatc(benchmark::State &state) {
+    static BenchDatcCtrl datc;
+    static bool connected = false;
+
+    if (!connected) {
+        AsyncLogger::instance().setSink(&datc, [] (LOG_LEVEL, const char *) {});
+        connected = datc.modbusInit(kBenchPort, 1, 115200);
+    }
+
+    if (!connected) {
+        state.SkipWithError("Mock Modbus init failed");
+        return NULL;
+    }
+
+    datc.setReadProfile(READ_PROFILE::FULL, 10);
+    fillStatusRegisters(datc.getRegisterMap());
+
+    return &datc;
+}
+
+// Argument: index into kCommandCases. Items = Modbus transactions.
+static void BM_Command(benchmark::State &state) {
+    const CommandCase &cmd_case = kCommandCases[state.range(0)];
+    BenchDatcCtrl *datc = getDatc(state);
+
+    if (datc == NULL) {
+        return;
+    }
+
+    state.SetLabel(cmd_case.name);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(datc->command(cmd_case.cmd, 500, 1000));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Command)->DenseRange(0, kCommandCaseCount - 1);
+
+// Argument: READ_PROFILE (FULL, MINIMAL, STATUS, MIXED)
+static void BM_ReadDatcData(benchmark::State &state) {
+    const READ_PROFILE profile = (READ_PROFILE) state.range(0);
+    BenchDatcCtrl *datc = getDatc(state);
+
+    if (datc == NULL) {
+        return;
+    }
+
+    datc->setReadProfile(profile, 10);
+    state.SetLabel(DatcCtrl::getReadProfileName(profile));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(datc->readDatcData());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ReadDatcData)->DenseRange(0, 3);
+
+// Range clamps. Argument 0: value in range; 1: clamped, with its log line (rate limited per site)
+static void BM_SetFingerPos(benchmark::State &state) {
+    const bool clamped = state.range(0);
+    BenchDatcCtrl *datc = getDatc(state);
+
+    if (datc == NULL) {
+        return;
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(datc->setFingerPos(clamped ? 12000 : 5000));
+    }
+}
+BENCHMARK(BM_SetFingerPos)->Arg(0)->Arg(1);
+
+static void BM_MotorVelCtrl(benchmark::State &state) {
+    const bool clamped = state.range(0);
+    BenchDatcCtrl *datc = getDatc(state);
+
+    if (datc == NULL) {
+        return;
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(datc->motorVelCtrl(clamped ? -50 : -300));
+    }
+}
+BENCHMARK(BM_MotorVelCtrl)->Arg(0)->Arg(1);
+
+static void BM_MotorCurCtrl(benchmark::State &state) {
+    const bool clamped = state.range(0);
+    BenchDatcCtrl *datc = getDatc(state);
+
+    if (datc == NULL) {
+        return;
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(datc->motorCurCtrl(clamped ? 1500 : 600));
+    }
+}
+BENCHMARK(BM_MotorCurCtrl)->Arg(0)->Arg(1);
+
+static void BM_SetImpedanceParams(benchmark::State &state) {
+    const bool clamped = state.range(0);
+    BenchDatcCtrl *datc = getDatc(state);
+
+    if (datc == NULL) {
+        return;
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(datc->setImpedanceParams(clamped ? 0 : 1, clamped ? 20 : 5));
+    }
+}
+BENCHMARK(BM_SetImpedanceParams)->Arg(0)->Arg(1);
+
+// grp_state message as pubTopic() builds it, without the publish
+static void BM_GripperMsg(benchmark::State &state) {
+    BenchDatcCtrl *datc = getDatc(state);
+
+    if (datc == NULL) {
+        return;
+    }
+
+    datc->readDatcData();
+    const DatcStatus status = datc->getDatcStatus();
+
+    for (auto _ : state) {
+        auto msg_ptr = make_unique<GripperMsg>();
+        DatcRosInterface::toGripperMsg(status, *msg_ptr);
+        benchmark::DoNotOptimize(msg_ptr.get());
+    }
+}
+BENCHMARK(BM_GripperMsg);
+
+// The copy that every reader of the status makes
+static void BM_GetDatcStatus(benchmark::State &state) {
+    BenchDatcCtrl *datc = getDatc(state);
+
+    if (datc == NULL) {
+        return;
+    }
+
+    datc->readDatcData();
+
+    for (auto _ : state) {
+        DatcStatus status = datc->getDatcStatus();
+        benchmark::DoNotOptimize(status);
+    }
+}
+BENCHMARK(BM_GetDatcStatus);
+
+BENCHMARK_MAIN();
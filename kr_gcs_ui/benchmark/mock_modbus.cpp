@@ -0,0 +1,118 @@
+/**
+ * @file mock_modbus.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "mock_modbus.hpp"
+
+#include <modbus/modbus-rtu.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+struct _modbus {
+    int slave = -1;
+    bool connected = false;
+};
+
+static _modbus g_context;
+static uint16_t g_registers[kMockRegisterCount];
+static std::atomic<uint64_t> g_transactions {0};
+static std::atomic<bool> g_fail {false};
+
+uint16_t *mockModbusRegisters() {
+    return g_registers;
+}
+
+uint64_t mockModbusTransactions() {
+    return g_transactions;
+}
+
+void mockModbusSetFail(bool fail) {
+    g_fail = fail;
+}
+
+static bool inRange(int addr, int nb) {
+    return addr >= 0 && nb >= 1 && addr + nb <= kMockRegisterCount;
+}
+
+// Counts the transaction, false (errno set) if it fails
+static bool transact(int addr, int nb) {
+    g_transactions++;
+
+    if (g_fail) {
+        errno = EIO;
+        return false;
+    } else if (!inRange(addr, nb)) {
+        errno = EMBXILADD;
+        return false;
+    }
+
+    return true;
+}
+
+extern "C" {
+
+modbus_t *modbus_new_rtu(const char *, int, char, int, int) {
+    g_context = _modbus();
+    return &g_context;
+}
+
+int modbus_rtu_set_serial_mode(modbus_t *, int) {return 0;}
+int modbus_rtu_set_rts_delay(modbus_t *, int) {return 0;}
+int modbus_set_debug(modbus_t *, int) {return 0;}
+
+int modbus_set_slave(modbus_t *ctx, int slave) {
+    ctx->slave = slave;
+    return 0;
+}
+
+int modbus_connect(modbus_t *ctx) {
+    ctx->connected = true;
+    return 0;
+}
+
+void modbus_close(modbus_t *ctx) {
+    ctx->connected = false;
+}
+
+void modbus_free(modbus_t *) {}
+
+const char *modbus_strerror(int errnum) {
+    return strerror(errnum);
+}
+
+int modbus_write_register(modbus_t *, int addr, const uint16_t value) {
+    if (!transact(addr, 1)) {
+        return -1;
+    }
+
+    g_registers[addr] = value;
+    return 1;
+}
+
+int modbus_write_registers(modbus_t *, int addr, int nb, const uint16_t *src) {
+    if (!transact(addr, nb)) {
+        return -1;
+    }
+
+    memcpy(&g_registers[addr], src, nb * sizeof(uint16_t));
+    return nb;
+}
+
+int modbus_read_registers(modbus_t *, int addr, int nb, uint16_t *dest) {
+    if (!transact(addr, nb)) {
+        return -1;
+    }
+
+    memcpy(dest, &g_registers[addr], nb * sizeof(uint16_t));
+    return nb;
+}
+
+}
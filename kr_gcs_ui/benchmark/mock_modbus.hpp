@@ -0,0 +1,28 @@
+/**
+ * @file mock_modbus.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief In-memory stand-in for the libmodbus RTU calls that ModbusComm makes. Linked into a benchmark
+ *        instead of libmodbus, so that DatcCtrl and ModbusComm run unchanged without a serial port.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef MOCK_MODBUS_HPP
+#define MOCK_MODBUS_HPP
+
+#include <cstdint>
+
+const int kMockRegisterCount = 256;
+
+// Holding registers of the mock slave, written by FC06/FC16 and read by FC03
+uint16_t *mockModbusRegisters();
+
+// Register transactions since the start, successful or not
+uint64_t mockModbusTransactions();
+
+// The next read / write fails (returns -1 with errno EIO) while set
+void mockModbusSetFail(bool fail);
+
+#endif // MOCK_MODBUS_HPP
@@ -0,0 +1,129 @@
+/**
+ * @file modbus_rtu_codec_bench.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Throughput of the Modbus RTU codec and its CRC kernels.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "modbus_rtu_codec.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace modbus_rtu;
+
+static void fillPattern(uint8_t *buf, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t) (i * 31 + 7);
+    }
+}
+
+// CRC kernels, argument = payload bytes (8: FC03 request, 21: DATC status response, 254: max ADU)
+static void BM_Crc16Bitwise(benchmark::State &state) {
+    uint8_t buf[kMaxAduLength];
+    fillPattern(buf, sizeof(buf));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(crc16Bitwise(buf, state.range(0)));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Crc16Bitwise)->Arg(6)->Arg(19)->Arg(254);
+
+static void BM_Crc16Table(benchmark::State &state) {
+    uint8_t buf[kMaxAduLength];
+    fillPattern(buf, sizeof(buf));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(crc16Table(buf, state.range(0)));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Crc16Table)->Arg(6)->Arg(19)->Arg(254);
+
+static void BM_Crc16SliceBy8(benchmark::State &state) {
+    uint8_t buf[kMaxAduLength];
+    fillPattern(buf, sizeof(buf));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(crc16(buf, state.range(0)));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Crc16SliceBy8)->Arg(6)->Arg(19)->Arg(254);
+
+// Frames per second (items/s) for encode + parse round trips of each DATC function code
+static void BM_Fc03RoundTrip(benchmark::State &state) {
+    uint8_t req[kMaxAduLength], res[kMaxAduLength];
+    uint16_t regs[8] = {0x0041, 90, 12, 0, 1000, 0, 0, 240};
+    FrameView frame;
+
+    for (auto _ : state) {
+        size_t len = encodeReadRegisters(req, sizeof(req), 1, 10, 8);
+        benchmark::DoNotOptimize(parseRequest(req, len, frame));
+
+        len = encodeRegistersResponse(res, sizeof(res), 1, FUNCTION_CODE::READ_HOLDING_REGISTERS, regs, 8);
+        benchmark::DoNotOptimize(parseResponse(res, len, frame));
+        benchmark::DoNotOptimize(frame.registerAt(4));
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_Fc03RoundTrip);
+
+static void BM_Fc06RoundTrip(benchmark::State &state) {
+    uint8_t req[kMaxAduLength], res[kMaxAduLength];
+    FrameView frame;
+
+    for (auto _ : state) {
+        size_t len = encodeWriteRegister(req, sizeof(req), 1, 0, 103);
+        benchmark::DoNotOptimize(parseRequest(req, len, frame));
+
+        len = encodeWriteResponse(res, sizeof(res), 1, FUNCTION_CODE::WRITE_SINGLE_REGISTER, 0, 103);
+        benchmark::DoNotOptimize(parseResponse(res, len, frame));
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_Fc06RoundTrip);
+
+static void BM_Fc16RoundTrip(benchmark::State &state) {
+    uint8_t req[kMaxAduLength], res[kMaxAduLength];
+    uint16_t cmd[3] = {5, 90, 500};
+    FrameView frame;
+
+    for (auto _ : state) {
+        size_t len = encodeWriteRegisters(req, sizeof(req), 1, 0, cmd, 3);
+        benchmark::DoNotOptimize(parseRequest(req, len, frame));
+
+        len = encodeWriteResponse(res, sizeof(res), 1, FUNCTION_CODE::WRITE_MULTIPLE_REGISTERS, 0, 3);
+        benchmark::DoNotOptimize(parseResponse(res, len, frame));
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_Fc16RoundTrip);
+
+static void BM_Fc23RoundTrip(benchmark::State &state) {
+    uint8_t req[kMaxAduLength], res[kMaxAduLength];
+    uint16_t cmd[2] = {104, 500};
+    uint16_t regs[8] = {0x0041, 90, 12, 0, 1000, 0, 0, 240};
+    FrameView frame;
+
+    for (auto _ : state) {
+        size_t len = encodeReadWriteRegisters(req, sizeof(req), 1, 10, 8, 0, cmd, 2);
+        benchmark::DoNotOptimize(parseRequest(req, len, frame));
+
+        len = encodeRegistersResponse(res, sizeof(res), 1, FUNCTION_CODE::READ_WRITE_MULTIPLE_REGISTERS, regs, 8);
+        benchmark::DoNotOptimize(parseResponse(res, len, frame));
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_Fc23RoundTrip);
+
+BENCHMARK_MAIN();
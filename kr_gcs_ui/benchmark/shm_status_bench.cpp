@@ -0,0 +1,202 @@
+/**
+ * @file shm_status_bench.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Status shared memory against a ROS topic: read cost, and writer -> reader latency on the same host.
+ *        The latency benchmarks report manual time, i.e. the delivery latency of one sample.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "shm_status_writer.hpp"
+#include <benchmark/benchmark.h>
+#include <rclcpp/rclcpp.hpp>
+
+#include <atomic>
+#include <thread>
+
+#include "grp_control_msg/msg/gripper_msg.hpp"
+
+using grp_control_msg::msg::GripperMsg;
+
+const char *kBenchShmName = "/datc_status_bench";
+
+static int64_t nowNs() {
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec * 1000000000L + time.tv_nsec;
+}
+
+static DatcStatus makeStatus(int i) {
+    DatcStatus status;
+    status.states     = 0x0041;
+    status.motor_pos  = (int16_t) i;
+    status.motor_vel  = 12;
+    status.motor_cur  = 250;
+    status.finger_pos = 500;
+    status.voltage    = 240;
+    return status;
+}
+
+static void BM_ShmWrite(benchmark::State &state) {
+    ShmStatusWriter writer;
+    string error;
+
+    if (!writer.open(kBenchShmName, error)) {
+        state.SkipWithError(error.c_str());
+        return;
+    }
+
+    const DatcStatus status = makeStatus(0);
+    int64_t stamp = 0;
+
+    for (auto _ : state) {
+        writer.write(status, DATC_SHM_FLAG_CONNECTED, ++stamp);
+    }
+}
+BENCHMARK(BM_ShmWrite);
+
+// Argument 0: nobody writes; 1: another thread writes back to back, so reads collide and retry
+static void BM_ShmRead(benchmark::State &state) {
+    ShmStatusWriter writer;
+    string error;
+
+    if (!writer.open(kBenchShmName, error)) {
+        state.SkipWithError(error.c_str());
+        return;
+    }
+
+    writer.write(makeStatus(0), DATC_SHM_FLAG_CONNECTED, nowNs());
+
+    const datc_shm_segment_t *segment = datc_shm_open(kBenchShmName);
+    atomic<bool> stop {false};
+    thread writer_thread;
+
+    if (state.range(0)) {
+        writer_thread = thread([&] () {
+            for (int i = 1; !stop; i++) {
+                writer.write(makeStatus(i), DATC_SHM_FLAG_CONNECTED, i);
+            }
+        });
+    }
+
+    datc_shm_sample_t sample {};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(datc_shm_read(segment, &sample));
+    }
+
+    stop = true;
+
+    if (writer_thread.joinable()) {
+        writer_thread.join();
+    }
+
+    datc_shm_close(segment);
+}
+BENCHMARK(BM_ShmRead)->Arg(0)->Arg(1);
+
+// One sample at a time: the writer stamps and writes, the reader polls until it sees it
+static void BM_ShmLatency(benchmark::State &state) {
+    ShmStatusWriter writer;
+    string error;
+
+    if (!writer.open(kBenchShmName, error)) {
+        state.SkipWithError(error.c_str());
+        return;
+    }
+
+    const datc_shm_segment_t *segment = datc_shm_open(kBenchShmName);
+    atomic<uint64_t> acked {0};
+    atomic<bool> stop {false};
+
+    thread writer_thread([&] () {
+        uint64_t written = 0;
+
+        while (!stop) {
+            if (acked == written) {
+                writer.write(makeStatus((int) written), DATC_SHM_FLAG_CONNECTED, nowNs());
+                written++;
+            } else {
+                this_thread::yield();
+            }
+        }
+    });
+
+    datc_shm_sample_t sample {};
+    uint64_t last = 0;
+
+    for (auto _ : state) {
+        // Yields so that the benchmark also means something on a machine with fewer cores than threads
+        while (!datc_shm_read(segment, &sample) || sample.sequence <= last) {
+            this_thread::yield();
+        }
+
+        state.SetIterationTime((nowNs() - sample.stamp_ns) * 1e-9);
+
+        last  = sample.sequence;
+        acked = last;
+    }
+
+    stop = true;
+    writer_thread.join();
+
+    datc_shm_close(segment);
+}
+BENCHMARK(BM_ShmLatency)->UseManualTime();
+
+// The same with grp_state's message through the rmw, between two nodes of one process without
+// intra-process communication. A subscriber in another process, as the shared memory readers are,
+// only adds to this.
+static void BM_RosTopicLatency(benchmark::State &state) {
+    auto node_pub = make_shared<rclcpp::Node>("shm_bench_pub");
+    auto node_sub = make_shared<rclcpp::Node>("shm_bench_sub");
+
+    atomic<uint64_t> received {0};
+    atomic<int64_t> received_ns {0};
+
+    auto publisher    = node_pub->create_publisher<GripperMsg>("shm_bench", 10);
+    auto subscription = node_sub->create_subscription<GripperMsg>("shm_bench", 10,
+                        [&] (GripperMsg::UniquePtr) {
+                            received_ns = nowNs();
+                            received++;
+                        });
+
+    rclcpp::executors::SingleThreadedExecutor executor;
+    executor.add_node(node_sub);
+    thread spin_thread([&] () {executor.spin();});
+
+    while (publisher->get_subscription_count() == 0) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+
+    for (auto _ : state) {
+        const uint64_t expected = received + 1;
+        const int64_t time_pub  = nowNs();
+
+        publisher->publish(GripperMsg());
+
+        while (received < expected) {
+            this_thread::yield();
+        }
+
+        state.SetIterationTime((received_ns - time_pub) * 1e-9);
+    }
+
+    executor.cancel();
+    spin_thread.join();
+}
+BENCHMARK(BM_RosTopicLatency)->UseManualTime();
+
+int main(int argc, char **argv) {
+    rclcpp::init(argc, argv);
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    rclcpp::shutdown();
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file fuzz_check.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Invariant checks shared by the libFuzzer harnesses. A failed check aborts, which the fuzzer
+ *        reports as a crash together with the input that caused it.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef FUZZ_CHECK_HPP
+#define FUZZ_CHECK_HPP
+
+#include "modbus_rtu_codec.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#define FUZZ_CHECK(cond)                                                              \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);  \
+            abort();                                                                  \
+        }                                                                             \
+    } while (0)
+
+// A frame parsed from buf[0, len): within the buffer, its payload too, and the CRC is right
+inline void checkFrame(const uint8_t *buf, size_t len, const modbus_rtu::FrameView &frame) {
+    FUZZ_CHECK(frame.length >= 4 && frame.length <= len && frame.length <= modbus_rtu::kMaxAduLength);
+
+    if (frame.data != nullptr) {
+        FUZZ_CHECK(frame.data >= buf && frame.data + 2 * (size_t) frame.data_registers <= buf + frame.length - 2);
+
+        uint32_t sum = 0;
+
+        for (size_t i = 0; i < frame.data_registers; i++) {
+            sum += frame.registerAt(i);
+        }
+
+        (void) sum;
+    }
+
+    const uint16_t crc = (uint16_t) (buf[frame.length - 2] | (buf[frame.length - 1] << 8));
+
+    FUZZ_CHECK(modbus_rtu::crc16(buf, frame.length - 2) == crc);
+    FUZZ_CHECK(modbus_rtu::crc16Bitwise(buf, frame.length - 2) == crc);
+}
+
+// The encoder gives back exactly the bytes that were parsed
+inline void checkRoundTrip(const uint8_t *buf, const modbus_rtu::FrameView &frame, const uint8_t *encoded,
+                           size_t encoded_len) {
+    FUZZ_CHECK(encoded_len == frame.length);
+    FUZZ_CHECK(memcmp(buf, encoded, encoded_len) == 0);
+}
+
+#endif // FUZZ_CHECK_HPP
@@ -0,0 +1,66 @@
+/**
+ * @file fuzz_replay_main.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Stand-in for the libFuzzer driver on compilers without -fsanitize=fuzzer: runs
+ *        LLVMFuzzerTestOneInput() once per file given on the command line (directories are walked),
+ *        so a corpus or a crash reproducer can be replayed under ASan/UBSan with GCC.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using namespace std;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+static bool runFile(const filesystem::path &path) {
+    ifstream in(path, ios::binary);
+
+    if (!in) {
+        fprintf(stderr, "Cannot open %s\n", path.c_str());
+        return false;
+    }
+
+    vector<uint8_t> data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+
+    LLVMFuzzerTestOneInput(data.data(), data.size());
+    return true;
+}
+
+int main(int argc, char **argv) {
+    size_t runs = 0;
+    bool ok = true;
+
+    for (int i = 1; i < argc; i++) {
+        // libFuzzer flags (-runs=0, -max_len=...) are accepted so that both builds share a command line
+        if (argv[i][0] == '-') {
+            continue;
+        }
+
+        const filesystem::path path(argv[i]);
+
+        if (filesystem::is_directory(path)) {
+            for (const auto &entry : filesystem::recursive_directory_iterator(path)) {
+                if (entry.is_regular_file()) {
+                    ok = runFile(entry.path()) && ok;
+                    runs++;
+                }
+            }
+        } else {
+            ok = runFile(path) && ok;
+            runs++;
+        }
+    }
+
+    printf("Executed %zu inputs\n", runs);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file modbus_rtu_response_fuzz.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief libFuzzer harness for modbus_rtu::parseResponse(): the input is a byte stream as the master
+ *        reads it, parsed frame after frame with a one-byte resync on errors. Every frame parsed has
+ *        to stay within the input and re-encode to the same bytes.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "fuzz_check.hpp"
+
+using namespace modbus_rtu;
+
+static void roundTrip(const uint8_t *buf, const FrameView &frame) {
+    uint8_t encoded[kMaxAduLength];
+    uint16_t values[kMaxReadRegisters];
+    size_t len = 0;
+
+    for (size_t i = 0; i < frame.data_registers; i++) {
+        values[i] = frame.registerAt(i);
+    }
+
+    if (frame.isException()) {
+        len = encodeException(encoded, sizeof(encoded), frame.slave, frame.function, frame.exception_code);
+        checkRoundTrip(buf, frame, encoded, len);
+        return;
+    }
+
+    switch ((FUNCTION_CODE) frame.function) {
+        case FUNCTION_CODE::READ_HOLDING_REGISTERS:
+        case FUNCTION_CODE::READ_WRITE_MULTIPLE_REGISTERS:
+            len = encodeRegistersResponse(encoded, sizeof(encoded), frame.slave, (FUNCTION_CODE) frame.function,
+                                          values, frame.data_registers);
+            break;
+
+        case FUNCTION_CODE::WRITE_SINGLE_REGISTER:
+        case FUNCTION_CODE::WRITE_MULTIPLE_REGISTERS:
+            len = encodeWriteResponse(encoded, sizeof(encoded), frame.slave, (FUNCTION_CODE) frame.function,
+                                      frame.address, frame.quantity);
+            break;
+    }
+
+    checkRoundTrip(buf, frame, encoded, len);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    size_t pos = 0;
+
+    while (pos < size) {
+        FrameView frame;
+        const PARSE_RESULT result = parseResponse(data + pos, size - pos, frame);
+
+        if (result == PARSE_RESULT::INCOMPLETE) {
+            break;
+        } else if (result != PARSE_RESULT::OK) {
+            pos++;
+            continue;
+        }
+
+        checkFrame(data + pos, size - pos, frame);
+        FUZZ_CHECK(frame.isException() == ((data[pos + 1] & 0x80) != 0));
+        roundTrip(data + pos, frame);
+
+        pos += frame.length;
+    }
+
+    return 0;
+}
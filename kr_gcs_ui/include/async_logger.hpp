@@ -0,0 +1,160 @@
+/**
+ * @file async_logger.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Logging for the bus, poll and service threads that never blocks them: the message is formatted
+ *        into a lock-free ring and written out by a background thread (to rclcpp logging, a file or
+ *        stdout / stderr). Each call site is rate limited, and repeated lines are collapsed.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef ASYNC_LOGGER_HPP
+#define ASYNC_LOGGER_HPP
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+const size_t   kLogTextMax       = 240;         // Longer messages are truncated
+const size_t   kLogQueueSize     = 256;         // Records in the ring, power of two
+const uint32_t kLogSiteBurst     = 5;           // Messages per call site and window, the rest is counted
+const int64_t  kLogSiteWindowNs  = 1000000000;
+const int64_t  kLogRepeatFlushNs = 1000000000;  // "repeated N times" after this long without another copy
+const int      kLogWritePeriodMs = 10;
+
+enum class LOG_LEVEL {
+    DEBUG,
+    INFO,
+    WARN,
+    ERROR,
+};
+
+// One per call site, a static made by DATC_LOG
+struct LogSite {
+    const char *file;
+    int line;
+
+    atomic<int64_t> window_start_ns {0};
+    atomic<uint32_t> window_count {0};
+    atomic<uint32_t> suppressed {0};
+
+    atomic<bool> registered {false};
+    LogSite *next = NULL;
+};
+
+// Called on the writer thread with one line, without a trailing newline
+using LogSink = function<void(LOG_LEVEL level, const char *text)>;
+
+class AsyncLogger {
+public:
+    static AsyncLogger &instance();
+
+    // Never blocks nor allocates: past kLogSiteBurst in a window the message is only counted, and it
+    // is dropped (and counted) if the ring is full
+    void log(LogSite &site, LOG_LEVEL level, const char *format, ...) __attribute__((format(printf, 4, 5)));
+
+    void setLevel(LOG_LEVEL level) {level_ = level;}
+    LOG_LEVEL getLevel() const {return level_;}
+    bool isEnabled(LOG_LEVEL level) const {return level >= level_;}
+
+    // Level, sink and file are process-wide. Several owners (nodes in one container) can each set a sink;
+    // lines go to the one set last of those still set, and an empty sink takes the owner's back. With
+    // none: stdout, and stderr from WARN on.
+    void setSink(const void *owner, LogSink sink);
+
+    // Lines go to the file (appended, with a wall clock stamp) instead of the sink; empty path closes it
+    bool setFile(const string &path, string &error);
+    string getFile();
+
+    // Until what was logged before the call is written, at most timeout_ms
+    void flush(int timeout_ms = 1000);
+
+    // Writes out the ring and stops the thread; later messages are written by the caller. At exit.
+    void shutdown();
+
+    uint64_t getDroppedCount() const {return dropped_;}
+    uint64_t getSuppressedCount() const {return suppressed_;}
+
+    static bool parseLevel(const string &str, LOG_LEVEL &level);
+    static const char *getLevelName(LOG_LEVEL level);
+
+private:
+    AsyncLogger();
+
+    struct LogRecord {
+        LOG_LEVEL level;
+        const LogSite *site;
+        int64_t stamp_ns;     // CLOCK_REALTIME
+        uint32_t suppressed;  // Messages of the site suppressed before this one
+        char text[kLogTextMax];
+    };
+
+    struct Slot {
+        atomic<size_t> sequence;
+        LogRecord record;
+    };
+
+    atomic<LOG_LEVEL> level_ {LOG_LEVEL::INFO};
+
+    // Bounded multi-producer ring (sequence per slot); popped by the writer thread only
+    Slot slots_[kLogQueueSize];
+    atomic<size_t> enqueue_pos_ {0};
+    size_t dequeue_pos_ = 0;
+    atomic<size_t> written_pos_ {0};
+
+    atomic<LogSite *> sites_ {NULL};
+
+    atomic<uint64_t> dropped_ {0};
+    atomic<uint64_t> suppressed_ {0};
+    uint64_t dropped_reported_ = 0;
+
+    // Writer thread; output_mutex_ is never taken by the logging threads
+    thread writer_thread_;
+    atomic<bool> running_ {false};
+    mutex output_mutex_;
+    vector<pair<const void *, LogSink>> sinks_;
+    FILE *file_ = NULL;
+    string file_path_;
+
+    // Last line written, for collapsing repeats
+    LogRecord last_;
+    bool has_last_    = false;
+    uint32_t repeats_ = 0;
+    int64_t repeat_stamp_ns_ = 0;
+
+    bool push(LogSite &site, LOG_LEVEL level, uint32_t suppressed, const char *format, va_list args);
+    bool pop(LogRecord &record);
+
+    void run();
+    void drain();
+    void writeRecord(const LogRecord &record);
+    void flushRepeats(int64_t now_ns, bool force);
+    void reportSuppressed(int64_t now_ns);
+    void write(LOG_LEVEL level, int64_t stamp_ns, const char *text);
+};
+
+#define DATC_LOG(level, ...)                                                  \
+    do {                                                                      \
+        static LogSite datc_log_site_ {__FILE__, __LINE__};                   \
+        if (AsyncLogger::instance().isEnabled(level)) {                       \
+            AsyncLogger::instance().log(datc_log_site_, level, __VA_ARGS__);  \
+        }                                                                     \
+    } while (0)
+
+#define DATC_LOG_DEBUG(...) DATC_LOG(LOG_LEVEL::DEBUG, __VA_ARGS__)
+#define DATC_LOG_INFO(...)  DATC_LOG(LOG_LEVEL::INFO,  __VA_ARGS__)
+#define DATC_LOG_WARN(...)  DATC_LOG(LOG_LEVEL::WARN,  __VA_ARGS__)
+#define DATC_LOG_ERROR(...) DATC_LOG(LOG_LEVEL::ERROR, __VA_ARGS__)
+
+#endif // ASYNC_LOGGER_HPP
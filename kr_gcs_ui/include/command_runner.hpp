@@ -0,0 +1,61 @@
+/**
+ * @file command_runner.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Runs GUI commands on a worker thread so that bus waits and timeouts never block the Qt thread.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMMAND_RUNNER_HPP
+#define COMMAND_RUNNER_HPP
+
+#include <QObject>
+#include <QString>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+class CommandRunner : public QObject {
+    Q_OBJECT
+
+public:
+    explicit CommandRunner(QObject *parent = nullptr);
+    virtual ~CommandRunner();
+
+    // Jobs run one at a time in submission order; urgent ones (e.g. stop) go to the front of the queue
+    quint64 submit(const QString &name, function<bool()> job, bool urgent = false);
+
+    // Drops the queued jobs and waits for the running one
+    void stop();
+
+Q_SIGNALS:
+    // Emitted from the worker thread
+    void commandFinished(quint64 id, bool success, qint64 elapsed_ms);
+
+private:
+    struct Job {
+        quint64 id;
+        QString name;
+        function<bool()> func;
+    };
+
+    void run();
+
+    deque<Job> queue_;
+    mutex mutex_;
+    condition_variable cv_;
+
+    bool running_ = true;
+    quint64 next_id_ = 1;
+
+    thread thread_;
+};
+
+#endif // COMMAND_RUNNER_HPP
@@ -0,0 +1,79 @@
+/**
+ * @file command_sequence.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Steps of a DATC command sequence (commands, waits for a status flag, delays), run by
+ *        DatcCtrl on the thread that polls the bus. No ROS or Qt dependency.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMMAND_SEQUENCE_HPP
+#define COMMAND_SEQUENCE_HPP
+
+#include "register_map.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+const size_t kSequenceStepsMax   = 64;
+const int    kSequenceWaitMaxMs  = 60000; // Timeout of a wait and length of a delay, at most
+
+enum class SEQUENCE_STEP {
+    COMMAND,    // DATC_COMMAND code and values, through the same range checks as the single commands
+    WAIT_STATE, // Until a status flag has the value, checked from the next sample on; fails after timeout_ms
+    DELAY,      // Fixed time, timed by the poll thread to the deadline rather than to the next sample
+};
+
+struct SequenceStep {
+    SEQUENCE_STEP type = SEQUENCE_STEP::DELAY;
+
+    uint16_t command = 0;
+    int16_t value_1  = 0;
+    int16_t value_2  = 0;
+
+    STATUS_FLAG flag = STATUS_FLAG::ENABLE;
+    bool value       = true;
+    int timeout_ms   = 1000;
+
+    int delay_ms     = 0;
+
+    static SequenceStep makeCommand(uint16_t command, int16_t value_1 = 0, int16_t value_2 = 0);
+    static SequenceStep makeWaitState(STATUS_FLAG flag, bool value, int timeout_ms);
+    static SequenceStep makeDelay(int delay_ms);
+
+    // e.g. "command 103", "wait grp_closed = true (2000 ms)", "delay 100 ms"
+    string describe() const;
+};
+
+// Empty if the steps can run
+string checkSequence(const vector<SequenceStep> &steps);
+
+// Flags named as in GripperMsg (motor_enabled, grp_closed, ...)
+const char *getStatusFlagName(STATUS_FLAG flag);
+bool parseStatusFlag(const string &name, STATUS_FLAG &flag);
+
+enum class SEQUENCE_STATE {
+    IDLE,
+    RUNNING,
+    SUCCEEDED,
+    FAILED,
+    CANCELED,
+};
+
+struct SequenceProgress {
+    uint64_t id = 0;      // Of the latest sequence, 0 before the first
+    SEQUENCE_STATE state = SEQUENCE_STATE::IDLE;
+
+    size_t step  = 0;     // Running step, or steps once succeeded
+    size_t steps = 0;
+    string message;       // Why it failed or was canceled
+
+    int64_t elapsed_ns = 0;
+};
+
+#endif // COMMAND_SEQUENCE_HPP
@@ -11,76 +11,70 @@
 #ifndef DATC_COMM_INTERFACE_HPP
 #define DATC_COMM_INTERFACE_HPP
 
-#include "datc_ctrl.hpp"
-#include <rclcpp/rclcpp.hpp>
-#include <QThread>
-
-#include "grp_control_msg/msg/gripper_msg.hpp"
-
-#include "grp_control_msg/srv/pos_vel_cur_ctrl.hpp"
-#include "grp_control_msg/srv/gripper_command.hpp"
-#include "grp_control_msg/srv/single_boolean.hpp"
-#include "grp_control_msg/srv/single_int.hpp"
-#include "grp_control_msg/srv/void.hpp"
+#include "datc_ros_interface.hpp"
+#include "telemetry_buffer.hpp"
+#include <QObject>
+#include <QMetaType>
+#include <QStringList>
 
 using namespace std;
-using namespace grp_control_msg::srv;
-using namespace grp_control_msg::msg;
 
-class DatcCommInterface : public QThread, public DatcCtrl {
-    Q_OBJECT
+/**
+ * @brief Everything the GUI displays, sent from the poll thread whenever it changes.
+ */
+struct DatcSnapshot {
+    DatcStatus status;
 
-public:
-    DatcCommInterface(int argc, char **argv);
-    virtual ~DatcCommInterface();
+    bool connected      = false;
+    bool active         = false;
+    bool recv_err       = false;
+    uint16_t slave_addr = 0;
 
-Q_SIGNALS:
-    void rosShutdown();
+    bool tcp_running    = false;
 
-public:
-	bool init(const char *port_name, uint slave_address, int baudrate);
+    bool operator==(const DatcSnapshot &rhs) const {
+        return connected == rhs.connected && active == rhs.active && recv_err == rhs.recv_err && slave_addr == rhs.slave_addr &&
+               tcp_running == rhs.tcp_running && status == rhs.status;
+    }
 
-private:
-    shared_ptr<rclcpp::Node> nh_;
-
-    // Publisher
-    rclcpp::Publisher<GripperMsg>::SharedPtr publisher_grp_state_;
+    bool operator!=(const DatcSnapshot &rhs) const {return !(*this == rhs);}
+};
 
-    // Server
-    // rclcpp::Service<SingleBoolean>::SharedPtr srv_modbus_init_release_;
-    rclcpp::Service<Void>::SharedPtr srv_motor_enable_;
-    rclcpp::Service<Void>::SharedPtr srv_motor_disable_;
+Q_DECLARE_METATYPE(DatcSnapshot)
 
-    rclcpp::Service<SingleInt>::SharedPtr srv_modbus_slave_change_;
-    rclcpp::Service<SingleInt>::SharedPtr srv_set_modbus_addr_;
-    rclcpp::Service<SingleInt>::SharedPtr srv_set_finger_pos_;
-    rclcpp::Service<SingleInt>::SharedPtr srv_set_motor_torque_;
-    rclcpp::Service<SingleInt>::SharedPtr srv_set_motor_speed_;
+/**
+ * @brief Qt side of the ROS interface: spins the node in the background and forwards poll results to
+ *        the GUI thread.
+ */
+class DatcCommInterface : public QObject, public DatcRosInterface {
+    Q_OBJECT
 
-    rclcpp::Service<Void>::SharedPtr srv_motor_stop_;
-    rclcpp::Service<Void>::SharedPtr srv_grp_initialize_;
-    rclcpp::Service<Void>::SharedPtr srv_grp_open_;
-    rclcpp::Service<Void>::SharedPtr srv_grp_close_;
-    rclcpp::Service<Void>::SharedPtr srv_vacuum_grp_on_;
-    rclcpp::Service<Void>::SharedPtr srv_vacuum_grp_off_;
+public:
+    DatcCommInterface();
+    virtual ~DatcCommInterface();
 
-    // rclcpp::Service<PosVelCurCtrl>::SharedPtr srv_motor_pos_ctrl_;
-    rclcpp::Service<PosVelCurCtrl>::SharedPtr srv_motor_vel_ctrl_;
-    rclcpp::Service<PosVelCurCtrl>::SharedPtr srv_motor_cur_ctrl_;
+    TelemetryBuffer &getTelemetry() {return telemetry_;}
 
+Q_SIGNALS:
+    void datcSnapshotUpdated(const DatcSnapshot &snapshot);
+    void serialPortsChanged(const QStringList &ports);
 
-    bool is_enable_            = false;
-    bool modbus_connect_state_ = false;
-    bool read_mode_            = true;
+protected:
+    void onPollCycle(const timespec &time_current, bool sample_read) override;
+    void onSerialPortsChanged(const vector<string> &ports) override;
 
-    mutex mutex_com_;
-    mutex mutex_var_;
+private:
+    DatcSnapshot getSnapshot();
 
-	void run();
+    rclcpp::executors::SingleThreadedExecutor executor_;
+    thread spin_thread_;
 
-    void pubTopic();
+    // Every poll sample, for the telemetry plot
+    TelemetryBuffer telemetry_;
+    double telemetry_rate_; // poll_rate the capacity is sized for, poll thread only
+    timespec time_start_;
 
-    bool checkValue();
+    DatcSnapshot snapshot_prev_;
 };
 
 #endif // DATC_COMM_INTERFACE_HPP
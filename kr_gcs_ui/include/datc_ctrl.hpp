@@ -12,9 +12,11 @@
 #define DATC_CTRL_HPP
 
 #include "modbus_comm.hpp"
+#include "register_map.hpp"
+#include "command_sequence.hpp"
 #include <map>
 
-#define CMD_ADDR 0
+#define CMD_ADDR (register_map_.load()->command_addr)
 
 #define SEND_CMD_VECTOR(...) mbc_.sendData(CMD_ADDR, __VA_ARGS__)
 #define SEND_CMD(...) mbc_.sendData(CMD_ADDR, (uint16_t) __VA_ARGS__)
@@ -55,6 +57,15 @@ enum class DATC_COMMAND {
     SET_MOTOR_SPEED         = 213,
 };
 
+// Status block of the register map (datc_v1: from 10, status, motor position, motor current, motor
+// velocity, finger position, 2 unused, voltage)
+enum class READ_PROFILE {
+    FULL,    // status_count registers (datc_v1: 10 ~ 17)
+    MINIMAL, // minimal_count registers (datc_v1: 10 ~ 14, everything but the voltage)
+    STATUS,  // The status word only
+    MIXED,   // MINIMAL, and FULL on every full_every-th read
+};
+
 struct DatcStatus {
     string status_str;
 
@@ -73,6 +84,22 @@ struct DatcStatus {
     uint16_t finger_pos = 0;
     uint16_t voltage    = 0;
     uint16_t states     = 0;
+
+    // status_str and the flags are decoded from states, so comparing the raw values is enough.
+    bool operator==(const DatcStatus &rhs) const {
+        return states     == rhs.states     && motor_pos == rhs.motor_pos && motor_vel == rhs.motor_vel &&
+               motor_cur  == rhs.motor_cur  && finger_pos == rhs.finger_pos && voltage == rhs.voltage;
+    }
+
+    bool operator!=(const DatcStatus &rhs) const {return !(*this == rhs);}
+
+    bool getFlag(STATUS_FLAG flag) const {
+        const bool flags[kStatusFlagCount] = {
+            enable, initialize, motor_pos_ctrl, motor_vel_ctrl, motor_cur_ctrl, grp_open, grp_close, fault,
+        };
+
+        return flags[(size_t) flag];
+    }
 };
 
 class DatcCtrl {
@@ -106,7 +133,22 @@ public:
     bool setMotorTorque(uint16_t torque_ratio);
     bool setMotorSpeed (uint16_t speed_ratio);
 
+    // Registers that are not read keep their last value
     bool readDatcData();
+    void setReadProfile(READ_PROFILE profile, int full_every);
+    READ_PROFILE getReadProfile() {return read_profile_;}
+
+    static bool parseReadProfile(const string &str, READ_PROFILE &profile);
+    static const char *getReadProfileName(READ_PROFILE profile);
+
+    // Bus time of one read on average, from the RTU framing at 8N1 (request, response and a t3.5
+    // silence after each). The slave's processing time and the adapter latency come on top.
+    static double estimateReadTimeUs(READ_PROFILE profile, int full_every, int baudrate, const RegisterMap &map);
+
+    // Picked per slave at connect time, see config/datc_register_map.yaml
+    const RegisterMap &getRegisterMap() {return *register_map_.load();}
+    int getFirmwareVersion() {return firmware_version_;} // -1 if unknown
+
     DatcStatus getDatcStatus() {return status_;}
     bool getConnectionState() {return mbc_.getConnectionState();}
     bool getModbusRecvErr() {return flag_modbus_recv_err_;}
@@ -118,14 +160,68 @@ public:
     bool impedanceOff();
     bool setImpedanceParams(int16_t slave_num, int16_t stiffness_level);
 
+    // Command by its DATC_COMMAND value (e.g. from the TCP bridge), through the same range checks as above
+    bool commandByCode(uint16_t code, int16_t value_1, int16_t value_2);
+
+    static bool isCommandCode(uint16_t code);
+
+    // +1 for every command sent, from any thread, so that the poll thread can tell a new motion may have started
+    uint32_t getCommandCount() {return command_count_;}
+
+    // The latest command sent and when (CLOCK_MONOTONIC ns); may be newer than getCommandCount() told
+    void getLastCommand(uint16_t &code, int64_t &time_ns) {code = last_command_code_; time_ns = last_command_ns_;}
+
+    // Registers of the status block read by the last successful readDatcData(), reading thread only
+    int getLastReadCount() {return last_read_count_;}
+
+    // Command sequences (command_sequence.hpp). Started and canceled from any thread, one at a time. The
+    // thread that reads runs them: stepSequence() after every read, and also at getSequenceDeadline().
+    bool startSequence(const vector<SequenceStep> &steps, uint64_t &id, string &error);
+    void cancelSequence(const string &reason);
+    SequenceProgress getSequenceProgress();
+
+    // CLOCK_MONOTONIC ns when the running delay ends, 0 if no delay is running
+    int64_t getSequenceDeadline() {return sequence_deadline_ns_;}
+
+    // Sends the commands that are due. sample_read: status_ holds a sample read since the last call.
+    void stepSequence(int64_t time_ns, bool sample_read);
+
 protected:
-    bool checkDurationRange(string error_prefix, uint16_t &duration);
+    bool checkDurationRange(const char *error_prefix, uint16_t &duration);
     bool command(DATC_COMMAND cmd, uint16_t value_1 = 0, uint16_t value_2 = 0);
+    void selectRegisterMap();
 
     ModbusComm mbc_;
     DatcStatus status_;
 
     bool flag_modbus_recv_err_ = false;
+
+    atomic<uint32_t> command_count_ {0};
+    atomic<uint16_t> last_command_code_ {0};
+    atomic<int64_t> last_command_ns_ {0};
+
+    mutex sequence_mutex_;
+    vector<SequenceStep> sequence_;
+    SequenceProgress sequence_progress_;
+    uint64_t sequence_next_id_ = 1;
+
+    // Reading thread only, under sequence_mutex_
+    int64_t sequence_start_ns_ = -1;  // -1 until the first stepSequence()
+    int64_t step_start_ns_     = -1;  // -1 until the step is entered
+    bool sequence_fault_prev_  = false;
+
+    atomic<int64_t> sequence_deadline_ns_ {0};
+
+    void finishSequence(SEQUENCE_STATE state, const string &message, int64_t time_ns);
+
+    atomic<const RegisterMap *> register_map_ {&kRegisterMaps[kRegisterMapDefault]};
+    atomic<int> firmware_version_ {-1};
+
+    // Set from any thread, read count only by the reading thread
+    atomic<READ_PROFILE> read_profile_ {READ_PROFILE::FULL};
+    atomic<int> read_full_every_ {10};
+    uint read_count_ = 0;
+    int last_read_count_ = 0;
 };
 
 #endif // DATC_CTRL_HPP
@@ -0,0 +1,384 @@
+/**
+ * @file datc_ros_interface.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief ROS2 topic/service interface of the DATC with its own bus poll thread. Has no Qt dependency
+ *        so that it can run headless.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef DATC_ROS_INTERFACE_HPP
+#define DATC_ROS_INTERFACE_HPP
+
+#include "datc_ctrl.hpp"
+#include "async_logger.hpp"
+#include "serial_port_watcher.hpp"
+#include "rt_profile.hpp"
+#include "grasp_detector.hpp"
+#include "state_estimator.hpp"
+#include "health_stats.hpp"
+#include "shm_status_writer.hpp"
+#include "tcp_bridge.hpp"
+#include <rclcpp/rclcpp.hpp>
+#include <rclcpp_action/rclcpp_action.hpp>
+#include <rclcpp_lifecycle/lifecycle_node.hpp>
+#include <rclcpp_lifecycle/lifecycle_publisher.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "lifecycle_msgs/msg/state.hpp"
+#include "grp_control_msg/msg/gripper_msg.hpp"
+#include "grp_control_msg/msg/grasp_event.hpp"
+#include "grp_control_msg/msg/gripper_estimate.hpp"
+#include "grp_control_msg/msg/gripper_health.hpp"
+#include "grp_control_msg/msg/state_transition.hpp"
+#include "statistics_msgs/msg/metrics_message.hpp"
+
+#include "grp_control_msg/srv/pos_vel_cur_ctrl.hpp"
+#include "grp_control_msg/srv/get_health.hpp"
+#include "grp_control_msg/srv/gripper_command.hpp"
+#include "grp_control_msg/srv/single_boolean.hpp"
+#include "grp_control_msg/srv/single_int.hpp"
+#include "grp_control_msg/srv/void.hpp"
+
+#include "grp_control_msg/action/run_sequence.hpp"
+
+using namespace std;
+using namespace grp_control_msg::srv;
+using namespace grp_control_msg::msg;
+using grp_control_msg::action::RunSequence;
+using statistics_msgs::msg::MetricsMessage;
+using statistics_msgs::msg::StatisticDataType;
+
+const double kPollRateDefault = 100; // Hz, the poll_rate parameter overrides it
+const double kEstimatorRateDefault = 500; // Hz, estimator.rate
+
+/**
+ * @brief Owns the publisher, the services and the poll thread. The node itself is spun by whoever owns
+ *        it (rclcpp::spin in the headless node, a background executor in the GUI).
+ *
+ *        Lifecycle: configure opens the port and checks that the slave answers, cleanup releases it.
+ *        activate / deactivate only gate polling, publishing and commands, so switching a gripper
+ *        between active and inactive never touches the serial port.
+ */
+class DatcRosInterface : public rclcpp_lifecycle::LifecycleNode, public DatcCtrl {
+public:
+    using CallbackReturn = rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn;
+
+    explicit DatcRosInterface(const rclcpp::NodeOptions &options = rclcpp::NodeOptions());
+    virtual ~DatcRosInterface();
+
+    bool init(const char *port_name, uint slave_address, int baudrate);
+
+    // Unconfigured -> active with the given port, and back, for an owner in the same process (the GUI)
+    bool bringUp(const string &port_name, uint slave_address, int baudrate);
+    bool bringDown();
+
+    bool isActive() const {return active_;}
+    double getPollRate() const {return poll_rate_;}
+
+    // Commands are only accepted while active; logs the rejection
+    bool acceptCommand(const char *name);
+
+    // Poll thread
+    void start();
+    void stop();
+
+    vector<string> getSerialPorts() {return port_watcher_.getPorts();}
+
+    // TCP bridge for clients without ROS: commands, and the status whenever it changes. Started from
+    // the tcp.* parameters, or by the GUI.
+    bool initTcp(const string &addr, uint16_t port);
+    void releaseTcp() {tcp_bridge_.stop();}
+    bool isTcpRunning() const {return tcp_bridge_.isRunning();}
+    void setTcpSendStatus(bool send) {tcp_send_status_ = send;}
+
+    // Runs a command sequence on the poll thread and waits for it to finish (GUI worker thread).
+    // False with the reason if it failed, was canceled or could not start.
+    bool runSequence(const vector<SequenceStep> &steps, string &error);
+
+    // The grp_state message of a sample. Inline so that datc_ctrl_bench measures it without a node.
+    static void toGripperMsg(const DatcStatus &status, GripperMsg &msg) {
+        msg.motor_position  = status.motor_pos;
+        msg.motor_velocity  = status.motor_vel;
+        msg.motor_current   = status.motor_cur;
+        msg.finger_position = status.finger_pos;
+
+        msg.motor_enabled       = status.enable;
+        msg.gripper_initialized = status.initialize;
+        msg.position_ctrl_mode  = status.motor_pos_ctrl;
+        msg.velocity_ctrl_mode  = status.motor_vel_ctrl;
+        msg.current_ctrl_mode   = status.motor_cur_ctrl;
+        msg.grp_opened          = status.grp_open;
+        msg.grp_closed          = status.grp_close;
+        msg.motor_fault         = status.fault;
+    }
+
+protected:
+    CallbackReturn on_configure(const rclcpp_lifecycle::State &state) override;
+    CallbackReturn on_activate(const rclcpp_lifecycle::State &state) override;
+    CallbackReturn on_deactivate(const rclcpp_lifecycle::State &state) override;
+    CallbackReturn on_cleanup(const rclcpp_lifecycle::State &state) override;
+    CallbackReturn on_shutdown(const rclcpp_lifecycle::State &state) override;
+    CallbackReturn on_error(const rclcpp_lifecycle::State &state) override;
+
+    // Called from the poll thread after every cycle
+    virtual void onPollCycle(const timespec &time_current, bool sample_read) {
+        (void) time_current;
+        (void) sample_read;
+    }
+
+    // Called from the port watcher thread whenever a serial port appears or disappears
+    virtual void onSerialPortsChanged(const vector<string> &ports) {
+        (void) ports;
+    }
+
+private:
+    // Publisher, recreated when the QoS parameters change
+    rclcpp_lifecycle::LifecyclePublisher<GripperMsg>::SharedPtr publisher_grp_state_;
+    mutex publisher_mutex_;
+    uint32_t state_sequence_ = 0; // GripperMsg::sequence of the last grp_state, poll thread only
+
+    rclcpp_lifecycle::LifecyclePublisher<MetricsMessage>::SharedPtr publisher_statistics_;
+
+    // Lifecycle state as seen by the poll thread and the services
+    atomic<bool> configured_ {false};
+    atomic<bool> active_ {false};
+
+    void releasePort();
+
+    // Parameters
+    rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr param_callback_handle_;
+
+    atomic<double> poll_rate_ {kPollRateDefault};
+    atomic<int> publish_decimation_ {1};
+    double publish_rate_ = kPollRateDefault;
+    string qos_reliability_;
+    int64_t qos_depth_ = 10;
+
+    string read_profile_name_ = "full";
+    int64_t read_full_every_  = 10;
+
+    atomic<bool> statistics_enabled_ {false};
+    atomic<int64_t> statistics_period_ms_ {1000};
+
+    static rcl_interfaces::msg::SetParametersResult checkRateQos(double poll_rate, double publish_rate,
+                                                                 const string &reliability, int64_t depth);
+    static int getDecimation(double poll_rate, double publish_rate);
+
+    void createStatePublisher();
+    void logReadProfile(int baudrate);
+    rcl_interfaces::msg::SetParametersResult onSetParameters(const vector<rclcpp::Parameter> &params);
+
+    // Publish period statistics, poll thread only
+    bool stat_has_prev_ = false;
+    double stat_time_prev_ = 0;
+    uint64_t stat_count_ = 0;
+    double stat_mean_ = 0, stat_m2_ = 0, stat_min_ = 0, stat_max_ = 0;
+    rclcpp::Time stat_window_start_;
+
+    void updateStatistics(const timespec &time_pub);
+
+    // Grasp detection on every sample, profiles from the grasp.* parameters
+    rclcpp_lifecycle::LifecyclePublisher<GraspEvent>::SharedPtr publisher_grasp_event_;
+
+    map<string, GraspProfile> grasp_profiles_; // Parameter callback only
+    string grasp_profile_name_;
+    atomic<bool> grasp_enabled_ {false};
+
+    mutex grasp_mutex_;
+    string grasp_pending_name_;
+    GraspProfile grasp_pending_profile_;
+    atomic<bool> grasp_profile_changed_ {false};
+
+    // Poll thread only
+    GraspDetector grasp_detector_;
+    string grasp_active_name_;
+
+    void declareGraspParameters();
+    static bool setGraspProfileField(GraspProfile &profile, const string &field, const rclcpp::Parameter &param);
+    void setGraspProfile(const string &name, const GraspProfile &profile);
+    void detectGrasp(const timespec &time_sample);
+
+    // State estimate between the samples, published from its own thread at estimator.rate
+    rclcpp_lifecycle::LifecyclePublisher<GripperEstimate>::SharedPtr publisher_estimate_;
+
+    atomic<bool> estimator_enabled_ {false};
+    atomic<double> estimator_rate_ {kEstimatorRateDefault};
+    atomic<double> estimator_lead_ms_ {0};
+    EstimatorNoise estimator_finger_noise_, estimator_motor_noise_; // Parameter callback only
+
+    mutex estimator_mutex_;
+    StateEstimator estimator_;
+
+    thread estimator_thread_;
+
+    // Poll thread only
+    bool estimator_has_prev_ = false;
+    uint16_t estimator_states_prev_   = 0;
+    uint32_t estimator_commands_prev_ = 0;
+
+    void declareEstimatorParameters();
+    static bool setEstimatorNoiseField(EstimatorNoise &noise, const string &field, double value);
+    void updateEstimator(int64_t time_sample_ns);
+    void resetEstimator();
+    void runEstimator();
+
+    // Wear counters per gripper (a file per slave under health.directory) and statistics over the
+    // health window, fed by the poll thread and published / saved from their own thread
+    rclcpp_lifecycle::LifecyclePublisher<GripperHealth>::SharedPtr publisher_health_;
+    rclcpp::Service<GetHealth>::SharedPtr srv_get_health_;
+
+    atomic<bool> health_enabled_ {false};
+    atomic<double> health_publish_period_s_ {10};
+    atomic<double> health_save_period_s_ {60};
+    double health_window_s_ = kHealthWindowDefaultS; // Parameter callback only
+    string health_directory_;
+
+    mutex health_mutex_;
+    HealthStats health_;
+    uint health_slave_ = 0; // Whose counters health_ holds, 0 while none or switching; set by the health thread
+    bool health_dirty_ = false;
+
+    mutex health_thread_mutex_;
+    thread health_thread_;
+    bool health_thread_running_ = false; // Cleared by the health thread itself as it exits
+    string health_path_; // Health thread only
+
+    // Poll thread only
+    uint32_t health_commands_prev_ = 0;
+
+    void declareHealthParameters();
+    void makeHealthDirectory();
+    string getWearPath(const string &port, uint slave);
+    void updateHealth(bool sample_read, int64_t time_sample_ns);
+    void resetHealth();
+    void toHealthMsg(const HealthSummary &summary, uint slave, GripperHealth &msg);
+    void switchHealth(const string &path, uint slave);
+    void saveHealth();
+    void startHealth();
+    void runHealth();
+
+    // Async logger (async_logger.hpp) level and file; its lines otherwise go to this node's rclcpp logger.
+    // Both are process-wide, shared by every node in the process.
+    string log_level_name_;
+    string log_file_;
+
+    void declareLogParameters();
+
+    // Server
+    // rclcpp::Service<SingleBoolean>::SharedPtr srv_modbus_init_release_;
+    rclcpp::Service<Void>::SharedPtr srv_motor_enable_;
+    rclcpp::Service<Void>::SharedPtr srv_motor_disable_;
+
+    rclcpp::Service<SingleInt>::SharedPtr srv_modbus_slave_change_;
+    rclcpp::Service<SingleInt>::SharedPtr srv_set_modbus_addr_;
+    rclcpp::Service<SingleInt>::SharedPtr srv_set_finger_pos_;
+    rclcpp::Service<SingleInt>::SharedPtr srv_set_motor_torque_;
+    rclcpp::Service<SingleInt>::SharedPtr srv_set_motor_speed_;
+
+    rclcpp::Service<Void>::SharedPtr srv_motor_stop_;
+    rclcpp::Service<Void>::SharedPtr srv_grp_initialize_;
+    rclcpp::Service<Void>::SharedPtr srv_grp_open_;
+    rclcpp::Service<Void>::SharedPtr srv_grp_close_;
+    rclcpp::Service<Void>::SharedPtr srv_vacuum_grp_on_;
+    rclcpp::Service<Void>::SharedPtr srv_vacuum_grp_off_;
+
+    // rclcpp::Service<PosVelCurCtrl>::SharedPtr srv_motor_pos_ctrl_;
+    rclcpp::Service<PosVelCurCtrl>::SharedPtr srv_motor_vel_ctrl_;
+    rclcpp::Service<PosVelCurCtrl>::SharedPtr srv_motor_cur_ctrl_;
+
+    thread poll_thread_;
+    atomic<bool> running_ {false};
+
+    // Opt-in real-time profile of the poll thread and the wakeup latency it achieves
+    RtProfile rt_profile_;
+    LatencyRecorder latency_;
+
+    // Reset on every connection, so each connection reports when its first sample went out
+    atomic<bool> first_sample_traced_ {false};
+
+    // Hotplug: a connection lost by unplugging the adapter is re-established when the same device
+    // (by its /dev/serial/by-id name if it has one) comes back
+    SerialPortWatcher port_watcher_;
+
+    mutex port_mutex_;
+    string port_name_, port_stable_;
+    uint slave_address_ = 0;
+    int baudrate_       = 0;
+
+    atomic<bool> port_removed_ {false};
+    atomic<bool> port_added_ {false};
+
+    // Held by releasePort() and by the poll thread when it releases the removed port and when it checks
+    // configured_ after a reopen, so that a cleanup during the reopen does not leave the port open
+    mutex reconnect_mutex_;
+
+    // Poll thread only
+    int reconnect_tries_   = 0;
+    bool reconnect_ready_  = false;
+    chrono::steady_clock::time_point time_reconnect_;
+
+    void onSerialPortEvent(SERIAL_PORT_EVENT event, const string &path);
+    void handlePortEvents();
+
+    // Latched, only on changes of the status flags; poll thread only below
+    rclcpp_lifecycle::LifecyclePublisher<StateTransition>::SharedPtr publisher_state_transition_;
+
+    bool transition_has_prev_ = false;
+    uint16_t transition_states_prev_ = 0;
+
+    // Latest sample for readers on the same host without ROS (datc_shm.h), poll thread only
+    ShmStatusWriter shm_writer_;
+    uint8_t shm_flags_prev_ = 0;
+    int64_t shm_stamp_ns_   = 0;
+
+    void writeShm(bool sample_read);
+
+    TcpBridge tcp_bridge_;
+    atomic<bool> tcp_send_status_ {true};
+
+    // Poll thread only
+    bool tcp_has_prev_ = false;
+    DatcStatus tcp_status_prev_;
+    uint8_t tcp_flags_prev_ = 0;
+
+    void sendTcpStatus();
+
+    // Command sequences as an action, run by the poll thread; one goal at a time
+    using SequenceGoalHandle = rclcpp_action::ServerGoalHandle<RunSequence>;
+
+    rclcpp_action::Server<RunSequence>::SharedPtr action_run_sequence_;
+
+    mutex sequence_goal_mutex_;
+    shared_ptr<SequenceGoalHandle> sequence_goal_; // Until its result is sent
+    uint64_t sequence_goal_id_ = 0;
+    vector<string> sequence_goal_steps_; // Descriptions for the feedback
+
+    // Poll thread only
+    uint64_t sequence_reported_id_  = 0;
+    size_t sequence_reported_step_ = 0;
+
+    static bool toSequenceSteps(const RunSequence::Goal &goal, vector<SequenceStep> &steps, string &error);
+    void acceptSequenceGoal(const shared_ptr<SequenceGoalHandle> goal_handle);
+    void reportSequence();
+
+    // Poll thread: to the next poll, waking up in between for a sequence delay that ends earlier
+    void sleepUntilPoll(const timespec &time_next);
+
+    void run();
+
+    // Next absolute deadline of a loop at rate_hz; restarts from now instead of bursting after a stall
+    static void advanceDeadline(timespec &time_next, double rate_hz);
+
+    void pubTopic();
+    void pubStateTransition();
+};
+
+#endif // DATC_ROS_INTERFACE_HPP
@@ -0,0 +1,163 @@
+/**
+ * @file datc_shm.h
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Layout of the DATC status shared-memory segment and its reader. Self-contained C11 / C++11,
+ *        POSIX only: copy it next to a vision or robot controller process and link nothing.
+ *
+ *        The writer (the ROS interface, shm.name parameter) puts every sample into the segment under a
+ *        seqlock. Reading is a few loads of one cache line, without a syscall or a lock, and never blocks
+ *        the writer.
+ *
+ *            const datc_shm_segment_t *seg = datc_shm_open("/datc_status");
+ *            datc_shm_sample_t sample;
+ *
+ *            if (seg && datc_shm_read(seg, &sample) && datc_shm_age_ns(&sample) < 50000000) {
+ *                ...
+ *            }
+ *
+ *            datc_shm_close(seg);
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef DATC_SHM_H
+#define DATC_SHM_H
+
+/* clock_gettime, CLOCK_MONOTONIC and shm_open are POSIX, hidden by a strict -std=c11. This only takes
+ * effect ahead of the first system header, so include this header first or build with
+ * -D_POSIX_C_SOURCE=200809L. */
+#if !defined(_POSIX_C_SOURCE) && !defined(_XOPEN_SOURCE) && !defined(_GNU_SOURCE) && !defined(_DEFAULT_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DATC_SHM_MAGIC      0x43544144u /* "DATC" */
+#define DATC_SHM_VERSION    1u
+#define DATC_SHM_READ_TRIES 1000
+
+/* Sample flags, same values as the TCP bridge status flags */
+#define DATC_SHM_FLAG_CONNECTED 0x01u
+#define DATC_SHM_FLAG_RECV_ERR  0x02u /* Last read failed, the values are from the sample before */
+#define DATC_SHM_FLAG_ACTIVE    0x04u
+
+typedef struct {
+    uint64_t sequence; /* Samples written since the writer opened the segment, starts at 1 */
+    int64_t stamp_ns;  /* CLOCK_MONOTONIC when the sample was read from the bus */
+
+    uint16_t states;   /* Raw status register, bits as in DatcStatus */
+    int16_t motor_pos;
+    int16_t motor_vel;
+    int16_t motor_cur;
+    uint16_t finger_pos;
+    uint16_t voltage;
+    uint8_t flags;
+    uint8_t reserved[3];
+} datc_shm_sample_t;
+
+#define DATC_SHM_SAMPLE_WORDS (sizeof(datc_shm_sample_t) / sizeof(uint64_t))
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t writer_pid;
+    uint32_t seq; /* Seqlock, odd while the writer is inside */
+
+    union {
+        datc_shm_sample_t sample;
+        uint64_t words[DATC_SHM_SAMPLE_WORDS];
+    } data;
+} __attribute__((aligned(64))) datc_shm_segment_t;
+
+#ifdef __cplusplus
+static_assert(sizeof(datc_shm_sample_t) == 32, "datc_shm_sample_t layout");
+static_assert(sizeof(datc_shm_segment_t) == 64, "datc_shm_segment_t must fit one cache line");
+#else
+_Static_assert(sizeof(datc_shm_sample_t) == 32, "datc_shm_sample_t layout");
+_Static_assert(sizeof(datc_shm_segment_t) == 64, "datc_shm_segment_t must fit one cache line");
+#endif
+
+/* NULL if the segment does not exist (yet) or is of another version */
+static inline const datc_shm_segment_t *datc_shm_open(const char *name) {
+    const int fd = shm_open(name, O_RDONLY, 0);
+
+    if (fd < 0) {
+        return NULL;
+    }
+
+    void *addr = mmap(NULL, sizeof(datc_shm_segment_t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (addr == MAP_FAILED) {
+        return NULL;
+    }
+
+    const datc_shm_segment_t *seg = (const datc_shm_segment_t *) addr;
+
+    if (__atomic_load_n(&seg->magic, __ATOMIC_ACQUIRE) != DATC_SHM_MAGIC || seg->version != DATC_SHM_VERSION) {
+        munmap(addr, sizeof(datc_shm_segment_t));
+        return NULL;
+    }
+
+    return seg;
+}
+
+static inline void datc_shm_close(const datc_shm_segment_t *seg) {
+    if (seg != NULL) {
+        munmap((void *) seg, sizeof(datc_shm_segment_t));
+    }
+}
+
+/* One attempt, 0 if the writer was inside */
+static inline int datc_shm_try_read(const datc_shm_segment_t *seg, datc_shm_sample_t *sample) {
+    uint64_t words[DATC_SHM_SAMPLE_WORDS];
+
+    const uint32_t seq_begin = __atomic_load_n(&seg->seq, __ATOMIC_ACQUIRE);
+
+    if (seq_begin & 1) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < DATC_SHM_SAMPLE_WORDS; i++) {
+        words[i] = __atomic_load_n(&seg->data.words[i], __ATOMIC_RELAXED);
+    }
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    if (__atomic_load_n(&seg->seq, __ATOMIC_RELAXED) != seq_begin) {
+        return 0;
+    }
+
+    memcpy(sample, words, sizeof(words));
+
+    return 1;
+}
+
+/* Retries while the writer is inside. 0 only if the writer died there, or nothing was written yet. */
+static inline int datc_shm_read(const datc_shm_segment_t *seg, datc_shm_sample_t *sample) {
+    for (int i = 0; i < DATC_SHM_READ_TRIES; i++) {
+        if (datc_shm_try_read(seg, sample)) {
+            return sample->sequence != 0;
+        }
+    }
+
+    return 0;
+}
+
+/* Age against CLOCK_MONOTONIC (vDSO, no syscall). A restarted writer creates a new segment, so readers
+   should reopen when the age keeps growing. */
+static inline int64_t datc_shm_age_ns(const datc_shm_sample_t *sample) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (int64_t) now.tv_sec * 1000000000LL + now.tv_nsec - sample->stamp_ns;
+}
+
+#endif /* DATC_SHM_H */
@@ -0,0 +1,47 @@
+/**
+ * @file datc_trace.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Tracepoints along the command path (LTTng-UST provider kr_gcs_ui), in the same form as
+ *        ros2_tracing: DATC_TRACE(event, ...) calls datc_trace_<event>() in datc_driver, which fires the
+ *        tracepoint. Built only with -DKR_GCS_TRACING=ON; otherwise DATC_TRACE compiles to nothing and its
+ *        arguments are not evaluated.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef DATC_TRACE_HPP
+#define DATC_TRACE_HPP
+
+#ifdef KR_GCS_TRACING
+
+#include <cstdint>
+
+// Service (or TCP command) callback
+void datc_trace_service_entry(const char *name);
+void datc_trace_service_exit(const char *name, bool success);
+
+// GUI command queue
+void datc_trace_command_enqueue(uint64_t id, const char *name);
+void datc_trace_command_dequeue(uint64_t id);
+void datc_trace_command_exit(uint64_t id, bool success);
+
+// ModbusComm: mutex_comm_ and the transaction it guards, function = Modbus function code
+void datc_trace_bus_lock_request(int function);
+void datc_trace_bus_lock_acquired(int function);
+void datc_trace_frame_tx(int function, int reg_addr, int count);
+void datc_trace_frame_rx(int function, int reg_addr, bool success);
+
+// Every status read, from which the first reaction to a command is found
+void datc_trace_status_sample(uint16_t states, int16_t motor_vel, uint16_t finger_pos);
+
+#define DATC_TRACE(event, ...) datc_trace_##event(__VA_ARGS__)
+
+#else
+
+#define DATC_TRACE(event, ...) ((void) 0)
+
+#endif // KR_GCS_TRACING
+
+#endif // DATC_TRACE_HPP
@@ -0,0 +1,95 @@
+/**
+ * @file datc_tracepoints.h
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief LTTng-UST tracepoint provider kr_gcs_ui. Only included by src/datc_trace.cpp; use DATC_TRACE
+ *        from datc_trace.hpp everywhere else.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#undef TRACEPOINT_PROVIDER
+#define TRACEPOINT_PROVIDER kr_gcs_ui
+
+#undef TRACEPOINT_INCLUDE
+#define TRACEPOINT_INCLUDE "datc_tracepoints.h"
+
+#if !defined(DATC_TRACEPOINTS_H) || defined(TRACEPOINT_HEADER_MULTI_READ)
+#define DATC_TRACEPOINTS_H
+
+#include <lttng/tracepoint.h>
+#include <stdint.h>
+
+TRACEPOINT_EVENT(
+    kr_gcs_ui, service_entry,
+    TP_ARGS(const char *, name),
+    TP_FIELDS(ctf_string(name, name))
+)
+
+TRACEPOINT_EVENT(
+    kr_gcs_ui, service_exit,
+    TP_ARGS(const char *, name, int, success),
+    TP_FIELDS(ctf_string(name, name)
+              ctf_integer(int, success, success))
+)
+
+TRACEPOINT_EVENT(
+    kr_gcs_ui, command_enqueue,
+    TP_ARGS(uint64_t, id, const char *, name),
+    TP_FIELDS(ctf_integer(uint64_t, id, id)
+              ctf_string(name, name))
+)
+
+TRACEPOINT_EVENT(
+    kr_gcs_ui, command_dequeue,
+    TP_ARGS(uint64_t, id),
+    TP_FIELDS(ctf_integer(uint64_t, id, id))
+)
+
+TRACEPOINT_EVENT(
+    kr_gcs_ui, command_exit,
+    TP_ARGS(uint64_t, id, int, success),
+    TP_FIELDS(ctf_integer(uint64_t, id, id)
+              ctf_integer(int, success, success))
+)
+
+TRACEPOINT_EVENT(
+    kr_gcs_ui, bus_lock_request,
+    TP_ARGS(int, function),
+    TP_FIELDS(ctf_integer(int, function, function))
+)
+
+TRACEPOINT_EVENT(
+    kr_gcs_ui, bus_lock_acquired,
+    TP_ARGS(int, function),
+    TP_FIELDS(ctf_integer(int, function, function))
+)
+
+TRACEPOINT_EVENT(
+    kr_gcs_ui, frame_tx,
+    TP_ARGS(int, function, int, reg_addr, int, count),
+    TP_FIELDS(ctf_integer(int, function, function)
+              ctf_integer(int, reg_addr, reg_addr)
+              ctf_integer(int, count, count))
+)
+
+TRACEPOINT_EVENT(
+    kr_gcs_ui, frame_rx,
+    TP_ARGS(int, function, int, reg_addr, int, success),
+    TP_FIELDS(ctf_integer(int, function, function)
+              ctf_integer(int, reg_addr, reg_addr)
+              ctf_integer(int, success, success))
+)
+
+TRACEPOINT_EVENT(
+    kr_gcs_ui, status_sample,
+    TP_ARGS(uint16_t, states, int16_t, motor_vel, uint16_t, finger_pos),
+    TP_FIELDS(ctf_integer_hex(uint16_t, states, states)
+              ctf_integer(int16_t, motor_vel, motor_vel)
+              ctf_integer(uint16_t, finger_pos, finger_pos))
+)
+
+#endif // DATC_TRACEPOINTS_H
+
+#include <lttng/tracepoint-event.h>
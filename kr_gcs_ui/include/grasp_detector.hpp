@@ -0,0 +1,88 @@
+/**
+ * @file grasp_detector.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Host-side grasp (contact) detection on the polled DATC samples: current rise over the free
+ *        motion baseline, finger position plateau and velocity drop. No ROS or Qt dependency.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef GRASP_DETECTOR_HPP
+#define GRASP_DETECTOR_HPP
+
+#include "datc_ctrl.hpp"
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+enum class GRASP_ACTION {
+    NONE,
+    STOP,   // motorStop()
+    HOLD,   // Current control with hold_current_ma in the direction of the contact
+};
+
+/**
+ * @brief Thresholds for one kind of part. All criteria have to hold for confirm_samples consecutive samples.
+ */
+struct GraspProfile {
+    int arm_velocity    = 50;   // |motor_vel| from which a motion is watched
+    int current_rise_ma = 150;  // |motor_cur| above the baseline of the current motion
+    int plateau_pos     = 3;    // finger_pos change per sample at most
+    double velocity_drop = 0.3; // |motor_vel| at most this fraction of the peak of the current motion
+    int confirm_samples = 2;
+
+    GRASP_ACTION action = GRASP_ACTION::STOP;
+    int hold_current_ma = 300;
+
+    // Empty if valid
+    string check() const;
+
+    static bool parseAction(const string &str, GRASP_ACTION &action);
+    static const char *getActionName(GRASP_ACTION action);
+};
+
+struct GraspContact {
+    uint16_t finger_pos = 0;
+    int16_t motor_pos   = 0;
+    int16_t motor_cur   = 0;
+    int16_t peak_vel    = 0;
+
+    int64_t onset_ns  = 0; // Sample where the current started to rise
+    int64_t detect_ns = 0; // Sample that confirmed the contact
+};
+
+class GraspDetector {
+public:
+    void setProfile(const GraspProfile &profile) {
+        profile_ = profile;
+        reset();
+    }
+
+    const GraspProfile &getProfile() const {return profile_;}
+
+    // Feed every sample. Returns true once per motion, on the sample that confirms the contact.
+    bool update(const DatcStatus &status, int64_t time_ns);
+
+    const GraspContact &getContact() const {return contact_;}
+
+    void reset();
+
+private:
+    GraspProfile profile_;
+    GraspContact contact_;
+
+    bool armed_    = false;
+    bool has_prev_ = false;
+    uint16_t finger_pos_prev_ = 0;
+
+    double baseline_cur_ = 0;
+    int peak_vel_        = 0;
+    int hits_            = 0;
+    int64_t rise_onset_ns_ = -1;
+};
+
+#endif // GRASP_DETECTOR_HPP
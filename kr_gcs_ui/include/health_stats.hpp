@@ -0,0 +1,160 @@
+/**
+ * @file health_stats.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Gripper health from the polled samples: lifetime wear counters (kept in a file across restarts)
+ *        and the distribution of grasp current, open / close times and voltage over a sliding window.
+ *        Constant cost per sample and fixed memory. No ROS or Qt dependency.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef HEALTH_STATS_HPP
+#define HEALTH_STATS_HPP
+
+#include "datc_ctrl.hpp"
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+const size_t kHealthHistogramBins = 128;
+const size_t kHealthWindowSlots   = 12;           // The window moves on in steps of window / slots
+const double kHealthWindowDefaultS = 3600;
+const double kHealthWindowMinS    = 60;
+const double kHealthWindowMaxS    = 7 * 86400;
+const int64_t kHealthGapNs        = 1000000000;  // Longer between samples does not count as connected time
+
+// Mean and variance (Welford), mergeable across slots
+struct RunningStats {
+    uint64_t count = 0;
+    double mean = 0, m2 = 0;
+    double min = 0, max = 0;
+
+    void add(double x);
+    void merge(const RunningStats &other);
+    double getStdDev() const;
+};
+
+struct MetricSummary {
+    uint64_t count = 0;
+    double mean = 0, std_dev = 0;
+    double min = 0, max = 0;
+    double p50 = 0, p90 = 0, p99 = 0; // From kHealthHistogramBins bins over the metric's range
+};
+
+// One metric over the window: Welford stats and a fixed-bin histogram per slot
+class WindowedMetric {
+public:
+    WindowedMetric(double range_min, double range_max) : range_min_(range_min), range_max_(range_max) {}
+
+    void add(size_t slot, double x);
+    void clearSlot(size_t slot);
+    void clear();
+
+    MetricSummary summarize() const;
+
+private:
+    double range_min_, range_max_;
+
+    RunningStats stats_[kHealthWindowSlots];
+    uint32_t bins_[kHealthWindowSlots][kHealthHistogramBins] = {};
+};
+
+// Lifetime, per gripper
+struct WearCounters {
+    uint64_t samples      = 0;
+    uint64_t read_errors  = 0;
+    uint64_t commands     = 0;
+    uint64_t open_cycles  = 0; // Rising edges of grp_open
+    uint64_t close_cycles = 0; // Rising edges of grp_close
+    uint64_t faults       = 0; // Rising edges of fault
+    double motor_travel_deg = 0;
+    double connected_s      = 0;
+
+    void add(const WearCounters &other);
+};
+
+// Plain "key value" lines; saved through a temporary file, so that a crash leaves the old one
+bool loadWearCounters(const string &path, WearCounters &counters, string &error);
+bool saveWearCounters(const string &path, const WearCounters &counters, string &error);
+
+struct HealthSummary {
+    WearCounters wear;
+
+    double window_s = 0;  // Covered so far, up to the window length
+    uint64_t window_open_cycles  = 0;
+    uint64_t window_close_cycles = 0;
+    uint64_t window_faults       = 0;
+    uint64_t window_read_errors  = 0;
+    double fault_rate_per_hour   = 0;
+
+    MetricSummary grasp_current; // |motor_cur| while grp_close, mA
+    MetricSummary close_time_ms; // GRIPPER_CLOSE command to grp_close
+    MetricSummary open_time_ms;  // GRIPPER_OPEN command to grp_open
+    MetricSummary voltage;       // Register units
+};
+
+class HealthStats {
+public:
+    HealthStats();
+
+    // Clears the window
+    void setWindow(double window_s);
+    double getWindow() const {return window_ns_ * 1e-9;}
+
+    // Reading thread: every read, time_ns CLOCK_MONOTONIC. motor_read / voltage_read: this read covered
+    // those registers (see READ_PROFILE), otherwise they hold older values and are not counted.
+    void addSample(const DatcStatus &status, int64_t time_ns, bool motor_read, bool voltage_read);
+    void addReadError(int64_t time_ns);
+
+    // commands: sent since the last call, the latest being last_code at last_ns
+    void addCommands(uint32_t commands, uint16_t last_code, int64_t last_ns);
+
+    // After a disconnect: no edges or connected time across the gap
+    void resetEdges();
+
+    // Counters loaded for a gripper are added to what was counted since
+    void addWear(const WearCounters &counters) {wear_.add(counters);}
+    void clearWear() {wear_ = WearCounters();}
+    const WearCounters &getWear() const {return wear_;}
+
+    void clearWindow();
+    HealthSummary summarize(int64_t time_ns);
+
+private:
+    int64_t window_ns_;
+    int64_t slot_ns_;
+    int64_t slot_id_     = -1; // time / slot_ns_ of the current slot, -1 before the first sample
+    int64_t window_start_ns_ = -1;
+
+    WearCounters wear_;
+
+    struct SlotCounters {
+        uint64_t open_cycles = 0, close_cycles = 0, faults = 0, read_errors = 0;
+    };
+
+    SlotCounters counters_[kHealthWindowSlots];
+
+    WindowedMetric grasp_current_;
+    WindowedMetric close_time_ms_;
+    WindowedMetric open_time_ms_;
+    WindowedMetric voltage_;
+
+    // Previous sample, for the edges and the travel
+    bool has_prev_ = false;
+    bool prev_open_ = false, prev_close_ = false, prev_fault_ = false;
+    bool has_prev_motor_ = false;
+    int16_t prev_motor_pos_ = 0;
+    int64_t prev_ns_ = 0;
+
+    // Open / close motion being timed, 0 for none
+    uint16_t motion_command_ = 0;
+    int64_t motion_start_ns_ = 0;
+
+    size_t advance(int64_t time_ns);
+};
+
+#endif // HEALTH_STATS_HPP
@@ -0,0 +1,58 @@
+/**
+ * @file jog_stream.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief A setpoint streamed while it is being dragged: the GUI thread only records the latest target and
+ *        the command worker sends it, at most once per period. Targets set in between are coalesced.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef JOG_STREAM_HPP
+#define JOG_STREAM_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+using namespace std;
+
+class JogStream {
+public:
+    // Minimum time between two sends, e.g. one poll period so that the reads keep their share of the bus
+    void setPeriod(double period_s);
+
+    // GUI thread. True if a send() job has to be submitted, false if the one queued will pick it up.
+    bool setTarget(uint16_t target);
+
+    // Something else may have moved the gripper since (a new drag starts): the next target goes out even
+    // if it is the last one sent
+    void resetSent();
+
+    // The queued send does nothing (e.g. after a stop), and one waiting out the period returns at once,
+    // so the stop behind it is not held up; the next setTarget starts over
+    void cancel();
+
+    // Command worker. Waits out the period since the last send, then sends the latest target unless it
+    // already went out. False if send_func failed.
+    bool send(function<bool(uint16_t)> send_func);
+
+private:
+    mutex mutex_;
+    condition_variable cancel_cv_;
+    uint64_t cancels_ = 0;
+
+    uint16_t target_ = 0;
+    bool pending_    = false; // target_ has not been sent yet
+    bool queued_     = false; // A send() job is queued and has not read target_ yet
+
+    bool has_sent_ = false;   // sent_ is what the gripper was last told, false after a failed send
+    uint16_t sent_ = 0;
+    chrono::steady_clock::time_point time_sent_;
+    chrono::steady_clock::duration period_ = chrono::milliseconds(10);
+};
+
+#endif // JOG_STREAM_HPP
@@ -11,25 +11,34 @@
 #ifndef MAIN_WINDOW_HPP
 #define MAIN_WINDOW_HPP
 
-#include <QTimer>
 #include <QLineEdit>
+#include <QThread>
+#include <QPaintEvent>
+#include <QSignalBlocker>
+#include <QStyle>
 #include <QList>
+#include <QSet>
 #include <QMainWindow>
 
+#include <chrono>
+#include <functional>
 #include <iostream>
+#include <map>
 #include <math.h>
+#include <thread>
 
 #include "datc_comm_interface.hpp"
 #include "ui_main_window.h"
 #include "custom_widget.hpp"
+#include "telemetry_plot.hpp"
+#include "command_runner.hpp"
+#include "jog_stream.hpp"
 
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(WIN64) || defined(_WIN64) || defined(__WIN64__)
 #include <windows.h>
 #include <setupapi.h>
 #else
-#include <fstream>
-#include <dirent.h>
-#include <cstring>
+#include "serial_port_watcher.hpp"
 #endif
 
 using namespace std;
@@ -41,18 +50,19 @@ enum class WidgetSeq {
     DATC_CTRL_WIDGET      = 1,
     ADVANCED_CTRL_WIDGET  = 2,
     IMPEDANCE_CTRL_WIDGET = 3,
-    TCP_WIDGET            = 4,
+    TELEMETRY_WIDGET      = 4,
+    TCP_WIDGET            = 5,
 };
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
 
 public:
-    MainWindow(int argc, char** argv, bool &success, QWidget *parent = 0);
+    MainWindow(bool &success, QWidget *parent = 0);
     ~MainWindow();
 
 public Q_SLOTS:
-    void timerCallback();
+    void updateDatcSnapshot(const DatcSnapshot &snapshot);
 
     // Enable & disable
     void datcEnable();
@@ -85,11 +95,9 @@ public Q_SLOTS:
     void changeSlaveAddress();
     void setSlaveAddr();
 
-#ifndef RCLCPP__RCLCPP_HPP_
     // TCP comm. related functions
     void startTcpComm();
     void stopTcpComm();
-#endif
 
     // Auto mapping function
     void on_pushButton_select_modbus_clicked();
@@ -97,25 +105,88 @@ public Q_SLOTS:
     void on_pushButton_select_adv_clicked();
     void on_pushButton_select_tcp_clicked();
     void on_pushButton_select_imped_ctrl_clicked();
+    void on_pushButton_select_plot_clicked();
     void on_pushButton_modbus_refresh_clicked();
 
     // Serial port find function
     std::vector<std::string> getSerialPortLists();
 
+private Q_SLOTS:
+    // Completion of the background startup work, queued from the worker threads
+    void onDatcInterfaceReady();
+    void updateSerialPortList();
+
+    void setSerialPortList(const QStringList &ports);
+
+    void onCommandFinished(quint64 id, bool success, qint64 elapsed_ms);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
 private:
+    // Pages other than the Modbus page are built on first selection
+    QWidget *getPage(WidgetSeq seq);
+    void selectPage(WidgetSeq seq);
+
+    void setupDatcCtrlWidget();
+    void setupAdvancedCtrlWidget();
+    void setupImpedanceCtrlWidget();
+    void setupTcpWidget();
+
+    void runCommand(const QString &name, function<bool()> job, function<void(bool)> on_done = nullptr,
+                    bool urgent = false);
+    void setCommandState(QPushButton *btn, const QString &state);
+    bool runImpedanceSequence(DATC_COMMAND cmd); // Command worker thread
+
+    void syncSliderSpinbox(QSlider *slider, QDoubleSpinBox *spinbox);
+
+    // Finger position jog of the DATC control and impedance pages
+    void setupJog(QSlider *slider, QDoubleSpinBox *spinbox, QCheckBox *checkbox, QPushButton *btn_set);
+    void jogFingerPos(uint16_t finger_pos, QPushButton *btn_set);
+    void setMenuButtonActive(QPushButton *btn, bool active);
+
+    // Prints the time since process creation
+    void traceStartup(const char *event);
+
     Ui::MainWindow *ui_;
 
-    ModbusWidget        *modbus_widget_;
-    DatcCtrlWidget      *datc_ctrl_widget_;
-    TcpWidget           *tcp_widget_;
-    AdvancedCtrlWidget  *advanced_ctrl_widget_;
-    ImpedanceCtrlWidget *impedance_ctrl_widget_;
+    ModbusWidget        *modbus_widget_         = NULL;
+    DatcCtrlWidget      *datc_ctrl_widget_      = NULL;
+    TcpWidget           *tcp_widget_            = NULL;
+    AdvancedCtrlWidget  *advanced_ctrl_widget_  = NULL;
+    ImpedanceCtrlWidget *impedance_ctrl_widget_ = NULL;
+    TelemetryWidget     *telemetry_widget_      = NULL;
 
     QString menu_btn_active_str_, menu_btn_inactive_str_;
     QString btn_active_str_, btn_inactive_str_;
+    QString btn_qss_;
+    QString cmd_state_qss_;
+
+    struct PendingCommand {
+        QPushButton *button;
+        function<void(bool)> on_done;
+    };
+
+    CommandRunner *command_runner_;
+    map<quint64, PendingCommand> pending_commands_;
+    QSet<QPushButton *> pending_buttons_;
+
+    JogStream jog_;
+
+    DatcSnapshot snapshot_prev_;
+    bool snapshot_applied_ = false;
+
+    bool first_paint_traced_ = false;
+    bool port_list_traced_   = false;
+
+    // Written by the worker threads, read by the GUI thread only after join()
+    thread interface_init_thread_;
+    DatcCommInterface *datc_interface_pending_ = NULL;
+
+    thread port_scan_thread_;
+    vector<string> port_list_pending_;
 
-    QTimer *timer_;
-    DatcCommInterface *datc_interface_;
+    DatcCommInterface *datc_interface_ = NULL;
 };
 
 }
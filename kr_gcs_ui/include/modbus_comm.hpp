@@ -18,6 +18,10 @@
 #include <modbus/modbus-rtu.h>
 #endif
 
+#include "async_logger.hpp"
+#include "datc_trace.hpp"
+
+#include <atomic>
 #include <mutex>
 #include <iostream>
 #include <vector>
@@ -41,32 +45,39 @@ public:
     bool modbusInit(const char *port_name, uint16_t slave_addr, int baudrate) {
         unique_lock<mutex> lg(mutex_comm_);
 
-        mb_ = modbus_new_rtu(port_name, baudrate, PARITY_MODE, DATA_BIT, STOP_BIT);
+        if (mb_ != NULL) {
+            DATC_LOG_ERROR("Modbus communication is already initiated");
+            return false;
+        }
 
-        modbus_rtu_set_serial_mode(mb_, MODBUS_RTU_RS485);
-        modbus_rtu_set_rts_delay  (mb_, 300);
-        modbus_set_debug          (mb_, DEBUG_MODE);
+        mb_ = modbus_new_rtu(port_name, baudrate, PARITY_MODE, DATA_BIT, STOP_BIT);
 
         if (mb_ == NULL) {
-            fprintf(stderr, "Unable to create the libmodbus context\n");
+            DATC_LOG_ERROR("Unable to create the libmodbus context");
             return false;
         }
 
+        modbus_rtu_set_serial_mode(mb_, MODBUS_RTU_RS485);
+        modbus_rtu_set_rts_delay  (mb_, 300);
+        modbus_set_debug          (mb_, DEBUG_MODE);
+
         if (modbus_set_slave(mb_, slave_addr) == -1) {
-            fprintf(stderr, "server_id= %d Invalid slave ID: %s\n", slave_addr, modbus_strerror(errno));
+            DATC_LOG_ERROR("server_id= %d Invalid slave ID: %s", slave_addr, modbus_strerror(errno));
             modbus_free(mb_);
+            mb_ = NULL;
             return false;
         }
 
         if (modbus_connect(mb_) == -1) {
-            fprintf(stderr, "Unable to connect %s\n", modbus_strerror(errno));
+            DATC_LOG_ERROR("Unable to connect %s", modbus_strerror(errno));
             modbus_free(mb_);
+            mb_ = NULL;
             return false;
         }
 
         slave_num_ = slave_addr;
         connection_state_ = true;
-        COUT("Modbus communication initiated");
+        DATC_LOG_INFO("Modbus communication initiated");
 
         return true;
     }
@@ -77,9 +88,14 @@ public:
 
         unique_lock<mutex> lg(mutex_comm_);
 
+        if (mb_ == NULL) {
+            return;
+        }
+
         modbus_close(mb_);
         modbus_free (mb_);
-        COUT("Modbus released");
+        mb_ = NULL;
+        DATC_LOG_INFO("Modbus released");
     }
 
     bool slaveChange(uint16_t slave_addr) {
@@ -88,15 +104,16 @@ public:
         unique_lock<mutex> lg(mutex_comm_);
 
         if (modbus_set_slave(mb_, slave_addr) == -1) {
-            fprintf(stderr, "server_id= %d Invalid slave ID: %s\n", slave_addr, modbus_strerror(errno));
+            DATC_LOG_ERROR("server_id= %d Invalid slave ID: %s", slave_addr, modbus_strerror(errno));
             modbus_close(mb_);
             modbus_free (mb_);
+            mb_ = NULL;
             connection_state_ = false;
             return false;
         }
 
         usleep(10000);
-        printf("Modbus slave address changed to %d\n", slave_addr);
+        DATC_LOG_INFO("Modbus slave address changed to %d", slave_addr);
         slave_num_ = slave_addr;
         connection_state_ = true;
 
@@ -105,21 +122,25 @@ public:
 
     bool sendData(int reg_addr, vector<uint16_t> data) {
         if (!connection_state_) {
-            COUT("Modbus communication is not enabled.");
+            DATC_LOG_WARN("Modbus communication is not enabled.");
             return false;
         }
 
+        uint16_t register_number = data.size();
+        [[maybe_unused]] const int function = (register_number == 1) ? 0x06 : 0x10;
+
+        DATC_TRACE(bus_lock_request, function);
         unique_lock<mutex> lg(mutex_comm_);
+        DATC_TRACE(bus_lock_acquired, function);
+        DATC_TRACE(frame_tx, function, reg_addr, register_number);
 
-        uint16_t register_number = data.size();
+        const int ret = (register_number == 1) ? modbus_write_register(mb_, reg_addr, data[0])
+                                               : modbus_write_registers(mb_, reg_addr, register_number, &data[0]);
+
+        DATC_TRACE(frame_rx, function, reg_addr, ret != -1);
 
-        if (register_number == 1) {
-            if (modbus_write_register(mb_, reg_addr, data[0]) == -1) {
-                fprintf(stderr, "Failed to modbus write register %d : %s\n", reg_addr, modbus_strerror(errno));
-                return false;
-            }
-        } else if (modbus_write_registers(mb_, reg_addr, register_number, &data[0]) == -1) {
-            fprintf(stderr, "Failed to modbus write register %d : %s\n", reg_addr, modbus_strerror(errno));
+        if (ret == -1) {
+            DATC_LOG_ERROR("Failed to modbus write register %d : %s", reg_addr, modbus_strerror(errno));
             return false;
         }
 
@@ -128,14 +149,21 @@ public:
 
     bool sendData(int reg_addr, uint16_t data) {
         if (!connection_state_) {
-            COUT("Modbus communication is not enabled.");
+            DATC_LOG_WARN("Modbus communication is not enabled.");
             return false;
         }
 
+        DATC_TRACE(bus_lock_request, 0x06);
         unique_lock<mutex> lg(mutex_comm_);
+        DATC_TRACE(bus_lock_acquired, 0x06);
+        DATC_TRACE(frame_tx, 0x06, reg_addr, 1);
+
+        const int ret = modbus_write_register(mb_, reg_addr, data);
 
-        if (modbus_write_register(mb_, reg_addr, data) == -1) {
-            fprintf(stderr, "Failed to modbus write register %d : %s\n", reg_addr, modbus_strerror(errno));
+        DATC_TRACE(frame_rx, 0x06, reg_addr, ret != -1);
+
+        if (ret == -1) {
+            DATC_LOG_ERROR("Failed to modbus write register %d : %s", reg_addr, modbus_strerror(errno));
             return false;
         } else {
             return true;
@@ -144,17 +172,22 @@ public:
 
     bool recvData(int reg_addr, int nb, vector<uint16_t> &data) {
         if (!connection_state_) {
-            COUT("Modbus communication is not enabled.");
+            DATC_LOG_WARN("Modbus communication is not enabled.");
             return false;
         }
 
+        DATC_TRACE(bus_lock_request, 0x03);
         unique_lock<mutex> lg(mutex_comm_);
+        DATC_TRACE(bus_lock_acquired, 0x03);
 
         uint16_t data_temp[nb];
 
-        if (modbus_read_registers(mb_, reg_addr, nb, data_temp) == -1) {
-            mutex_comm_.unlock();
-            fprintf(stderr, "Failed to read input registers! : %s\n", modbus_strerror(errno));
+        DATC_TRACE(frame_tx, 0x03, reg_addr, nb);
+        const int ret = modbus_read_registers(mb_, reg_addr, nb, data_temp);
+        DATC_TRACE(frame_rx, 0x03, reg_addr, ret != -1);
+
+        if (ret == -1) {
+            DATC_LOG_ERROR("Failed to read input registers! : %s", modbus_strerror(errno));
             return false;
         }
 
@@ -173,11 +206,12 @@ public:
 
 private:
     mutex mutex_comm_;
-    modbus_t *mb_;
+    modbus_t *mb_ = NULL;
 
-    bool connection_state_ = false;
+    atomic<bool> connection_state_ {false};
 
-    uint16_t slave_num_ = 0;
+    // Read without mutex_comm_ (health thread, GUI snapshot)
+    atomic<uint16_t> slave_num_ {0};
 };
 
 #endif // MODBUS_COMM_HPP
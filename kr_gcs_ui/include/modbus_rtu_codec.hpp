@@ -0,0 +1,474 @@
+/**
+ * @file modbus_rtu_codec.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Allocation-free Modbus RTU frame encoder/parser for the function codes used by the DATC
+ *        (FC03, FC06, FC16, FC23) and a slice-by-8 CRC-16/MODBUS kernel.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef MODBUS_RTU_CODEC_HPP
+#define MODBUS_RTU_CODEC_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace modbus_rtu {
+
+const size_t kMaxAduLength = 256;
+
+const uint16_t kMaxReadRegisters       = 125;
+const uint16_t kMaxWriteRegisters      = 123;
+const uint16_t kMaxReadWriteRegisters  = 121; // Write side of FC23
+
+enum class FUNCTION_CODE : uint8_t {
+    READ_HOLDING_REGISTERS        = 0x03,
+    WRITE_SINGLE_REGISTER         = 0x06,
+    WRITE_MULTIPLE_REGISTERS      = 0x10,
+    READ_WRITE_MULTIPLE_REGISTERS = 0x17,
+};
+
+enum class PARSE_RESULT {
+    OK,
+    INCOMPLETE,           // More bytes are needed before the frame can be judged
+    BAD_CRC,
+    BAD_LENGTH,           // Byte count/quantity fields are inconsistent or out of range
+    BAD_EXCEPTION,        // Exception response with exception code 0, which would not read as an exception
+    UNSUPPORTED_FUNCTION,
+};
+
+/**
+ * @brief Parsed frame. Register payloads are not copied: @p data points into the caller's buffer and
+ *        holds @p data_registers big-endian registers.
+ */
+struct FrameView {
+    uint8_t slave          = 0;
+    uint8_t function       = 0;
+    uint8_t exception_code = 0; // Non-zero for exception responses (function has bit 7 set)
+
+    uint16_t address  = 0; // FC03/06/16 start address, FC23 read start address
+    uint16_t quantity = 0; // FC03/16 quantity, FC23 read quantity, FC06 register value
+
+    uint16_t write_address  = 0; // FC23 only
+    uint16_t write_quantity = 0; // FC23 only
+
+    const uint8_t *data     = nullptr;
+    uint16_t data_registers = 0;
+
+    size_t length = 0; // Total frame length including CRC
+
+    uint16_t registerAt(size_t i) const {
+        return (uint16_t) ((data[2 * i] << 8) | data[2 * i + 1]);
+    }
+
+    bool isException() const {return exception_code != 0;}
+};
+
+// CRC-16/MODBUS (reflected poly 0xA001, init 0xFFFF) ////////////////////////////////////////////
+
+/**
+ * @brief Bit-at-a-time reference implementation.
+ */
+inline uint16_t crc16Bitwise(const uint8_t *buf, size_t len) {
+    uint16_t crc = 0xFFFF;
+
+    for (size_t i = 0; i < len; i++) {
+        crc ^= buf[i];
+
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x0001) ? (crc >> 1) ^ 0xA001 : (crc >> 1);
+        }
+    }
+
+    return crc;
+}
+
+namespace detail {
+
+using CrcTables = std::array<std::array<uint16_t, 256>, 8>;
+
+constexpr CrcTables makeCrcTables() {
+    CrcTables tables {};
+
+    for (uint16_t b = 0; b < 256; b++) {
+        uint16_t crc = b;
+
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x0001) ? (crc >> 1) ^ 0xA001 : (crc >> 1);
+        }
+
+        tables[0][b] = crc;
+    }
+
+    // tables[k][b]: CRC contribution of byte b followed by k zero bytes
+    for (size_t k = 1; k < 8; k++) {
+        for (size_t b = 0; b < 256; b++) {
+            const uint16_t prev = tables[k - 1][b];
+            tables[k][b] = (prev >> 8) ^ tables[0][prev & 0xFF];
+        }
+    }
+
+    return tables;
+}
+
+inline constexpr CrcTables kCrcTables = makeCrcTables();
+
+} // namespace detail
+
+/**
+ * @brief Byte-at-a-time table-driven CRC.
+ */
+inline uint16_t crc16Table(const uint8_t *buf, size_t len, uint16_t crc = 0xFFFF) {
+    const auto &t0 = detail::kCrcTables[0];
+
+    for (size_t i = 0; i < len; i++) {
+        crc = (crc >> 8) ^ t0[(crc ^ buf[i]) & 0xFF];
+    }
+
+    return crc;
+}
+
+/**
+ * @brief Slice-by-8 CRC: eight independent table lookups per 8-byte block, byte-wise tail.
+ */
+inline uint16_t crc16(const uint8_t *buf, size_t len) {
+    const auto &t = detail::kCrcTables;
+    uint16_t crc = 0xFFFF;
+
+    while (len >= 8) {
+        const uint8_t b0 = buf[0] ^ (uint8_t) (crc & 0xFF);
+        const uint8_t b1 = buf[1] ^ (uint8_t) (crc >> 8);
+
+        crc = t[7][b0]     ^ t[6][b1]     ^ t[5][buf[2]] ^ t[4][buf[3]] ^
+              t[3][buf[4]] ^ t[2][buf[5]] ^ t[1][buf[6]] ^ t[0][buf[7]];
+
+        buf += 8;
+        len -= 8;
+    }
+
+    return crc16Table(buf, len, crc);
+}
+
+// Encoder ////////////////////////////////////////////////////////////////////////////////////////
+// Every encoder writes a complete ADU (including CRC) into the caller's buffer and returns its length,
+// or 0 if the buffer is too small or a quantity is out of range.
+
+namespace detail {
+
+inline uint8_t *putU16(uint8_t *p, uint16_t value) {
+    p[0] = (uint8_t) (value >> 8);
+    p[1] = (uint8_t) (value & 0xFF);
+    return p + 2;
+}
+
+inline uint16_t getU16(const uint8_t *p) {
+    return (uint16_t) ((p[0] << 8) | p[1]);
+}
+
+inline uint8_t *putRegisters(uint8_t *p, const uint16_t *values, uint16_t nb) {
+    for (uint16_t i = 0; i < nb; i++) {
+        p = putU16(p, values[i]);
+    }
+
+    return p;
+}
+
+inline size_t finish(uint8_t *buf, uint8_t *end) {
+    const size_t len = end - buf;
+    const uint16_t crc = crc16(buf, len);
+
+    // CRC is transmitted low byte first
+    end[0] = (uint8_t) (crc & 0xFF);
+    end[1] = (uint8_t) (crc >> 8);
+
+    return len + 2;
+}
+
+} // namespace detail
+
+inline size_t encodeReadRegisters(uint8_t *buf, size_t cap, uint8_t slave, uint16_t addr, uint16_t nb) {
+    if (cap < 8 || nb == 0 || nb > kMaxReadRegisters) {
+        return 0;
+    }
+
+    uint8_t *p = buf;
+    *p++ = slave;
+    *p++ = (uint8_t) FUNCTION_CODE::READ_HOLDING_REGISTERS;
+    p = detail::putU16(p, addr);
+    p = detail::putU16(p, nb);
+
+    return detail::finish(buf, p);
+}
+
+inline size_t encodeWriteRegister(uint8_t *buf, size_t cap, uint8_t slave, uint16_t addr, uint16_t value) {
+    if (cap < 8) {
+        return 0;
+    }
+
+    uint8_t *p = buf;
+    *p++ = slave;
+    *p++ = (uint8_t) FUNCTION_CODE::WRITE_SINGLE_REGISTER;
+    p = detail::putU16(p, addr);
+    p = detail::putU16(p, value);
+
+    return detail::finish(buf, p);
+}
+
+inline size_t encodeWriteRegisters(uint8_t *buf, size_t cap, uint8_t slave, uint16_t addr,
+                                   const uint16_t *values, uint16_t nb) {
+    if (nb == 0 || nb > kMaxWriteRegisters || cap < 9 + 2 * (size_t) nb) {
+        return 0;
+    }
+
+    uint8_t *p = buf;
+    *p++ = slave;
+    *p++ = (uint8_t) FUNCTION_CODE::WRITE_MULTIPLE_REGISTERS;
+    p = detail::putU16(p, addr);
+    p = detail::putU16(p, nb);
+    *p++ = (uint8_t) (2 * nb);
+    p = detail::putRegisters(p, values, nb);
+
+    return detail::finish(buf, p);
+}
+
+inline size_t encodeReadWriteRegisters(uint8_t *buf, size_t cap, uint8_t slave,
+                                       uint16_t read_addr, uint16_t read_nb,
+                                       uint16_t write_addr, const uint16_t *values, uint16_t write_nb) {
+    if (read_nb == 0 || read_nb > kMaxReadRegisters || write_nb == 0 || write_nb > kMaxReadWriteRegisters ||
+        cap < 13 + 2 * (size_t) write_nb) {
+        return 0;
+    }
+
+    uint8_t *p = buf;
+    *p++ = slave;
+    *p++ = (uint8_t) FUNCTION_CODE::READ_WRITE_MULTIPLE_REGISTERS;
+    p = detail::putU16(p, read_addr);
+    p = detail::putU16(p, read_nb);
+    p = detail::putU16(p, write_addr);
+    p = detail::putU16(p, write_nb);
+    *p++ = (uint8_t) (2 * write_nb);
+    p = detail::putRegisters(p, values, write_nb);
+
+    return detail::finish(buf, p);
+}
+
+/**
+ * @brief FC03/FC23 response carrying @p nb register values.
+ */
+inline size_t encodeRegistersResponse(uint8_t *buf, size_t cap, uint8_t slave, FUNCTION_CODE function,
+                                      const uint16_t *values, uint16_t nb) {
+    if (nb == 0 || nb > kMaxReadRegisters || cap < 5 + 2 * (size_t) nb) {
+        return 0;
+    }
+
+    uint8_t *p = buf;
+    *p++ = slave;
+    *p++ = (uint8_t) function;
+    *p++ = (uint8_t) (2 * nb);
+    p = detail::putRegisters(p, values, nb);
+
+    return detail::finish(buf, p);
+}
+
+/**
+ * @brief FC06 (address, value) or FC16 (address, quantity) acknowledgement.
+ */
+inline size_t encodeWriteResponse(uint8_t *buf, size_t cap, uint8_t slave, FUNCTION_CODE function,
+                                  uint16_t addr, uint16_t value_or_nb) {
+    if (cap < 8) {
+        return 0;
+    }
+
+    uint8_t *p = buf;
+    *p++ = slave;
+    *p++ = (uint8_t) function;
+    p = detail::putU16(p, addr);
+    p = detail::putU16(p, value_or_nb);
+
+    return detail::finish(buf, p);
+}
+
+inline size_t encodeException(uint8_t *buf, size_t cap, uint8_t slave, uint8_t function, uint8_t exception_code) {
+    if (cap < 5) {
+        return 0;
+    }
+
+    uint8_t *p = buf;
+    *p++ = slave;
+    *p++ = function | 0x80;
+    *p++ = exception_code;
+
+    return detail::finish(buf, p);
+}
+
+// Parser /////////////////////////////////////////////////////////////////////////////////////////
+// Both parsers accept a buffer that may hold a partial frame (returning INCOMPLETE) or trailing bytes
+// of the next frame; frame.length tells how many bytes were consumed.
+
+namespace detail {
+
+inline PARSE_RESULT checkCrc(const uint8_t *buf, size_t len, size_t frame_len, FrameView &frame) {
+    if (len < frame_len) {
+        return PARSE_RESULT::INCOMPLETE;
+    }
+
+    const uint16_t crc = (uint16_t) (buf[frame_len - 2] | (buf[frame_len - 1] << 8));
+
+    if (crc16(buf, frame_len - 2) != crc) {
+        return PARSE_RESULT::BAD_CRC;
+    }
+
+    frame.length = frame_len;
+    return PARSE_RESULT::OK;
+}
+
+} // namespace detail
+
+/**
+ * @brief Parse a master -> slave frame.
+ */
+inline PARSE_RESULT parseRequest(const uint8_t *buf, size_t len, FrameView &frame) {
+    frame = FrameView();
+
+    if (len < 2) {
+        return PARSE_RESULT::INCOMPLETE;
+    }
+
+    frame.slave    = buf[0];
+    frame.function = buf[1];
+
+    switch ((FUNCTION_CODE) buf[1]) {
+        case FUNCTION_CODE::READ_HOLDING_REGISTERS:
+        case FUNCTION_CODE::WRITE_SINGLE_REGISTER: {
+            if (len < 8) {
+                return PARSE_RESULT::INCOMPLETE;
+            }
+
+            frame.address  = detail::getU16(buf + 2);
+            frame.quantity = detail::getU16(buf + 4);
+
+            if (buf[1] == (uint8_t) FUNCTION_CODE::READ_HOLDING_REGISTERS &&
+                (frame.quantity == 0 || frame.quantity > kMaxReadRegisters)) {
+                return PARSE_RESULT::BAD_LENGTH;
+            }
+
+            return detail::checkCrc(buf, len, 8, frame);
+        }
+
+        case FUNCTION_CODE::WRITE_MULTIPLE_REGISTERS: {
+            if (len < 7) {
+                return PARSE_RESULT::INCOMPLETE;
+            }
+
+            frame.address  = detail::getU16(buf + 2);
+            frame.quantity = detail::getU16(buf + 4);
+
+            if (frame.quantity == 0 || frame.quantity > kMaxWriteRegisters || buf[6] != 2 * frame.quantity) {
+                return PARSE_RESULT::BAD_LENGTH;
+            }
+
+            frame.data           = buf + 7;
+            frame.data_registers = frame.quantity;
+
+            return detail::checkCrc(buf, len, 9 + buf[6], frame);
+        }
+
+        case FUNCTION_CODE::READ_WRITE_MULTIPLE_REGISTERS: {
+            if (len < 11) {
+                return PARSE_RESULT::INCOMPLETE;
+            }
+
+            frame.address        = detail::getU16(buf + 2);
+            frame.quantity       = detail::getU16(buf + 4);
+            frame.write_address  = detail::getU16(buf + 6);
+            frame.write_quantity = detail::getU16(buf + 8);
+
+            if (frame.quantity == 0 || frame.quantity > kMaxReadRegisters ||
+                frame.write_quantity == 0 || frame.write_quantity > kMaxReadWriteRegisters ||
+                buf[10] != 2 * frame.write_quantity) {
+                return PARSE_RESULT::BAD_LENGTH;
+            }
+
+            frame.data           = buf + 11;
+            frame.data_registers = frame.write_quantity;
+
+            return detail::checkCrc(buf, len, 13 + buf[10], frame);
+        }
+
+        default:
+            return PARSE_RESULT::UNSUPPORTED_FUNCTION;
+    }
+}
+
+/**
+ * @brief Parse a slave -> master frame, including exception responses.
+ */
+inline PARSE_RESULT parseResponse(const uint8_t *buf, size_t len, FrameView &frame) {
+    frame = FrameView();
+
+    if (len < 2) {
+        return PARSE_RESULT::INCOMPLETE;
+    }
+
+    frame.slave    = buf[0];
+    frame.function = buf[1];
+
+    if (buf[1] & 0x80) {
+        if (len < 3) {
+            return PARSE_RESULT::INCOMPLETE;
+        }
+
+        if (buf[2] == 0) {
+            return PARSE_RESULT::BAD_EXCEPTION;
+        }
+
+        frame.function       = buf[1] & 0x7F;
+        frame.exception_code = buf[2];
+
+        return detail::checkCrc(buf, len, 5, frame);
+    }
+
+    switch ((FUNCTION_CODE) buf[1]) {
+        case FUNCTION_CODE::READ_HOLDING_REGISTERS:
+        case FUNCTION_CODE::READ_WRITE_MULTIPLE_REGISTERS: {
+            if (len < 3) {
+                return PARSE_RESULT::INCOMPLETE;
+            }
+
+            const uint8_t byte_count = buf[2];
+
+            if (byte_count == 0 || (byte_count & 0x01) || byte_count > 2 * kMaxReadRegisters) {
+                return PARSE_RESULT::BAD_LENGTH;
+            }
+
+            frame.data           = buf + 3;
+            frame.data_registers = byte_count / 2;
+            frame.quantity       = frame.data_registers;
+
+            return detail::checkCrc(buf, len, 5 + byte_count, frame);
+        }
+
+        case FUNCTION_CODE::WRITE_SINGLE_REGISTER:
+        case FUNCTION_CODE::WRITE_MULTIPLE_REGISTERS: {
+            if (len < 8) {
+                return PARSE_RESULT::INCOMPLETE;
+            }
+
+            frame.address  = detail::getU16(buf + 2);
+            frame.quantity = detail::getU16(buf + 4);
+
+            return detail::checkCrc(buf, len, 8, frame);
+        }
+
+        default:
+            return PARSE_RESULT::UNSUPPORTED_FUNCTION;
+    }
+}
+
+} // namespace modbus_rtu
+
+#endif // MODBUS_RTU_CODEC_HPP
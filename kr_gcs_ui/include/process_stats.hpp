@@ -0,0 +1,64 @@
+/**
+ * @file process_stats.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Startup time and memory figures of the current process, read from /proc.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef PROCESS_STATS_HPP
+#define PROCESS_STATS_HPP
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+using namespace std;
+
+/**
+ * @brief Time since the kernel started this process (includes dynamic loading and static init),
+ *        with clock tick resolution. Returns -1 if /proc is unavailable.
+ */
+inline double getProcessUptimeMs() {
+    ifstream stat_file("/proc/self/stat"), uptime_file("/proc/uptime");
+    string stat;
+    double uptime_sec;
+
+    if (!getline(stat_file, stat) || !(uptime_file >> uptime_sec)) {
+        return -1;
+    }
+
+    // Field 22 (starttime); skip past the command name, which may contain spaces
+    istringstream fields(stat.substr(stat.rfind(')') + 2));
+    string field;
+    unsigned long long start_ticks = 0;
+
+    for (int i = 3; i <= 22 && fields >> field; i++) {
+        if (i == 22) {
+            start_ticks = stoull(field);
+        }
+    }
+
+    return (uptime_sec - (double) start_ticks / sysconf(_SC_CLK_TCK)) * 1000;
+}
+
+/**
+ * @brief Resident set size in kB (VmRSS) of this process, or of @p pid if given. Returns -1 if unavailable.
+ */
+inline long getRssKb(pid_t pid = 0) {
+    ifstream status_file(pid > 0 ? "/proc/" + to_string(pid) + "/status" : string("/proc/self/status"));
+    string line;
+
+    while (getline(status_file, line)) {
+        if (line.compare(0, 6, "VmRSS:") == 0) {
+            return stol(line.substr(6));
+        }
+    }
+
+    return -1;
+}
+
+#endif // PROCESS_STATS_HPP
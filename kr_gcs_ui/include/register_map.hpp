@@ -0,0 +1,69 @@
+/**
+ * @file register_map.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Register map of a DATC firmware variant. The variants are described in
+ *        config/datc_register_map.yaml and compiled into kRegisterMaps at build time.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef REGISTER_MAP_HPP
+#define REGISTER_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Flags of DatcStatus, in the order of RegisterMap::bits
+enum class STATUS_FLAG {
+    ENABLE,
+    INITIALIZE,
+    MOTOR_POS_CTRL,
+    MOTOR_VEL_CTRL,
+    MOTOR_CUR_CTRL,
+    GRP_OPEN,
+    GRP_CLOSE,
+    FAULT,
+};
+
+const size_t kStatusFlagCount = 8;
+
+struct RegisterMap {
+    const char *name;
+    uint16_t version_min;
+    uint16_t version_max;
+
+    uint16_t command_addr;
+    uint16_t status_addr;
+    uint16_t status_count;  // Full read
+    uint16_t minimal_count; // Minimal read
+
+    // Offsets in the status block (the status word is at 0), -1 if the variant does not have it
+    int8_t motor_pos;
+    int8_t motor_cur;
+    int8_t motor_vel;
+    int8_t finger_pos;
+    int8_t voltage;
+
+    // Bit of each STATUS_FLAG in the status word, -1 if the variant does not have it
+    int8_t bits[kStatusFlagCount];
+
+    constexpr int8_t getBit(STATUS_FLAG flag) const {return bits[(size_t) flag];}
+};
+
+// Generated: kVersionRegAddr, kRegisterMaps, kRegisterMapDefault
+#include "datc_register_map_table.hpp"
+
+// NULL if no variant covers the version
+constexpr const RegisterMap *findRegisterMap(uint16_t version) {
+    for (const auto &map : kRegisterMaps) {
+        if (version >= map.version_min && version <= map.version_max) {
+            return &map;
+        }
+    }
+
+    return NULL;
+}
+
+#endif // REGISTER_MAP_HPP
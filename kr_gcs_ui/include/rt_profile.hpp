@@ -0,0 +1,71 @@
+/**
+ * @file rt_profile.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Real-time execution profile (scheduling, CPU pinning, memory locking) for the bus poll thread
+ *        and a wakeup latency recorder to check what it achieved. Linux only, no ROS or Qt dependency.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef RT_PROFILE_HPP
+#define RT_PROFILE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct RtProfile {
+    string policy = "other";  // other, fifo or rr
+    int priority  = 0;        // 1 ~ 99 for fifo and rr
+
+    vector<int> cpus;         // Pin to these CPUs, empty for no pinning
+    bool isolated_core = false; // Pin to the first CPU in /sys/devices/system/cpu/isolated instead
+
+    bool lock_memory = false; // mlockall() and prefault the stack and the heap
+
+    bool isDefault() const {
+        return policy == "other" && cpus.empty() && !isolated_core && !lock_memory;
+    }
+};
+
+struct RtProfileResult {
+    string applied;         // What is in effect, for the log
+    vector<string> errors;  // What could not be applied and why; the rest still is
+};
+
+/**
+ * @brief Applies the profile to the calling thread. mlockall() and the malloc tuning of the heap prefault
+ *        are process-wide by nature; everything else only affects the caller. Never fails as a whole: what
+ *        is not permitted is skipped and reported.
+ */
+RtProfileResult applyRtProfile(const RtProfile &profile);
+
+/**
+ * @brief Fixed-size record of wakeup latencies (actual wakeup - deadline). add() never allocates.
+ */
+class LatencyRecorder {
+public:
+    explicit LatencyRecorder(size_t capacity) : samples_(capacity) {}
+
+    void add(int64_t latency_ns) {
+        if (count_ < samples_.size()) {
+            samples_[count_++] = latency_ns;
+        }
+    }
+
+    bool isFull() const {return count_ == samples_.size();}
+    size_t getCount() const {return count_;}
+
+    // "p50 12 us, p90 ..., max ..." over the recorded samples; sorts them in place
+    string report();
+
+private:
+    vector<int64_t> samples_;
+    size_t count_ = 0;
+};
+
+#endif // RT_PROFILE_HPP
@@ -0,0 +1,76 @@
+/**
+ * @file serial_port_watcher.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Hotplug-aware list of serial ports (ttyUSB*, ttyACM* and the /dev/serial/by-id aliases),
+ *        kept up to date by inotify on a background thread. Linux only, no ROS or Qt dependency.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef SERIAL_PORT_WATCHER_HPP
+#define SERIAL_PORT_WATCHER_HPP
+
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+enum class SERIAL_PORT_EVENT {
+    ADDED,
+    REMOVED,
+};
+
+class SerialPortWatcher {
+public:
+    // Called on the watcher thread, once per added or removed path
+    using Callback = function<void(SERIAL_PORT_EVENT event, const string &path)>;
+
+    SerialPortWatcher() {}
+    ~SerialPortWatcher();
+
+    SerialPortWatcher(const SerialPortWatcher &) = delete;
+    SerialPortWatcher &operator=(const SerialPortWatcher &) = delete;
+
+    // Scans once synchronously, so getPorts() is valid when this returns
+    bool start(Callback callback);
+    void stop();
+
+    // Sorted snapshot
+    vector<string> getPorts();
+
+    // One-shot scan without watching
+    static vector<string> scanPorts();
+
+    // The /dev/serial/by-id alias of the same device, or an empty string
+    static string getStablePath(const string &path);
+
+private:
+    void run();
+
+    void addPort(const string &path);
+    void removePort(const string &path);
+    void watchById(bool add_existing);
+    void rescan();
+
+    Callback callback_;
+    thread thread_;
+
+    int inotify_fd_ = -1;
+    int wake_fd_    = -1;
+
+    // /dev/serial and /dev/serial/by-id only exist while an adapter is plugged in
+    int wd_dev_    = -1;
+    int wd_serial_ = -1;
+    int wd_by_id_  = -1;
+
+    set<string> ports_;
+    mutex mutex_;
+};
+
+#endif // SERIAL_PORT_WATCHER_HPP
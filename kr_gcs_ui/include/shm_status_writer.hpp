@@ -0,0 +1,49 @@
+/**
+ * @file shm_status_writer.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Writer side of the DATC status shared-memory segment (layout and reader in datc_shm.h).
+ *        Linux only, no ROS or Qt dependency.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef SHM_STATUS_WRITER_HPP
+#define SHM_STATUS_WRITER_HPP
+
+#include "datc_ctrl.hpp"
+#include "datc_shm.h"
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+/**
+ * @brief Single writer. write() is wait-free: readers retry instead of holding the writer up.
+ */
+class ShmStatusWriter {
+public:
+    ShmStatusWriter() {}
+    ~ShmStatusWriter();
+
+    ShmStatusWriter(const ShmStatusWriter &) = delete;
+    ShmStatusWriter &operator=(const ShmStatusWriter &) = delete;
+
+    // name as for shm_open(), e.g. "/datc_status". Replaces a segment left behind by a previous writer.
+    bool open(const string &name, string &error);
+    void close();
+
+    bool isOpen() const {return segment_ != NULL;}
+    const string &getName() const {return name_;}
+
+    void write(const DatcStatus &status, uint8_t flags, int64_t stamp_ns);
+
+private:
+    string name_;
+    datc_shm_segment_t *segment_ = NULL;
+    uint64_t sequence_ = 0;
+};
+
+#endif // SHM_STATUS_WRITER_HPP
@@ -0,0 +1,100 @@
+/**
+ * @file state_estimator.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Constant-velocity Kalman filters over the polled finger and motor positions, so that the
+ *        state can be read between samples and extrapolated past the bus latency. No ROS or Qt dependency.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef STATE_ESTIMATOR_HPP
+#define STATE_ESTIMATOR_HPP
+
+#include "datc_ctrl.hpp"
+
+#include <cstdint>
+
+using namespace std;
+
+const size_t kEstimatorErrorWindow = 100; // Samples in the prediction error RMS
+
+struct EstimatorNoise {
+    double accel_std = 2000; // Unmodelled acceleration between samples, units / s^2
+    double pos_std   = 1;    // Measurement noise, units (1 = the resolution of the registers)
+};
+
+struct AxisEstimate {
+    double pos = 0;
+    double vel = 0;          // Units / s
+    double cov[4] = {0};     // Row major [pos-pos, pos-vel, vel-pos, vel-vel]
+};
+
+// Position and velocity of one axis from position measurements at irregular times
+class CvKalmanFilter {
+public:
+    void setNoise(const EstimatorNoise &noise) {noise_ = noise;}
+
+    // Until the next measurement
+    void reset() {initialized_ = false;}
+
+    // Keeps the position. After a command or a status change, the velocity of the last motion says
+    // nothing about the next one.
+    void resetVelocity();
+
+    bool isInitialized() const {return initialized_;}
+
+    // Measurement minus its prediction, 0 for the first one after reset()
+    double update(double pos, int64_t time_ns);
+
+    // Extrapolated without changing the filter
+    AxisEstimate predict(int64_t time_ns) const;
+
+private:
+    EstimatorNoise noise_;
+    bool initialized_ = false;
+    int64_t time_ns_  = 0;
+
+    double x_ = 0, v_ = 0;
+    double p00_ = 0, p01_ = 0, p11_ = 0;
+
+    double getVelocityVarReset() const;
+};
+
+class StateEstimator {
+public:
+    void setNoise(const EstimatorNoise &finger, const EstimatorNoise &motor);
+
+    void reset();
+    void resetVelocity();
+
+    // Feed every sample that read the positions, time_ns being when the slave took it
+    void update(const DatcStatus &status, int64_t time_ns);
+
+    bool isReady() const {return finger_.isInitialized();}
+    int64_t getSampleTime() const {return sample_ns_;}
+
+    void predict(int64_t time_ns, AxisEstimate &finger, AxisEstimate &motor) const;
+
+    // RMS of the one-sample-ahead prediction error over the last kEstimatorErrorWindow samples
+    double getFingerErrorRms() const {return finger_error_.getRms();}
+    double getMotorErrorRms() const {return motor_error_.getRms();}
+
+private:
+    struct ErrorWindow {
+        double squares[kEstimatorErrorWindow] = {0};
+        double sum  = 0;
+        size_t next = 0, count = 0;
+
+        void add(double error);
+        void clear();
+        double getRms() const;
+    };
+
+    CvKalmanFilter finger_, motor_;
+    ErrorWindow finger_error_, motor_error_;
+    int64_t sample_ns_ = 0;
+};
+
+#endif // STATE_ESTIMATOR_HPP
@@ -0,0 +1,131 @@
+/**
+ * @file tcp_bridge.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Non-blocking epoll TCP server: DATC commands from any number of clients and a status stream to
+ *        all of them, in a compact binary framing. Linux only, no ROS or Qt dependency.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef TCP_BRIDGE_HPP
+#define TCP_BRIDGE_HPP
+
+#include "datc_ctrl.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Frame: magic (1) | type (1) | payload length (2) | payload, little endian
+const uint8_t kTcpMagic        = 0xDA;
+const size_t  kTcpHeaderSize   = 4;
+const size_t  kTcpPayloadMax   = 64;
+
+// Client -> server
+const uint8_t kTcpTypeCommand  = 0x01; // seq (2) | DATC_COMMAND (2) | value_1 (2) | value_2 (2)
+const uint8_t kTcpTypePing     = 0x02; // seq (2)
+
+// Server -> client
+const uint8_t kTcpTypeResult   = 0x81; // seq (2) | DATC_COMMAND (2) | success (1)
+const uint8_t kTcpTypeStatus   = 0x82; // seq (4) | states | motor_pos | motor_vel | motor_cur | finger_pos | voltage (2 each) | flags (1)
+const uint8_t kTcpTypePong     = 0x83; // seq (2)
+
+// Status flags
+const uint8_t kTcpFlagConnected = 0x01;
+const uint8_t kTcpFlagRecvErr   = 0x02;
+const uint8_t kTcpFlagActive    = 0x04;
+
+class TcpBridge {
+public:
+    // Called on the command thread, one command at a time in arrival order, so a bus transaction never
+    // holds up the event loop. The result goes back to the sender only.
+    using CommandHandler = function<bool(uint16_t code, int16_t value_1, int16_t value_2)>;
+
+    TcpBridge() {}
+    ~TcpBridge();
+
+    TcpBridge(const TcpBridge &) = delete;
+    TcpBridge &operator=(const TcpBridge &) = delete;
+
+    // addr empty or "0.0.0.0" for all interfaces, port 0 for any free port (see getPort())
+    bool start(const string &addr, uint16_t port, CommandHandler handler);
+    void stop();
+
+    bool isRunning() const {return running_;}
+    uint16_t getPort() const {return port_;}
+    size_t getClientCount();
+
+    // Any thread. Encoded once and queued to every client. A client that has not taken the previous
+    // frames (kSendBufferSoft bytes pending) skips this one: status is latest-wins, and a slow reader
+    // never holds up the others or grows its buffer without bound.
+    void broadcastStatus(const DatcStatus &status, uint8_t flags);
+
+    uint64_t getDroppedFrames() const {return dropped_frames_;}
+
+private:
+    struct Client {
+        uint64_t id = 0;    // fds are reused, so results are matched to their client by id as well
+        vector<uint8_t> rx; // Bridge thread only
+        vector<uint8_t> tx; // Under mutex_ from here on
+        size_t pending = 0; // Commands queued or running
+        uint32_t events = 0;
+        bool want_write = false;
+        bool reading    = true; // false while the client is over a limit below; its frames wait in the socket
+    };
+
+    struct Command {
+        int fd;
+        uint64_t client_id;
+        uint16_t seq, code;
+        int16_t value_1, value_2;
+    };
+
+    void run();
+    void runCommands();
+
+    void acceptClients();
+    void closeClient(int fd);
+    bool readClient(int fd);
+    bool processFrames(int fd, Client &client); // mutex_ held, false if the client has to be closed
+    bool flushClient(int fd, Client &client);   // mutex_ held, false if the client has to be closed
+    void updateEvents(int fd, Client &client);  // mutex_ held
+    void flushAll();
+    void resumeClients();
+    void wake();
+
+    CommandHandler handler_;
+    thread thread_;
+    atomic<bool> running_ {false};
+
+    thread command_thread_;
+    mutex command_mutex_; // Taken after mutex_ when both are held
+    condition_variable command_cv_;
+    deque<Command> commands_;
+    uint16_t port_ = 0;
+
+    int listen_fd_ = -1;
+    int epoll_fd_  = -1;
+    int wake_fd_   = -1;
+
+    // Clients and their buffers, shared with broadcastStatus()
+    mutex mutex_;
+    map<int, Client> clients_;
+    vector<uint8_t> last_status_; // Sent to a client right after it connects
+    uint32_t status_seq_     = 0;
+    uint64_t next_client_id_ = 0;
+
+    atomic<uint64_t> dropped_frames_ {0};
+};
+
+#endif // TCP_BRIDGE_HPP
@@ -0,0 +1,270 @@
+/**
+ * @file telemetry_buffer.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Fixed-size sample history with per-column min/max decimation for plotting.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef TELEMETRY_BUFFER_HPP
+#define TELEMETRY_BUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+struct TelemetrySample {
+    double time = 0;      // sec
+    float finger_pos = 0; // %
+    float motor_cur  = 0; // mA
+};
+
+struct TelemetryColumn {
+    float finger_min, finger_max;
+    float cur_min, cur_max;
+    bool valid;
+};
+
+const size_t kTelemetryBuckets = 2048; // Min/max aggregates over the whole history
+
+/**
+ * @brief Ring buffer written by the poll thread and read by the GUI. Memory is allocated at construction
+ *        and by setCapacity(); push() and decimate() never allocate.
+ *
+ *        Next to the samples, push() keeps min/max per bucket of consecutive samples, a fixed number of
+ *        buckets over the capacity. decimate() reads the buckets once a column holds more samples than
+ *        a bucket, so its cost (and the time push() may wait for it) is bounded by the bucket count and
+ *        the column count, not by the poll rate or the window length.
+ */
+class TelemetryBuffer {
+public:
+    explicit TelemetryBuffer(size_t capacity) {
+        allocate(capacity);
+    }
+
+    // Keeps the newest samples that fit. Allocates, so not for the poll thread's every cycle.
+    void setCapacity(size_t capacity) {
+        unique_lock<mutex> lg(mutex_);
+
+        vector<TelemetrySample> kept(size_);
+
+        for (size_t i = 0; i < size_; i++) {
+            kept[i] = at(i);
+        }
+
+        allocate(capacity);
+
+        const size_t first = kept.size() > capacity ? kept.size() - capacity : 0;
+
+        for (size_t i = first; i < kept.size(); i++) {
+            append(kept[i]);
+        }
+
+        count_.fetch_add(1, memory_order_release);
+    }
+
+    void push(const TelemetrySample &sample) {
+        unique_lock<mutex> lg(mutex_);
+
+        append(sample);
+        count_.fetch_add(1, memory_order_release);
+    }
+
+    void clear() {
+        unique_lock<mutex> lg(mutex_);
+        head_  = 0;
+        size_  = 0;
+        total_ = 0;
+        count_.fetch_add(1, memory_order_release);
+    }
+
+    // Total number of modifications, lets readers skip redraws when nothing arrived
+    uint64_t getCount() const {return count_.load(memory_order_acquire);}
+
+    size_t getCapacity() {
+        unique_lock<mutex> lg(mutex_);
+        return samples_.size();
+    }
+
+    bool getLatestTime(double &time) {
+        unique_lock<mutex> lg(mutex_);
+
+        if (size_ == 0) {
+            return false;
+        }
+
+        time = at(size_ - 1).time;
+        return true;
+    }
+
+    /**
+     * @brief Reduce the samples in [t_begin, t_end) to min/max per column. With more samples per column
+     *        than per bucket, the whole buckets inside the window are merged into the column of their
+     *        first sample, so a bucket across a column boundary can move an extreme by one column.
+     */
+    void decimate(double t_begin, double t_end, TelemetryColumn *columns, size_t n_columns) {
+        for (size_t i = 0; i < n_columns; i++) {
+            columns[i].valid = false;
+        }
+
+        if (n_columns == 0 || t_end <= t_begin) {
+            return;
+        }
+
+        const double scale = n_columns / (t_end - t_begin);
+
+        unique_lock<mutex> lg(mutex_);
+
+        const size_t begin = lowerBound(t_begin);
+        const size_t end   = lowerBound(t_end);
+
+        if (end - begin < n_columns * bucket_samples_) {
+            for (size_t i = begin; i < end; i++) {
+                mergeSample(columns, n_columns, t_begin, scale, at(i));
+            }
+
+            return;
+        }
+
+        // Samples are numbered since the last clear; bucket b holds [b * bucket_samples_, (b + 1) * bucket_samples_).
+        // The partial buckets at both ends go sample by sample.
+        const uint64_t first   = total_ - size_;
+        const uint64_t n_begin = first + begin;
+        const uint64_t n_end   = first + end;
+        const uint64_t n_whole = (n_begin + bucket_samples_ - 1) / bucket_samples_ * bucket_samples_;
+        const uint64_t n_head  = n_whole < n_end ? n_whole : n_end;
+        const uint64_t n_floor = n_end / bucket_samples_ * bucket_samples_;
+        const uint64_t n_tail  = n_floor > n_head ? n_floor : n_head;
+
+        for (uint64_t n = n_begin; n < n_head; n++) {
+            mergeSample(columns, n_columns, t_begin, scale, at(n - first));
+        }
+
+        for (uint64_t n = n_head; n < n_tail; n += bucket_samples_) {
+            const TelemetryBucket &bucket = buckets_[(n / bucket_samples_) % buckets_.size()];
+            merge(columns, n_columns, (bucket.time - t_begin) * scale, bucket.finger_min, bucket.finger_max,
+                  bucket.cur_min, bucket.cur_max);
+        }
+
+        for (uint64_t n = n_tail; n < n_end; n++) {
+            mergeSample(columns, n_columns, t_begin, scale, at(n - first));
+        }
+    }
+
+    // Oldest first, for export
+    void copyTo(vector<TelemetrySample> &out) {
+        unique_lock<mutex> lg(mutex_);
+
+        out.resize(size_);
+
+        for (size_t i = 0; i < size_; i++) {
+            out[i] = at(i);
+        }
+    }
+
+private:
+    struct TelemetryBucket {
+        double time; // Of its first sample
+        float finger_min, finger_max;
+        float cur_min, cur_max;
+    };
+
+    // mutex_ held or under construction
+    void allocate(size_t capacity) {
+        capacity = capacity > 0 ? capacity : 1;
+
+        samples_.assign(capacity, TelemetrySample());
+        bucket_samples_ = (capacity + kTelemetryBuckets - 1) / kTelemetryBuckets;
+
+        // One more than the history spans, as the oldest bucket is only partly overwritten
+        buckets_.assign((capacity + bucket_samples_ - 1) / bucket_samples_ + 1, TelemetryBucket());
+
+        head_  = 0;
+        size_  = 0;
+        total_ = 0;
+    }
+
+    void append(const TelemetrySample &s) {
+        samples_[head_] = s;
+        head_ = (head_ + 1) % samples_.size();
+
+        if (size_ < samples_.size()) {
+            size_++;
+        }
+
+        TelemetryBucket &bucket = buckets_[(total_ / bucket_samples_) % buckets_.size()];
+
+        if (total_ % bucket_samples_ == 0) {
+            bucket = {s.time, s.finger_pos, s.finger_pos, s.motor_cur, s.motor_cur};
+        } else {
+            bucket.finger_min = (s.finger_pos < bucket.finger_min) ? s.finger_pos : bucket.finger_min;
+            bucket.finger_max = (s.finger_pos > bucket.finger_max) ? s.finger_pos : bucket.finger_max;
+            bucket.cur_min    = (s.motor_cur  < bucket.cur_min)    ? s.motor_cur  : bucket.cur_min;
+            bucket.cur_max    = (s.motor_cur  > bucket.cur_max)    ? s.motor_cur  : bucket.cur_max;
+        }
+
+        total_++;
+    }
+
+    static void merge(TelemetryColumn *columns, size_t n_columns, double x, float finger_min, float finger_max,
+                      float cur_min, float cur_max) {
+        size_t c = (size_t) x;
+        c = (c < n_columns) ? c : n_columns - 1;
+
+        TelemetryColumn &col = columns[c];
+
+        if (!col.valid) {
+            col = {finger_min, finger_max, cur_min, cur_max, true};
+        } else {
+            col.finger_min = (finger_min < col.finger_min) ? finger_min : col.finger_min;
+            col.finger_max = (finger_max > col.finger_max) ? finger_max : col.finger_max;
+            col.cur_min    = (cur_min    < col.cur_min)    ? cur_min    : col.cur_min;
+            col.cur_max    = (cur_max    > col.cur_max)    ? cur_max    : col.cur_max;
+        }
+    }
+
+    static void mergeSample(TelemetryColumn *columns, size_t n_columns, double t_begin, double scale,
+                            const TelemetrySample &s) {
+        merge(columns, n_columns, (s.time - t_begin) * scale, s.finger_pos, s.finger_pos, s.motor_cur, s.motor_cur);
+    }
+
+    // i-th oldest sample
+    const TelemetrySample &at(size_t i) const {
+        return samples_[(head_ + samples_.size() - size_ + i) % samples_.size()];
+    }
+
+    // First logical index with time >= t (samples are pushed in time order)
+    size_t lowerBound(double t) const {
+        size_t lo = 0, hi = size_;
+
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+
+            if (at(mid).time < t) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+
+        return lo;
+    }
+
+    vector<TelemetrySample> samples_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+
+    vector<TelemetryBucket> buckets_;
+    size_t bucket_samples_ = 1;
+    uint64_t total_ = 0; // Samples pushed since the last clear, numbers the buckets
+
+    atomic<uint64_t> count_ {0};
+    mutex mutex_;
+};
+
+#endif // TELEMETRY_BUFFER_HPP
@@ -0,0 +1,80 @@
+/**
+ * @file telemetry_plot.hpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Finger position / motor current history plot.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef TELEMETRY_PLOT_HPP
+#define TELEMETRY_PLOT_HPP
+
+#include <QWidget>
+#include <QTimer>
+#include <QComboBox>
+#include <QPushButton>
+#include <QLineF>
+
+#include "telemetry_buffer.hpp"
+
+const int kTelemetryRefreshMs = 33; // Redraw at most ~30 Hz whatever the poll rate is
+
+class TelemetryPlot : public QWidget {
+    Q_OBJECT
+
+public:
+    TelemetryPlot(TelemetryBuffer &buffer, QWidget *parent = nullptr);
+
+    void setWindowLength(double sec);
+    void setPaused(bool paused);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private Q_SLOTS:
+    void refresh();
+
+private:
+    QRectF plotArea() const;
+    void updateTimeLabels();
+
+    TelemetryBuffer &buffer_;
+    QTimer *timer_;
+
+    double window_sec_ = 30;
+    bool paused_       = false;
+    double t_end_      = 0;
+    uint64_t count_drawn_ = 0;
+
+    // Per-frame scratch, sized on resize only
+    vector<TelemetryColumn> columns_;
+    vector<QLineF> lines_finger_;
+    vector<QLineF> lines_cur_;
+
+    int cur_range_ = 0; // mA, rounded so the axis labels are rebuilt only when the range changes
+    QString cur_labels_[2];
+    QString time_labels_[5];
+};
+
+class TelemetryWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    TelemetryWidget(TelemetryBuffer &buffer, QWidget *parent = nullptr);
+
+private Q_SLOTS:
+    void exportCsv();
+
+private:
+    TelemetryBuffer &buffer_;
+    TelemetryPlot *plot_;
+
+    QComboBox *comboBox_window_;
+    QPushButton *pushButton_pause_;
+    QPushButton *pushButton_export_;
+};
+
+#endif // TELEMETRY_PLOT_HPP
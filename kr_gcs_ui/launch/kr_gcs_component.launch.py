@@ -0,0 +1,39 @@
+from launch import LaunchDescription
+from launch.actions import DeclareLaunchArgument
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.descriptions import ComposableNode
+
+
+def generate_launch_description():
+    return LaunchDescription([
+        DeclareLaunchArgument('port', default_value='/dev/ttyUSB0'),
+        DeclareLaunchArgument('slave_address', default_value='1'),
+        DeclareLaunchArgument('baudrate', default_value='115200'),
+        # false when a lifecycle manager configures and activates the node
+        DeclareLaunchArgument('auto_activate', default_value='true'),
+
+        # Further nodes that consume grp_state can be added to this container and receive
+        # the messages through intra-process communication
+        ComposableNodeContainer(
+            name='datc_container',
+            namespace='',
+            package='rclcpp_components',
+            executable='component_container_mt',
+            output='screen',
+            composable_node_descriptions=[
+                ComposableNode(
+                    package='kr_gcs_ui',
+                    plugin='DatcRosInterface',
+                    name='DATC_Control_Interface',
+                    parameters=[{
+                        'port': LaunchConfiguration('port'),
+                        'slave_address': LaunchConfiguration('slave_address'),
+                        'baudrate': LaunchConfiguration('baudrate'),
+                        'auto_activate': LaunchConfiguration('auto_activate'),
+                    }],
+                    extra_arguments=[{'use_intra_process_comms': True}],
+                ),
+            ],
+        ),
+    ])
@@ -0,0 +1,26 @@
+from launch import LaunchDescription
+from launch.actions import DeclareLaunchArgument
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import Node
+
+
+def generate_launch_description():
+    return LaunchDescription([
+        DeclareLaunchArgument('port', default_value='/dev/ttyUSB0'),
+        DeclareLaunchArgument('slave_address', default_value='1'),
+        DeclareLaunchArgument('baudrate', default_value='115200'),
+        # false when a lifecycle manager configures and activates the node
+        DeclareLaunchArgument('auto_activate', default_value='true'),
+
+        Node(
+            package='kr_gcs_ui',
+            executable='kr_gcs_node',
+            output='screen',
+            parameters=[{
+                'port': LaunchConfiguration('port'),
+                'slave_address': LaunchConfiguration('slave_address'),
+                'baudrate': LaunchConfiguration('baudrate'),
+                'auto_activate': LaunchConfiguration('auto_activate'),
+            }],
+        ),
+    ])
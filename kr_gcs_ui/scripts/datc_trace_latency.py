@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+"""Per-stage latency breakdown of DATC commands from an LTTng trace (provider kr_gcs_ui).
+
+Every command is followed from where it enters the process to the first reaction of the gripper:
+
+  queue     GUI only: CommandRunner enqueue -> dequeue
+  dispatch  ros2:callback_start -> service_entry, if the trace has the ros2 events
+  pre_bus   callback / job start -> first bus_lock_request (gate, range checks, logging)
+  lock_wait bus_lock_request -> bus_lock_acquired, summed over the command's transactions
+  bus       frame_tx -> frame_rx (RTU request out, response in), summed
+  post      last frame_rx -> service_exit / command_exit
+  total     first event of the command -> exit
+  state     command frame_rx -> first status_sample whose states differ from before the command
+  motion    command frame_rx -> first status_sample with motor_vel != 0, if the motor was standing
+
+The events have to carry the vtid context (ros2 trace adds it, plain lttng: add-context -u -t vtid).
+
+  $ ros2 run kr_gcs_ui datc_trace_latency.py ~/.ros/tracing/datc
+"""
+
+import argparse
+import csv
+import sys
+
+PROVIDER = 'kr_gcs_ui:'
+STAGES = ['queue', 'dispatch', 'pre_bus', 'lock_wait', 'bus', 'post', 'total', 'state', 'motion']
+WRITE_FUNCTIONS = (0x06, 0x10)
+REACTION_WINDOW_NS = 2 * 10**9
+
+
+class Command:
+    def __init__(self, kind, name, t_first):
+        self.kind = kind
+        self.name = name
+        self.t_first = t_first
+        self.t_enqueue = None
+        self.t_callback = None
+        self.t_start = None
+        self.t_end = None
+        self.success = None
+        self.ops = []  # [function, t_lock_request, t_lock_acquired, t_tx, t_rx, success]
+        self.t_write_rx = None
+        self.base_states = None
+        self.base_moving = False
+        self.t_state = None
+        self.t_motion = None
+
+    def stages(self):
+        ms = lambda a, b: (b - a) / 1e6 if a is not None and b is not None else None
+        ops = [op for op in self.ops if op[4] is not None]
+        stages = {
+            'queue': ms(self.t_enqueue, self.t_start),
+            'dispatch': ms(self.t_callback, self.t_start),
+            'pre_bus': ms(self.t_start, self.ops[0][1]) if self.ops else None,
+            'lock_wait': sum(ms(op[1], op[2]) for op in ops) if ops else None,
+            'bus': sum(ms(op[3], op[4]) for op in ops) if ops else None,
+            'post': ms(ops[-1][4], self.t_end) if ops else None,
+            'total': ms(self.t_first, self.t_end),
+            'state': ms(self.t_write_rx, self.t_state),
+            'motion': ms(self.t_write_rx, self.t_motion),
+        }
+        return stages
+
+
+def analyze(events):
+    """events: (timestamp ns, event name, vtid, payload dict), in time order"""
+    pending = {}        # GUI command id -> Command
+    running = {}        # vtid -> Command being executed on that thread
+    callback = {}       # vtid -> last ros2:callback_start
+    watching = []       # Commands waiting for the gripper to react
+    done = []
+
+    last_states = None
+    last_vel = 0
+
+    for ts, name, vtid, fields in events:
+        if name == 'ros2:callback_start':
+            callback[vtid] = ts
+            continue
+        if not name.startswith(PROVIDER):
+            continue
+
+        event = name[len(PROVIDER):]
+        cmd = running.get(vtid)
+
+        if event == 'service_entry':
+            t_callback = callback.pop(vtid, None)
+            cmd = Command('service', fields['name'], ts if t_callback is None else t_callback)
+            cmd.t_callback = t_callback
+            cmd.t_start = ts
+            running[vtid] = cmd
+        elif event == 'command_enqueue':
+            cmd = Command('gui', fields['name'], ts)
+            cmd.t_enqueue = ts
+            pending[fields['id']] = cmd
+        elif event == 'command_dequeue':
+            cmd = pending.pop(fields['id'], None)
+            if cmd is not None:
+                cmd.t_start = ts
+                running[vtid] = cmd
+        elif event in ('service_exit', 'command_exit'):
+            if cmd is not None:
+                cmd.t_end = ts
+                cmd.success = bool(fields['success'])
+                del running[vtid]
+                done.append(cmd)
+        elif event == 'bus_lock_request' and cmd is not None:
+            cmd.ops.append([fields['function'], ts, None, None, None, None])
+        elif event == 'bus_lock_acquired' and cmd is not None and cmd.ops:
+            cmd.ops[-1][2] = ts
+        elif event == 'frame_tx' and cmd is not None and cmd.ops:
+            cmd.ops[-1][3] = ts
+        elif event == 'frame_rx' and cmd is not None and cmd.ops:
+            op = cmd.ops[-1]
+            op[4] = ts
+            op[5] = bool(fields['success'])
+            if op[0] in WRITE_FUNCTIONS and op[5] and cmd.t_write_rx is None:
+                # A newer command makes any later reaction ambiguous
+                watching = []
+                cmd.t_write_rx = ts
+                cmd.base_states = last_states
+                cmd.base_moving = last_vel != 0
+                watching.append(cmd)
+        elif event == 'status_sample':
+            states = fields['states']
+            vel = fields['motor_vel']
+            for w in list(watching):
+                if ts - w.t_write_rx > REACTION_WINDOW_NS:
+                    watching.remove(w)
+                    continue
+                if w.t_state is None and w.base_states is not None and states != w.base_states:
+                    w.t_state = ts
+                if w.t_motion is None and not w.base_moving and vel != 0:
+                    w.t_motion = ts
+                if w.t_state is not None and (w.t_motion is not None or w.base_moving):
+                    watching.remove(w)
+            last_states = states
+            last_vel = vel
+
+    return done
+
+
+def read_trace(path):
+    try:
+        import bt2
+    except ImportError:
+        sys.exit('babeltrace2 python bindings are required (apt install python3-bt2)')
+
+    for msg in bt2.TraceCollectionMessageIterator(path):
+        if type(msg) is not bt2._EventMessageConst:
+            continue
+
+        event = msg.event
+        ctx = event.common_context_field
+        vtid = int(ctx['vtid']) if ctx is not None and 'vtid' in ctx else None
+        fields = {}
+
+        for key, value in event.payload_field.items():
+            fields[str(key)] = str(value) if isinstance(value, bt2._StringFieldConst) else int(value)
+
+        yield msg.default_clock_snapshot.ns_from_origin, event.name, vtid, fields
+
+
+def percentile(values, p):
+    values = sorted(values)
+    return values[min(len(values) - 1, int(round(p / 100 * (len(values) - 1))))]
+
+
+def print_summary(commands):
+    names = sorted(set(cmd.name for cmd in commands))
+
+    print('%-20s %-9s %6s %9s %9s %9s' % ('command', 'stage', 'n', 'p50 ms', 'p90 ms', 'max ms'))
+
+    for name in names:
+        group = [cmd.stages() for cmd in commands if cmd.name == name]
+
+        for stage in STAGES:
+            values = [s[stage] for s in group if s[stage] is not None]
+            if values:
+                print('%-20s %-9s %6d %9.3f %9.3f %9.3f' % (name, stage, len(values), percentile(values, 50),
+                                                         percentile(values, 90), max(values)))
+        print()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('trace', help='trace directory (CTF)')
+    parser.add_argument('--csv', help='also write one row per command to this file')
+    args = parser.parse_args()
+
+    commands = analyze(read_trace(args.trace))
+
+    if not commands:
+        sys.exit('No kr_gcs_ui command events in %s (built with -DKR_GCS_TRACING=ON?)' % args.trace)
+
+    print_summary(commands)
+
+    if args.csv:
+        with open(args.csv, 'w', newline='') as f:
+            writer = csv.writer(f)
+            writer.writerow(['start_ns', 'command', 'kind', 'success'] + STAGES)
+            for cmd in commands:
+                stages = cmd.stages()
+                writer.writerow([cmd.t_first, cmd.name, cmd.kind, int(bool(cmd.success))] +
+                                ['' if stages[s] is None else '%.3f' % stages[s] for s in STAGES])
+
+
+if __name__ == '__main__':
+    main()
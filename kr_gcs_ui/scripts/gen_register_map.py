@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+"""Compiles config/datc_register_map.yaml into datc_register_map_table.hpp (constexpr tables).
+
+  $ gen_register_map.py <register_map.yaml> <output.hpp>
+"""
+
+import sys
+
+import yaml
+
+REGISTERS = ['motor_pos', 'motor_cur', 'motor_vel', 'finger_pos', 'voltage']
+MINIMAL_REGISTERS = ['motor_pos', 'motor_cur', 'motor_vel', 'finger_pos']
+
+# Same order as STATUS_FLAG in register_map.hpp
+BITS = ['enable', 'initialize', 'motor_pos_ctrl', 'motor_vel_ctrl', 'motor_cur_ctrl', 'grp_open', 'grp_close', 'fault']
+
+MAX_READ_REGISTERS = 125
+
+
+class MapError(Exception):
+    pass
+
+
+def check_int(where, value, low, high):
+    if not isinstance(value, int) or isinstance(value, bool) or not low <= value <= high:
+        raise MapError('%s must be an integer within [%d, %d], not %r' % (where, low, high, value))
+    return value
+
+
+def check_keys(where, mapping, allowed):
+    if not isinstance(mapping, dict):
+        raise MapError('%s must be a mapping' % where)
+    unknown = set(mapping) - set(allowed)
+    if unknown:
+        raise MapError('%s: unknown key(s) %s' % (where, ', '.join(sorted(unknown))))
+
+
+def parse_variant(name, variant):
+    where = 'variants.' + name
+    check_keys(where, variant, ['versions', 'command', 'status', 'bits'])
+
+    versions = variant.get('versions')
+    if not isinstance(versions, list) or len(versions) != 2:
+        raise MapError('%s.versions must be [min, max]' % where)
+    version_min = check_int(where + '.versions[0]', versions[0], 0, 0xFFFF)
+    version_max = check_int(where + '.versions[1]', versions[1], version_min, 0xFFFF)
+
+    status = variant.get('status', {})
+    check_keys(where + '.status', status, ['address', 'count', 'minimal_count', 'registers'])
+
+    count = check_int(where + '.status.count', status.get('count'), 1, MAX_READ_REGISTERS)
+    minimal_count = check_int(where + '.status.minimal_count', status.get('minimal_count'), 1, count)
+    address = check_int(where + '.status.address', status.get('address'), 0, 0xFFFF - count + 1)
+
+    registers = status.get('registers', {})
+    check_keys(where + '.status.registers', registers, REGISTERS)
+
+    offsets = {}
+    for reg in REGISTERS:
+        if reg in registers:
+            offsets[reg] = check_int('%s.status.registers.%s' % (where, reg), registers[reg], 1, count - 1)
+            if reg in MINIMAL_REGISTERS and offsets[reg] >= minimal_count:
+                raise MapError('%s.status.registers.%s is outside minimal_count' % (where, reg))
+        else:
+            offsets[reg] = -1
+
+    bits = variant.get('bits', {})
+    check_keys(where + '.bits', bits, BITS)
+
+    bit_numbers = []
+    for flag in BITS:
+        bit_numbers.append(check_int('%s.bits.%s' % (where, flag), bits[flag], 0, 15) if flag in bits else -1)
+
+    used = [b for b in bit_numbers if b >= 0]
+    if len(used) != len(set(used)):
+        raise MapError('%s.bits: a bit is used by more than one flag' % where)
+
+    return {
+        'name': name,
+        'version_min': version_min,
+        'version_max': version_max,
+        'command': check_int(where + '.command', variant.get('command'), 0, 0xFFFF),
+        'address': address,
+        'count': count,
+        'minimal_count': minimal_count,
+        'offsets': offsets,
+        'bits': bit_numbers,
+    }
+
+
+def parse(doc):
+    check_keys('register map', doc, ['version_register', 'default_variant', 'variants'])
+
+    version_register = doc.get('version_register')
+    if version_register is not None:
+        check_int('version_register', version_register, 0, 0xFFFF)
+
+    variants = doc.get('variants')
+    if not isinstance(variants, dict) or not variants:
+        raise MapError('variants must name at least one variant')
+
+    maps = [parse_variant(str(name), variant) for name, variant in variants.items()]
+    names = [m['name'] for m in maps]
+
+    default = doc.get('default_variant')
+    if default not in names:
+        raise MapError('default_variant %r is not one of the variants' % default)
+
+    return -1 if version_register is None else version_register, maps, names.index(default)
+
+
+def render(source, version_register, maps, default):
+    lines = [
+        '// Generated by scripts/gen_register_map.py from %s. Do not edit.' % source,
+        '#ifndef DATC_REGISTER_MAP_TABLE_HPP',
+        '#define DATC_REGISTER_MAP_TABLE_HPP',
+        '',
+        'constexpr int32_t kVersionRegAddr = %d;' % version_register,
+        '',
+        'constexpr RegisterMap kRegisterMaps[] = {',
+    ]
+
+    for m in maps:
+        o = m['offsets']
+        lines.append('    {"%s", %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, {%s}},' % (
+            m['name'], m['version_min'], m['version_max'], m['command'], m['address'], m['count'],
+            m['minimal_count'], o['motor_pos'], o['motor_cur'], o['motor_vel'], o['finger_pos'], o['voltage'],
+            ', '.join(str(b) for b in m['bits'])))
+
+    lines += [
+        '};',
+        '',
+        'constexpr size_t kRegisterMapDefault = %d;' % default,
+        '',
+        '#endif // DATC_REGISTER_MAP_TABLE_HPP',
+        '',
+    ]
+
+    return '\n'.join(lines)
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+
+    source, output = sys.argv[1], sys.argv[2]
+
+    try:
+        with open(source) as f:
+            version_register, maps, default = parse(yaml.safe_load(f))
+    except (OSError, yaml.YAMLError, MapError) as e:
+        sys.exit('%s: %s' % (source, e))
+
+    text = render(source.split('/')[-1], version_register, maps, default)
+
+    with open(output, 'w') as f:
+        f.write(text)
+
+
+if __name__ == '__main__':
+    main()
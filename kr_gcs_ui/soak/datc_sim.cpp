@@ -0,0 +1,536 @@
+/**
+ * @file datc_sim.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Simulated DATC slave on a pseudo terminal: answers the Modbus RTU requests of the interface
+ *        (FC03/06/16/23) from a register file laid out as in the register map, and moves the finger
+ *        on the commands. Replies are paced at the baud rate, so bus timing is roughly that of the
+ *        real gripper. No ROS dependency.
+ *
+ *        $ datc_sim [--link /tmp/datc_sim] [--slave 1] [--variant datc_v1] [--baudrate 115200]
+ *                   [--delay-us 500] [--stroke-ms 1000] [--object <0 ~ 1000>] [--drop-rate 0]
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "datc_ctrl.hpp"
+#include "modbus_rtu_codec.hpp"
+#include "register_map.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <getopt.h>
+#include <poll.h>
+#include <random>
+#include <string>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace modbus_rtu;
+
+const int kSimRegisterCount = 256;
+const int kFrameGapMs       = 50;   // Bytes of a partial frame older than this are dropped
+
+const int kFingerOpen   = 1000;     // Finger position of grp_state, 0: closed
+const int kCurrentIdle  = 40;       // mA
+const int kCurrentMove  = 300;
+const int kCurrentGrasp = 900;
+const int kVoltage      = 240;
+
+static volatile sig_atomic_t g_stop = 0;
+
+static void onSignal(int) {
+    g_stop = 1;
+}
+
+static int64_t getMonotonicNs() {
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec * 1000000000L + time.tv_nsec;
+}
+
+struct SimOptions {
+    string link       = "/tmp/datc_sim";
+    int slave         = 1;
+    string variant;                 // Empty: the default variant
+    int baudrate      = 115200;     // 0: no pacing
+    int delay_us      = 500;        // Turnaround of the slave, on top of the wire time
+    int stroke_ms     = 1000;       // Full open <-> closed
+    int object        = -1;         // Finger position where closing is blocked, -1: nothing to grasp
+    double drop_rate  = 0;          // Requests left unanswered, to exercise the timeouts of the master
+};
+
+class DatcSim {
+public:
+    DatcSim(const RegisterMap &map, const SimOptions &options) : map_(map), options_(options) {
+        memset(regs_, 0, sizeof(regs_));
+
+        if (kVersionRegAddr >= 0 && kVersionRegAddr < kSimRegisterCount) {
+            regs_[kVersionRegAddr] = map.version_min;
+        }
+
+        slave_ = options.slave;
+        time_ns_ = getMonotonicNs();
+        updateRegisters();
+    }
+
+    int getSlave() const {return slave_;}
+
+    // Response to one request in out, 0 bytes if there is none (broadcast, another slave or dropped)
+    size_t handle(const FrameView &frame, uint8_t *out, size_t cap) {
+        if (frame.slave != slave_) {
+            return 0;
+        }
+
+        advance();
+
+        const FUNCTION_CODE function = (FUNCTION_CODE) frame.function;
+
+        switch (function) {
+            case FUNCTION_CODE::READ_HOLDING_REGISTERS:
+                if (!inRange(frame.address, frame.quantity)) {
+                    return encodeException(out, cap, slave_, frame.function, 0x02);
+                }
+
+                return encodeRegistersResponse(out, cap, slave_, function, &regs_[frame.address], frame.quantity);
+
+            case FUNCTION_CODE::WRITE_SINGLE_REGISTER:
+                if (!inRange(frame.address, 1)) {
+                    return encodeException(out, cap, slave_, frame.function, 0x02);
+                }
+
+                regs_[frame.address] = frame.quantity;
+                onWrite(frame.address, 1);
+
+                return encodeWriteResponse(out, cap, frame.slave, function, frame.address, frame.quantity);
+
+            case FUNCTION_CODE::WRITE_MULTIPLE_REGISTERS:
+                if (!inRange(frame.address, frame.quantity)) {
+                    return encodeException(out, cap, slave_, frame.function, 0x02);
+                }
+
+                for (uint16_t i = 0; i < frame.quantity; i++) {
+                    regs_[frame.address + i] = frame.registerAt(i);
+                }
+
+                onWrite(frame.address, frame.quantity);
+
+                return encodeWriteResponse(out, cap, frame.slave, function, frame.address, frame.quantity);
+
+            case FUNCTION_CODE::READ_WRITE_MULTIPLE_REGISTERS:
+                if (!inRange(frame.write_address, frame.write_quantity) || !inRange(frame.address, frame.quantity)) {
+                    return encodeException(out, cap, slave_, frame.function, 0x02);
+                }
+
+                // The write goes first
+                for (uint16_t i = 0; i < frame.write_quantity; i++) {
+                    regs_[frame.write_address + i] = frame.registerAt(i);
+                }
+
+                onWrite(frame.write_address, frame.write_quantity);
+
+                return encodeRegistersResponse(out, cap, slave_, function, &regs_[frame.address], frame.quantity);
+        }
+
+        return encodeException(out, cap, slave_, frame.function, 0x01);
+    }
+
+private:
+    const RegisterMap &map_;
+    SimOptions options_;
+
+    uint16_t regs_[kSimRegisterCount];
+    int slave_;
+
+    int64_t time_ns_;
+
+    bool enabled_     = false;
+    bool initialized_ = false;
+    bool open_        = false;
+    bool close_       = false;
+    bool fault_       = false;
+    bool grasping_    = false;
+
+    DATC_COMMAND mode_ = DATC_COMMAND::MOTOR_STOP;
+    double finger_     = kFingerOpen;
+    double target_     = kFingerOpen;
+    double velocity_   = 0; // Finger units / s, last step
+    double motor_deg_  = 0;
+
+    static bool inRange(int addr, int nb) {
+        return nb >= 1 && addr >= 0 && addr + nb <= kSimRegisterCount;
+    }
+
+    void onWrite(int addr, int nb) {
+        if (map_.command_addr < addr || map_.command_addr >= addr + nb) {
+            return;
+        }
+
+        const DATC_COMMAND cmd = (DATC_COMMAND) regs_[map_.command_addr];
+        const uint16_t value_1 = regs_[map_.command_addr + 1];
+
+        switch (cmd) {
+            case DATC_COMMAND::MOTOR_ENABLE:
+                enabled_ = true;
+                fault_   = false;
+                break;
+
+            case DATC_COMMAND::MOTOR_DISABLE:
+                enabled_ = false;
+                stop();
+                break;
+
+            case DATC_COMMAND::MOTOR_STOP:
+                stop();
+                break;
+
+            case DATC_COMMAND::GRIPPER_INITIALIZE:
+                enabled_     = true;
+                initialized_ = true;
+                moveTo(kFingerOpen, cmd);
+                break;
+
+            case DATC_COMMAND::GRIPPER_OPEN:
+                moveTo(kFingerOpen, cmd);
+                break;
+
+            case DATC_COMMAND::GRIPPER_CLOSE:
+                moveTo(0, cmd);
+                break;
+
+            case DATC_COMMAND::SET_FINGER_POSITION:
+                moveTo((double) std::min(value_1, kFingerPosMax) * kFingerOpen / kFingerPosMax, cmd);
+                break;
+
+            case DATC_COMMAND::MOTOR_POSITION_CONTROL:
+            case DATC_COMMAND::MOTOR_VELOCITY_CONTROL:
+            case DATC_COMMAND::MOTOR_CURRENT_CONTROL:
+                mode_ = cmd;
+                break;
+
+            case DATC_COMMAND::CHANGE_MODBUS_ADDRESS:
+                if (value_1 >= 1 && value_1 <= 247) {
+                    printf("datc_sim: slave address %d -> %d\n", slave_, value_1);
+                    slave_ = value_1;
+                }
+                break;
+
+            default:
+                // Vacuum, impedance, torque and speed: acknowledged, no effect on the simulated finger
+                break;
+        }
+
+        updateRegisters();
+    }
+
+    void moveTo(double target, DATC_COMMAND cmd) {
+        if (!enabled_) {
+            return;
+        }
+
+        target_   = target;
+        mode_     = cmd;
+        open_     = false;
+        close_    = false;
+        grasping_ = false;
+    }
+
+    void stop() {
+        target_   = finger_;
+        velocity_ = 0;
+        mode_     = DATC_COMMAND::MOTOR_STOP;
+    }
+
+    // Finger motion up to now, at constant speed, blocked by the object when closing
+    void advance() {
+        const int64_t time_ns = getMonotonicNs();
+        const double dt = (time_ns - time_ns_) * 1e-9;
+        time_ns_ = time_ns;
+
+        const double speed = (double) kFingerOpen / std::max(options_.stroke_ms, 1) * 1000;
+        const double limit = (options_.object >= 0 && target_ < options_.object) ? options_.object : target_;
+        const double prev  = finger_;
+
+        if (finger_ < target_) {
+            finger_ = std::min(finger_ + speed * dt, target_);
+        } else if (finger_ > limit) {
+            finger_ = std::max(finger_ - speed * dt, limit);
+        }
+
+        velocity_   = dt > 0 ? (finger_ - prev) / dt : 0;
+        motor_deg_ += (finger_ - prev) * 0.36;
+
+        if (finger_ == target_ || (finger_ == limit && limit > target_)) {
+            grasping_ = limit > target_ && finger_ == limit;
+            open_     = mode_ == DATC_COMMAND::GRIPPER_OPEN && finger_ >= kFingerOpen;
+            close_    = mode_ == DATC_COMMAND::GRIPPER_CLOSE && (finger_ <= 0 || grasping_);
+        }
+
+        updateRegisters();
+    }
+
+    void setBit(uint16_t &word, STATUS_FLAG flag, bool value) {
+        const int8_t bit = map_.getBit(flag);
+
+        if (bit >= 0 && value) {
+            word |= 1 << bit;
+        }
+    }
+
+    void updateRegisters() {
+        uint16_t *status = &regs_[map_.status_addr];
+        uint16_t word = 0;
+
+        setBit(word, STATUS_FLAG::ENABLE, enabled_);
+        setBit(word, STATUS_FLAG::INITIALIZE, initialized_);
+        setBit(word, STATUS_FLAG::MOTOR_POS_CTRL, mode_ == DATC_COMMAND::MOTOR_POSITION_CONTROL);
+        setBit(word, STATUS_FLAG::MOTOR_VEL_CTRL, mode_ == DATC_COMMAND::MOTOR_VELOCITY_CONTROL);
+        setBit(word, STATUS_FLAG::MOTOR_CUR_CTRL, mode_ == DATC_COMMAND::MOTOR_CURRENT_CONTROL);
+        setBit(word, STATUS_FLAG::GRP_OPEN, open_);
+        setBit(word, STATUS_FLAG::GRP_CLOSE, close_);
+        setBit(word, STATUS_FLAG::FAULT, fault_);
+
+        status[0] = word;
+
+        const int current = grasping_ ? kCurrentGrasp : (velocity_ != 0 ? kCurrentMove : kCurrentIdle);
+
+        if (map_.motor_pos >= 0)  status[map_.motor_pos]  = (uint16_t) (int16_t) std::lround(motor_deg_);
+        if (map_.motor_cur >= 0)  status[map_.motor_cur]  = (uint16_t) (int16_t) current;
+        if (map_.motor_vel >= 0)  status[map_.motor_vel]  = (uint16_t) (int16_t) std::lround(velocity_ * 0.06);
+        if (map_.finger_pos >= 0) status[map_.finger_pos] = (uint16_t) std::lround(finger_);
+        if (map_.voltage >= 0)    status[map_.voltage]    = kVoltage;
+    }
+};
+
+static bool parseOptions(int argc, char *argv[], SimOptions &options) {
+    static const option long_options[] = {
+        {"link",      required_argument, NULL, 'l'},
+        {"slave",     required_argument, NULL, 's'},
+        {"variant",   required_argument, NULL, 'v'},
+        {"baudrate",  required_argument, NULL, 'b'},
+        {"delay-us",  required_argument, NULL, 'd'},
+        {"stroke-ms", required_argument, NULL, 't'},
+        {"object",    required_argument, NULL, 'o'},
+        {"drop-rate", required_argument, NULL, 'r'},
+        {"help",      no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, "l:s:v:b:d:t:o:r:h", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'l': options.link      = optarg;       break;
+            case 's': options.slave     = atoi(optarg); break;
+            case 'v': options.variant   = optarg;       break;
+            case 'b': options.baudrate  = atoi(optarg); break;
+            case 'd': options.delay_us  = atoi(optarg); break;
+            case 't': options.stroke_ms = atoi(optarg); break;
+            case 'o': options.object    = atoi(optarg); break;
+            case 'r': options.drop_rate = atof(optarg); break;
+            default:
+                return false;
+        }
+    }
+
+    return options.slave >= 1 && options.slave <= 247 && options.baudrate >= 0 && options.delay_us >= 0 &&
+           options.object <= kFingerOpen && options.drop_rate >= 0 && options.drop_rate <= 1;
+}
+
+// Master side of a new pty. The slave side is kept open as well: without it, reads on the master fail
+// with EIO whenever the interface has closed the port (e.g. between reconnects).
+static int openPty(string &slave_path, int &slave_fd) {
+    const int master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (master_fd < 0 || grantpt(master_fd) != 0 || unlockpt(master_fd) != 0) {
+        perror("datc_sim: pty");
+        return -1;
+    }
+
+    slave_path = ptsname(master_fd);
+    slave_fd   = open(slave_path.c_str(), O_RDWR | O_NOCTTY);
+
+    termios tio;
+
+    if (slave_fd < 0 || tcgetattr(slave_fd, &tio) != 0) {
+        perror("datc_sim: pty slave");
+        close(master_fd);
+        return -1;
+    }
+
+    // Raw from the start, so that nothing is echoed before libmodbus sets it up
+    cfmakeraw(&tio);
+    tcsetattr(slave_fd, TCSANOW, &tio);
+
+    return master_fd;
+}
+
+static bool writeAll(int fd, const uint8_t *buf, size_t len) {
+    while (len > 0) {
+        const ssize_t n = write(fd, buf, len);
+
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return false;
+        }
+
+        buf += n;
+        len -= n;
+    }
+
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    SimOptions options;
+
+    if (!parseOptions(argc, argv, options)) {
+        fprintf(stderr, "Usage: datc_sim [--link PATH] [--slave 1 ~ 247] [--variant NAME] [--baudrate BPS (0: no pacing)]\n"
+                        "                [--delay-us US] [--stroke-ms MS] [--object 0 ~ 1000] [--drop-rate 0 ~ 1]\n");
+        return 2;
+    }
+
+    const RegisterMap *map = &kRegisterMaps[kRegisterMapDefault];
+
+    if (!options.variant.empty()) {
+        map = NULL;
+
+        for (const auto &variant : kRegisterMaps) {
+            if (options.variant == variant.name) {
+                map = &variant;
+            }
+        }
+
+        if (map == NULL) {
+            fprintf(stderr, "datc_sim: unknown register map variant %s\n", options.variant.c_str());
+            return 2;
+        }
+    }
+
+    string pty_path;
+    int pty_slave_fd = -1;
+    const int fd = openPty(pty_path, pty_slave_fd);
+
+    if (fd < 0) {
+        return 1;
+    }
+
+    unlink(options.link.c_str());
+
+    if (symlink(pty_path.c_str(), options.link.c_str()) != 0) {
+        fprintf(stderr, "datc_sim: cannot link %s: %s\n", options.link.c_str(), strerror(errno));
+        return 1;
+    }
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    printf("datc_sim: %s -> %s, slave #%d, %s, %d bps\n", options.link.c_str(), pty_path.c_str(), options.slave,
+           map->name, options.baudrate);
+    fflush(stdout);
+
+    DatcSim sim(*map, options);
+
+    mt19937 rng(1);
+    uniform_real_distribution<double> uniform(0, 1);
+
+    uint8_t rx[kMaxAduLength * 2];
+    size_t rx_len = 0;
+    int64_t rx_time_ns = 0;
+
+    uint8_t tx[kMaxAduLength];
+    uint64_t requests = 0, dropped = 0, bad_frames = 0;
+
+    while (!g_stop) {
+        pollfd pfd = {fd, POLLIN, 0};
+        const int ready = ::poll(&pfd, 1, 100);
+
+        if (ready < 0 && errno != EINTR) {
+            perror("datc_sim: poll");
+            break;
+        } else if (ready <= 0) {
+            continue;
+        }
+
+        // A partial frame followed by silence is noise or a master that gave up on it
+        if (rx_len > 0 && getMonotonicNs() - rx_time_ns > kFrameGapMs * 1000000L) {
+            rx_len = 0;
+        }
+
+        const ssize_t n = read(fd, rx + rx_len, sizeof(rx) - rx_len);
+
+        if (n <= 0) {
+            if (n < 0 && errno != EINTR && errno != EAGAIN) {
+                perror("datc_sim: read");
+                break;
+            }
+
+            continue;
+        }
+
+        rx_len    += n;
+        rx_time_ns = getMonotonicNs();
+
+        while (rx_len > 0) {
+            FrameView frame;
+            const PARSE_RESULT result = parseRequest(rx, rx_len, frame);
+
+            if (result == PARSE_RESULT::INCOMPLETE) {
+                break;
+            }
+
+            size_t consumed = rx_len; // Resync on anything unparseable
+
+            if (result == PARSE_RESULT::OK) {
+                consumed = frame.length;
+                requests++;
+
+                if (options.drop_rate > 0 && uniform(rng) < options.drop_rate) {
+                    dropped++;
+                } else {
+                    const size_t tx_len = sim.handle(frame, tx, sizeof(tx));
+
+                    if (tx_len > 0) {
+                        // Wire time of the response (10 bits per byte) plus the turnaround
+                        const int64_t wire_us = options.baudrate > 0 ? (int64_t) tx_len * 10 * 1000000 / options.baudrate : 0;
+                        usleep((useconds_t) (options.delay_us + wire_us));
+
+                        if (!writeAll(fd, tx, tx_len)) {
+                            perror("datc_sim: write");
+                        }
+                    }
+                }
+            } else if (result == PARSE_RESULT::UNSUPPORTED_FUNCTION && rx[0] == sim.getSlave()) {
+                const size_t tx_len = encodeException(tx, sizeof(tx), rx[0], rx[1], 0x01);
+                writeAll(fd, tx, tx_len);
+                bad_frames++;
+            } else {
+                bad_frames++;
+            }
+
+            memmove(rx, rx + consumed, rx_len - consumed);
+            rx_len -= consumed;
+        }
+    }
+
+    printf("datc_sim: %lu requests, %lu dropped, %lu bad frames\n", (unsigned long) requests, (unsigned long) dropped,
+           (unsigned long) bad_frames);
+
+    unlink(options.link.c_str());
+    close(pty_slave_fd);
+    close(fd);
+
+    return 0;
+}
@@ -0,0 +1,1132 @@
+/**
+ * @file datc_soak.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Soak / load test of the ROS service surface: starts datc_sim and kr_gcs_node on it, then
+ *        hammers the services from many client nodes at once (the mix parameter) while subscriber
+ *        nodes follow grp_state. Reports throughput, latency percentiles, lost grp_state sequence
+ *        numbers and the RSS of the node over the run, and exits with 1 when a limit (fail.*) or the
+ *        baseline is exceeded, or when a child process dies or exits with an error (e.g. a
+ *        ThreadSanitizer report).
+ *
+ *        $ ros2 run kr_gcs_ui datc_soak --ros-args -p duration_s:=14400 -p mix:="['set_finger_pos:8', 'grp_open:4', 'grp_close:4']"
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "datc_ctrl.hpp"
+#include "process_stats.hpp"
+#include <rclcpp/rclcpp.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sys/prctl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <thread>
+#include <vector>
+
+#include "grp_control_msg/msg/gripper_msg.hpp"
+#include "grp_control_msg/srv/get_health.hpp"
+#include "grp_control_msg/srv/single_int.hpp"
+#include "grp_control_msg/srv/void.hpp"
+
+using GripperMsg = grp_control_msg::msg::GripperMsg;
+using GetHealth  = grp_control_msg::srv::GetHealth;
+using SingleInt  = grp_control_msg::srv::SingleInt;
+using Void       = grp_control_msg::srv::Void;
+
+const int kLatencySubBits       = 4; // 16 buckets per power of two: percentiles within 6.25 %
+const size_t kLatencyBuckets    = (65 - kLatencySubBits) << kLatencySubBits;
+
+const double kLinkWaitS         = 5;
+const double kChildStopTimeoutS = 20;  // ThreadSanitizer builds take a while to shut down
+
+typedef chrono::steady_clock SoakClock;
+
+// Latency in microseconds, log-linear buckets: fixed memory, mergeable, cheap enough to add on every call
+class LatencyHistogram {
+public:
+    LatencyHistogram() : buckets_(kLatencyBuckets, 0) {}
+
+    void add(uint64_t us) {
+        buckets_[getBucket(us)]++;
+        count_++;
+        max_us_ = std::max(max_us_, us);
+    }
+
+    void merge(const LatencyHistogram &other) {
+        for (size_t i = 0; i < kLatencyBuckets; i++) {
+            buckets_[i] += other.buckets_[i];
+        }
+
+        count_ += other.count_;
+        max_us_ = std::max(max_us_, other.max_us_);
+    }
+
+    uint64_t getCount() const {return count_;}
+    double getMaxMs() const {return max_us_ * 1e-3;}
+
+    // Upper bound of the bucket holding the quantile, never above the maximum seen
+    double getQuantileMs(double q) const {
+        if (count_ == 0) {
+            return 0;
+        }
+
+        const uint64_t target = std::max<uint64_t>(1, (uint64_t) ceil(q * count_));
+        uint64_t below = 0;
+
+        for (size_t i = 0; i < kLatencyBuckets; i++) {
+            below += buckets_[i];
+
+            if (below >= target) {
+                return std::min(getUpperBound(i), max_us_) * 1e-3;
+            }
+        }
+
+        return getMaxMs();
+    }
+
+private:
+    vector<uint64_t> buckets_;
+    uint64_t count_  = 0;
+    uint64_t max_us_ = 0;
+
+    static size_t getBucket(uint64_t us) {
+        if (us < (1u << kLatencySubBits)) {
+            return us;
+        }
+
+        const int shift = 63 - __builtin_clzll(us) - kLatencySubBits;
+
+        return ((size_t) (shift + 1) << kLatencySubBits) + ((us >> shift) & ((1u << kLatencySubBits) - 1));
+    }
+
+    static uint64_t getUpperBound(size_t bucket) {
+        if (bucket < (1u << kLatencySubBits)) {
+            return bucket;
+        }
+
+        const int shift    = (int) (bucket >> kLatencySubBits) - 1;
+        const uint64_t sub = bucket & ((1u << kLatencySubBits) - 1);
+
+        return (((1u << kLatencySubBits) + sub) << shift) + (1ull << shift) - 1;
+    }
+};
+
+struct CallStats {
+    uint64_t calls    = 0; // Answered
+    uint64_t failed   = 0; // Answered with successed = false
+    uint64_t timeouts = 0; // Not answered within timeout_s
+    LatencyHistogram latency;
+
+    void merge(const CallStats &other) {
+        calls    += other.calls;
+        failed   += other.failed;
+        timeouts += other.timeouts;
+        latency.merge(other.latency);
+    }
+};
+
+// One client node calling one service back to back (or at a rate) from its own thread
+class SoakClient {
+public:
+    SoakClient(const string &service, uint32_t seed) : service_(service), rng_(seed) {}
+    virtual ~SoakClient() {}
+
+    const string &getService() const {return service_;}
+
+    virtual bool waitForService(double timeout_s) = 0;
+
+    // False on a timeout. success: what the response said.
+    bool callOnce(double timeout_s, bool &success) {
+        return call(chrono::duration<double>(timeout_s), success);
+    }
+
+    void run(double period_s, double timeout_s, const atomic<bool> &stop) {
+        const auto period  = chrono::duration_cast<SoakClock::duration>(chrono::duration<double>(period_s));
+        const auto timeout = chrono::duration<double>(timeout_s);
+        auto time_next = SoakClock::now();
+
+        while (!stop) {
+            const auto time_start = SoakClock::now();
+            bool success = false;
+            const bool answered = call(timeout, success);
+            const uint64_t us = chrono::duration_cast<chrono::microseconds>(SoakClock::now() - time_start).count();
+
+            {
+                unique_lock<mutex> lg(mutex_);
+
+                for (CallStats *stats : {&interval_, &total_}) {
+                    if (!answered) {
+                        stats->timeouts++;
+                    } else {
+                        stats->calls++;
+                        stats->failed += success ? 0 : 1;
+                        stats->latency.add(us);
+                    }
+                }
+            }
+
+            // A client that fell behind does not try to catch up
+            if (period_s > 0) {
+                time_next = std::max(time_next + period, SoakClock::now() - period);
+                this_thread::sleep_until(time_next);
+            }
+        }
+    }
+
+    CallStats takeInterval() {
+        unique_lock<mutex> lg(mutex_);
+        CallStats stats = interval_;
+        interval_ = CallStats();
+        return stats;
+    }
+
+    CallStats getTotal() {
+        unique_lock<mutex> lg(mutex_);
+        return total_;
+    }
+
+    void clearTotal() {
+        unique_lock<mutex> lg(mutex_);
+        total_ = CallStats();
+    }
+
+protected:
+    string service_;
+    mt19937 rng_;
+
+    virtual bool call(chrono::duration<double> timeout, bool &success) = 0;
+
+private:
+    mutex mutex_;
+    CallStats interval_, total_;
+};
+
+template<class ServiceT>
+class ServiceClient : public SoakClient {
+public:
+    typedef function<void(typename ServiceT::Request &, mt19937 &)> FillRequest;
+
+    // label: for the report, service: the full name
+    ServiceClient(rclcpp::Node::SharedPtr node, const string &label, const string &service, uint32_t seed,
+                  FillRequest fill) :
+        SoakClient(label, seed), node_(node), fill_(fill) {
+        client_ = node->create_client<ServiceT>(service);
+    }
+
+    bool waitForService(double timeout_s) override {
+        return client_->wait_for_service(chrono::duration_cast<chrono::nanoseconds>(chrono::duration<double>(timeout_s)));
+    }
+
+protected:
+    bool call(chrono::duration<double> timeout, bool &success) override {
+        auto request = make_shared<typename ServiceT::Request>();
+
+        if (fill_) {
+            fill_(*request, rng_);
+        }
+
+        auto future = client_->async_send_request(request);
+
+        if (future.future.wait_for(timeout) != future_status::ready) {
+            // Otherwise a response that never comes stays pending in the client forever
+            client_->remove_pending_request(future.request_id);
+            return false;
+        }
+
+        success = future.future.get()->successed;
+        return true;
+    }
+
+private:
+    rclcpp::Node::SharedPtr node_;
+    typename rclcpp::Client<ServiceT>::SharedPtr client_;
+    FillRequest fill_;
+};
+
+struct StateStats {
+    uint64_t received  = 0;
+    uint64_t missed    = 0; // Sequence numbers skipped
+    uint64_t reordered = 0; // Sequence numbers at or below the last one
+    double max_gap_ms  = 0; // Between two messages, as received
+};
+
+// One subscriber node on grp_state
+class StateSubscriber {
+public:
+    StateSubscriber(rclcpp::Node::SharedPtr node, const string &topic, const rclcpp::QoS &qos) : node_(node) {
+        subscription_ = node->create_subscription<GripperMsg>(topic, qos, [this] (const GripperMsg::SharedPtr msg) {
+            onMessage(msg->sequence);
+        });
+    }
+
+    StateStats takeInterval() {
+        unique_lock<mutex> lg(mutex_);
+        StateStats stats = interval_;
+        interval_ = StateStats();
+        return stats;
+    }
+
+    StateStats getTotal() {
+        unique_lock<mutex> lg(mutex_);
+        return total_;
+    }
+
+    // The sequence carries on, so that nothing is counted as lost across the reset
+    void clearTotal() {
+        unique_lock<mutex> lg(mutex_);
+        total_ = StateStats();
+    }
+
+    bool hasReceived() {
+        unique_lock<mutex> lg(mutex_);
+        return has_last_;
+    }
+
+private:
+    rclcpp::Node::SharedPtr node_;
+    rclcpp::Subscription<GripperMsg>::SharedPtr subscription_;
+
+    mutex mutex_;
+    StateStats interval_, total_;
+
+    bool has_last_ = false;
+    uint32_t last_sequence_ = 0;
+    SoakClock::time_point time_last_;
+
+    void onMessage(uint32_t sequence) {
+        const auto time_now = SoakClock::now();
+        unique_lock<mutex> lg(mutex_);
+
+        for (StateStats *stats : {&interval_, &total_}) {
+            stats->received++;
+
+            if (has_last_) {
+                if (sequence > last_sequence_) {
+                    stats->missed += sequence - last_sequence_ - 1;
+                } else {
+                    stats->reordered++;
+                }
+
+                stats->max_gap_ms = std::max(stats->max_gap_ms,
+                                             chrono::duration<double, milli>(time_now - time_last_).count());
+            }
+        }
+
+        has_last_      = true;
+        last_sequence_ = std::max(last_sequence_, sequence);
+        time_last_     = time_now;
+    }
+};
+
+struct ChildProcess {
+    string name;
+    pid_t pid   = -1;
+    bool exited = false;
+    int status  = 0;
+
+    bool isRunning() {
+        if (pid < 0 || exited) {
+            return false;
+        }
+
+        if (waitpid(pid, &status, WNOHANG) == pid) {
+            exited = true;
+        }
+
+        return !exited;
+    }
+
+    // Exited by itself with 0, or stopped by us and then exited with 0
+    bool isClean() const {
+        return exited && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+
+    string describe() const {
+        if (!exited) {
+            return "running";
+        } else if (WIFEXITED(status)) {
+            return "exit status " + to_string(WEXITSTATUS(status));
+        } else if (WIFSIGNALED(status)) {
+            return string("killed by ") + strsignal(WTERMSIG(status));
+        }
+
+        return "status " + to_string(status);
+    }
+
+    bool spawn(const vector<string> &args) {
+        vector<char *> argv;
+
+        for (const auto &arg : args) {
+            argv.push_back(const_cast<char *>(arg.c_str()));
+        }
+
+        argv.push_back(NULL);
+
+        pid = fork();
+
+        if (pid == 0) {
+            // Gone with the harness, also when it is killed
+            prctl(PR_SET_PDEATHSIG, SIGTERM);
+            execv(argv[0], argv.data());
+            _exit(127); // Reported as its exit status
+        }
+
+        return pid > 0;
+    }
+
+    // SIGINT first, so that the child shuts down (and sanitizers report) as usual; SIGKILL after timeout_s
+    void stop(double timeout_s) {
+        if (!isRunning()) {
+            return;
+        }
+
+        kill(pid, SIGINT);
+
+        const auto time_kill = SoakClock::now() + chrono::duration_cast<SoakClock::duration>(chrono::duration<double>(timeout_s));
+
+        while (isRunning()) {
+            if (SoakClock::now() > time_kill) {
+                kill(pid, SIGKILL);
+                waitpid(pid, &status, 0);
+                exited = true;
+                break;
+            }
+
+            this_thread::sleep_for(chrono::milliseconds(50));
+        }
+    }
+};
+
+// "key value" lines, as the wear counters of health_stats.cpp
+static bool loadKeyValues(const string &path, map<string, double> &values) {
+    FILE *file = fopen(path.c_str(), "r");
+
+    if (file == NULL) {
+        return false;
+    }
+
+    char key[128];
+    double value;
+
+    while (fscanf(file, "%127s %lf", key, &value) == 2) {
+        values[key] = value;
+    }
+
+    fclose(file);
+
+    return true;
+}
+
+static bool saveKeyValues(const string &path, const vector<pair<string, double>> &values) {
+    FILE *file = fopen(path.c_str(), "w");
+
+    if (file == NULL) {
+        return false;
+    }
+
+    for (const auto &value : values) {
+        fprintf(file, "%s %.6g\n", value.first.c_str(), value.second);
+    }
+
+    return fclose(file) == 0;
+}
+
+static bool endsWith(const string &str, const string &suffix) {
+    return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+static string getExecutableDir() {
+    char path[PATH_MAX];
+    const ssize_t len = readlink("/proc/self/exe", path, sizeof(path) - 1);
+
+    if (len <= 0) {
+        return ".";
+    }
+
+    path[len] = '\0';
+
+    string dir = path;
+    return dir.substr(0, dir.rfind('/'));
+}
+
+// Least squares slope of the RSS samples, kB per hour
+static double getRssSlope(const vector<pair<double, long>> &samples) {
+    if (samples.size() < 2) {
+        return 0;
+    }
+
+    double sum_t = 0, sum_r = 0;
+
+    for (const auto &sample : samples) {
+        sum_t += sample.first;
+        sum_r += sample.second;
+    }
+
+    const double mean_t = sum_t / samples.size(), mean_r = sum_r / samples.size();
+    double num = 0, den = 0;
+
+    for (const auto &sample : samples) {
+        num += (sample.first - mean_t) * (sample.second - mean_r);
+        den += (sample.first - mean_t) * (sample.first - mean_t);
+    }
+
+    return den > 0 ? num / den * 3600 : 0;
+}
+
+class DatcSoak : public rclcpp::Node {
+public:
+    DatcSoak() : rclcpp::Node("datc_soak") {
+        duration_s_      = declare_parameter<double>("duration_s", 3600.0);
+        warmup_s_        = declare_parameter<double>("warmup_s", 30.0);
+        report_period_s_ = declare_parameter<double>("report_period_s", 60.0);
+        startup_timeout_s_ = declare_parameter<double>("startup_timeout_s", 30.0);
+
+        // Processes under test; launch false attaches to a node that is already running
+        launch_          = declare_parameter<bool>("launch", true);
+        node_executable_ = declare_parameter<string>("node_executable", getExecutableDir() + "/kr_gcs_node");
+        sim_executable_  = declare_parameter<string>("sim_executable", getExecutableDir() + "/datc_sim");
+        node_params_     = declare_parameter<vector<string>>("node_params", vector<string>());
+        sim_args_        = declare_parameter<vector<string>>("sim_args", vector<string>());
+        port_            = declare_parameter<string>("port", "/tmp/datc_soak_" + to_string(getpid()));
+        slave_address_   = declare_parameter<int>("slave_address", 1);
+        namespace_       = declare_parameter<string>("namespace", "");
+        target_pid_      = declare_parameter<int>("target_pid", 0); // RSS of an attached node
+
+        // Load: "<service>:<clients>", each client a node of its own
+        mix_             = declare_parameter<vector<string>>("mix", vector<string>({"set_finger_pos:4", "grp_open:2", "grp_close:2"}));
+        client_rate_     = declare_parameter<double>("client_rate", 0.0); // Calls / s per client, 0: back to back
+        timeout_s_       = declare_parameter<double>("timeout_s", 2.0);
+        setup_           = declare_parameter<vector<string>>("setup", vector<string>({"motor_enable", "gripper_initialize"}));
+        subscriber_count_     = declare_parameter<int>("subscribers", 4);
+        qos_reliability_ = declare_parameter<string>("qos.reliability", "reliable");
+        qos_depth_       = declare_parameter<int>("qos.depth", 10);
+        executor_threads_ = declare_parameter<int>("executor_threads", 4);
+
+        // Limits over the run after the warmup, negative: not checked
+        fail_timeouts_      = declare_parameter<int>("fail.timeouts", 0);
+        fail_failed_        = declare_parameter<int>("fail.failed", 0);
+        fail_p99_ms_        = declare_parameter<double>("fail.p99_ms", 100.0);
+        fail_throughput_    = declare_parameter<double>("fail.min_throughput", -1.0);
+        fail_missed_        = declare_parameter<int>("fail.missed", 0);
+        fail_state_gap_ms_  = declare_parameter<double>("fail.state_gap_ms", 500.0);
+        fail_rss_growth_kb_ = declare_parameter<int>("fail.rss_growth_kb", 16384);
+
+        // Regression against an earlier report_file
+        report_file_        = declare_parameter<string>("report_file", "");
+        baseline_file_      = declare_parameter<string>("baseline_file", "");
+        baseline_tolerance_ = declare_parameter<double>("baseline_tolerance", 0.25);
+    }
+
+    // Exit status: 0 passed, 1 failed, 2 could not run
+    int run() {
+        string error;
+
+        if (!checkParameters(error)) {
+            RCLCPP_ERROR(get_logger(), "%s", error.c_str());
+            return 2;
+        }
+
+        if (launch_ && !launchChildren()) {
+            stopChildren();
+            return 2;
+        }
+
+        rclcpp::executors::MultiThreadedExecutor executor(rclcpp::ExecutorOptions(), (size_t) executor_threads_);
+
+        if (!createClients(executor, error)) {
+            RCLCPP_ERROR(get_logger(), "%s", error.c_str());
+            stopChildren();
+            return 2;
+        }
+
+        thread spin_thread([&executor] () {executor.spin();});
+
+        int result = 2;
+
+        if (waitReady() && runSetup()) {
+            result = runLoad() ? 0 : 1;
+        }
+
+        executor.cancel();
+        spin_thread.join();
+
+        clients_.clear();
+        subscribers_.clear();
+
+        if (!stopChildren() && result == 0) {
+            result = 1;
+        }
+
+        RCLCPP_INFO(get_logger(), "%s", result == 0 ? "PASSED" : (result == 1 ? "FAILED" : "NOT RUN"));
+
+        return result;
+    }
+
+private:
+    double duration_s_, warmup_s_, report_period_s_, startup_timeout_s_;
+
+    bool launch_;
+    string node_executable_, sim_executable_;
+    vector<string> node_params_, sim_args_;
+    string port_;
+    int64_t slave_address_;
+    string namespace_;
+    int64_t target_pid_;
+
+    vector<string> mix_;
+    double client_rate_, timeout_s_;
+    vector<string> setup_;
+    int64_t subscriber_count_;
+    string qos_reliability_;
+    int64_t qos_depth_;
+    int64_t executor_threads_;
+
+    int64_t fail_timeouts_, fail_failed_;
+    double fail_p99_ms_, fail_throughput_;
+    int64_t fail_missed_;
+    double fail_state_gap_ms_;
+    int64_t fail_rss_growth_kb_;
+
+    string report_file_, baseline_file_;
+    double baseline_tolerance_;
+
+    ChildProcess sim_, node_;
+
+    vector<rclcpp::Node::SharedPtr> nodes_;
+    vector<shared_ptr<SoakClient>> clients_;
+    vector<shared_ptr<StateSubscriber>> subscribers_;
+    map<string, size_t> mix_counts_; // Clients per service, in the order of mix
+
+    string getName(const string &name) const {
+        return namespace_.empty() ? name : namespace_ + "/" + name;
+    }
+
+    bool checkParameters(string &error) const {
+        if (!(duration_s_ > warmup_s_ && warmup_s_ >= 0)) {
+            error = "duration_s must be longer than warmup_s";
+        } else if (!(report_period_s_ > 0) || !(timeout_s_ > 0) || !(startup_timeout_s_ > 0) || client_rate_ < 0) {
+            error = "report_period_s, timeout_s and startup_timeout_s must be positive, client_rate not negative";
+        } else if (subscriber_count_ < 0 || qos_depth_ < 1 || executor_threads_ < 1) {
+            error = "subscribers must not be negative, qos.depth and executor_threads at least 1";
+        } else if (qos_reliability_ != "reliable" && qos_reliability_ != "best_effort") {
+            error = "qos.reliability must be 'reliable' or 'best_effort'";
+        } else {
+            return true;
+        }
+
+        return false;
+    }
+
+    shared_ptr<SoakClient> createClient(rclcpp::Node::SharedPtr node, const string &service, uint32_t seed) {
+        const string name = getName(service);
+
+        if (service == "set_finger_pos") {
+            return make_shared<ServiceClient<SingleInt>>(node, service, name, seed, [] (SingleInt::Request &req, mt19937 &rng) {
+                req.value = (int16_t) uniform_int_distribution<int>(kFingerPosMin, kFingerPosMax)(rng);
+            });
+        } else if (service == "set_motor_torque") {
+            return make_shared<ServiceClient<SingleInt>>(node, service, name, seed, [] (SingleInt::Request &req, mt19937 &rng) {
+                req.value = (int16_t) uniform_int_distribution<int>(kTorqueRatioMin, kTorqueRatioMax)(rng);
+            });
+        } else if (service == "set_motor_speed") {
+            return make_shared<ServiceClient<SingleInt>>(node, service, name, seed, [] (SingleInt::Request &req, mt19937 &rng) {
+                req.value = (int16_t) uniform_int_distribution<int>(kSpeedRatioMin, kSpeedRatioMax)(rng);
+            });
+        } else if (service == "get_health") {
+            return make_shared<ServiceClient<GetHealth>>(node, service, name, seed, nullptr);
+        } else if (service == "grp_open" || service == "grp_close" || service == "motor_stop" ||
+                   service == "motor_enable" || service == "motor_disable" || service == "gripper_initialize" ||
+                   service == "vacuum_grp_on" || service == "vacuum_grp_off") {
+            return make_shared<ServiceClient<Void>>(node, service, name, seed, nullptr);
+        }
+
+        // modbus_slave_change and set_modbus_addr would take the gripper away from the test
+        return nullptr;
+    }
+
+    bool createClients(rclcpp::executors::MultiThreadedExecutor &executor, string &error) {
+        uint32_t seed = 1;
+
+        for (const auto &entry : mix_) {
+            const size_t colon = entry.find(':');
+            const string service = entry.substr(0, colon);
+            const int count = colon == string::npos ? 1 : atoi(entry.c_str() + colon + 1);
+
+            if (count < 1) {
+                error = "mix entry " + entry + ": expected <service>:<clients>";
+                return false;
+            }
+
+            for (int i = 0; i < count; i++) {
+                auto node = make_shared<rclcpp::Node>("datc_soak_client_" + to_string(clients_.size()));
+                auto client = createClient(node, service, seed++);
+
+                if (client == nullptr) {
+                    error = "mix entry " + entry + ": " + service + " is not supported";
+                    return false;
+                }
+
+                executor.add_node(node);
+                nodes_.push_back(node);
+                clients_.push_back(client);
+            }
+
+            mix_counts_[service] += count;
+        }
+
+        if (clients_.empty() && subscriber_count_ == 0) {
+            error = "Nothing to do: mix is empty and subscribers is 0";
+            return false;
+        }
+
+        rclcpp::QoS qos((size_t) qos_depth_);
+
+        if (qos_reliability_ == "best_effort") {
+            qos.best_effort();
+        } else {
+            qos.reliable();
+        }
+
+        for (int64_t i = 0; i < subscriber_count_; i++) {
+            auto node = make_shared<rclcpp::Node>("datc_soak_subscriber_" + to_string(i));
+
+            executor.add_node(node);
+            nodes_.push_back(node);
+            subscribers_.push_back(make_shared<StateSubscriber>(node, getName("grp_state"), qos));
+        }
+
+        return true;
+    }
+
+    bool launchChildren() {
+        vector<string> sim_args = {sim_executable_, "--link", port_, "--slave", to_string(slave_address_)};
+        sim_args.insert(sim_args.end(), sim_args_.begin(), sim_args_.end());
+
+        sim_.name = "datc_sim";
+
+        if (!sim_.spawn(sim_args)) {
+            RCLCPP_ERROR(get_logger(), "Cannot start %s: %s", sim_executable_.c_str(), strerror(errno));
+            return false;
+        }
+
+        // The node gives up on a port that does not answer, so the simulator has to be there first
+        const auto time_limit = SoakClock::now() + chrono::duration_cast<SoakClock::duration>(chrono::duration<double>(kLinkWaitS));
+        struct stat link_stat;
+
+        while (lstat(port_.c_str(), &link_stat) != 0) {
+            if (!sim_.isRunning() || SoakClock::now() > time_limit) {
+                RCLCPP_ERROR(get_logger(), "datc_sim did not create %s (%s)", port_.c_str(), sim_.describe().c_str());
+                return false;
+            }
+
+            this_thread::sleep_for(chrono::milliseconds(20));
+        }
+
+        vector<string> node_args = {node_executable_, "--ros-args",
+                                    "-p", "port:=" + port_,
+                                    "-p", "slave_address:=" + to_string(slave_address_)};
+
+        if (!namespace_.empty()) {
+            node_args.insert(node_args.end(), {"-r", "__ns:=" + namespace_});
+        }
+
+        // get_health fails while the node does not count
+        for (const auto &entry : mix_) {
+            if (entry.compare(0, 11, "get_health:") == 0) {
+                node_args.insert(node_args.end(), {"-p", "health.enable:=true"});
+                break;
+            }
+        }
+
+        for (const auto &param : node_params_) {
+            node_args.insert(node_args.end(), {"-p", param});
+        }
+
+        node_.name = "kr_gcs_node";
+
+        if (!node_.spawn(node_args)) {
+            RCLCPP_ERROR(get_logger(), "Cannot start %s: %s", node_executable_.c_str(), strerror(errno));
+            return false;
+        }
+
+        target_pid_ = node_.pid;
+
+        RCLCPP_INFO(get_logger(), "datc_sim on %s (pid %d), kr_gcs_node (pid %d)", port_.c_str(), (int) sim_.pid,
+                    (int) node_.pid);
+
+        return true;
+    }
+
+    // False if a child did not exit cleanly
+    bool stopChildren() {
+        bool clean = true;
+
+        for (ChildProcess *child : {&node_, &sim_}) {
+            if (child->pid < 0) {
+                continue;
+            }
+
+            child->stop(kChildStopTimeoutS);
+
+            if (!child->isClean()) {
+                RCLCPP_ERROR(get_logger(), "%s: %s", child->name.c_str(), child->describe().c_str());
+                clean = false;
+            }
+        }
+
+        return clean;
+    }
+
+    bool checkChildren() {
+        for (ChildProcess *child : {&sim_, &node_}) {
+            if (child->pid >= 0 && !child->isRunning()) {
+                RCLCPP_ERROR(get_logger(), "%s exited during the run: %s", child->name.c_str(), child->describe().c_str());
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Services available and grp_state flowing on every subscriber
+    bool waitReady() {
+        const auto time_limit = SoakClock::now() +
+                                chrono::duration_cast<SoakClock::duration>(chrono::duration<double>(startup_timeout_s_));
+
+        for (const auto &client : clients_) {
+            while (!client->waitForService(0.1)) {
+                if (!rclcpp::ok() || !checkChildren() || SoakClock::now() > time_limit) {
+                    RCLCPP_ERROR(get_logger(), "Service %s is not available", client->getService().c_str());
+                    return false;
+                }
+            }
+        }
+
+        for (const auto &subscriber : subscribers_) {
+            while (!subscriber->hasReceived()) {
+                if (!rclcpp::ok() || !checkChildren() || SoakClock::now() > time_limit) {
+                    RCLCPP_ERROR(get_logger(), "No grp_state within startup_timeout_s (is the node active?)");
+                    return false;
+                }
+
+                this_thread::sleep_for(chrono::milliseconds(20));
+            }
+        }
+
+        return true;
+    }
+
+    bool runSetup() {
+        auto node = make_shared<rclcpp::Node>("datc_soak_setup");
+        rclcpp::executors::SingleThreadedExecutor executor;
+        executor.add_node(node);
+
+        for (const auto &service : setup_) {
+            auto client = createClient(node, service, 0);
+            bool success = false;
+
+            if (client == nullptr) {
+                RCLCPP_ERROR(get_logger(), "setup: %s is not supported", service.c_str());
+                return false;
+            } else if (!client->waitForService(startup_timeout_s_)) {
+                RCLCPP_ERROR(get_logger(), "setup: %s is not available", service.c_str());
+                return false;
+            }
+
+            thread spin_thread([&executor] () {executor.spin();});
+            const bool answered = client->callOnce(timeout_s_, success);
+            executor.cancel();
+            spin_thread.join();
+
+            if (!answered || !success) {
+                RCLCPP_ERROR(get_logger(), "setup: %s %s", service.c_str(), answered ? "failed" : "timed out");
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    map<string, CallStats> mergeByService(bool interval) {
+        map<string, CallStats> stats;
+
+        for (const auto &client : clients_) {
+            stats[client->getService()].merge(interval ? client->takeInterval() : client->getTotal());
+        }
+
+        return stats;
+    }
+
+    StateStats mergeState(bool interval) {
+        StateStats total;
+
+        for (const auto &subscriber : subscribers_) {
+            const StateStats stats = interval ? subscriber->takeInterval() : subscriber->getTotal();
+
+            total.received  += stats.received;
+            total.missed    += stats.missed;
+            total.reordered += stats.reordered;
+            total.max_gap_ms = std::max(total.max_gap_ms, stats.max_gap_ms);
+        }
+
+        return total;
+    }
+
+    void logCalls(const char *prefix, const string &service, const CallStats &stats, double period_s) {
+        RCLCPP_INFO(get_logger(), "%s %s: %.1f calls/s, p50 %.2f ms, p99 %.2f ms, p99.9 %.2f ms, max %.2f ms, "
+                    "%lu failed, %lu timeouts", prefix, service.c_str(), stats.calls / period_s,
+                    stats.latency.getQuantileMs(0.5), stats.latency.getQuantileMs(0.99),
+                    stats.latency.getQuantileMs(0.999), stats.latency.getMaxMs(), (unsigned long) stats.failed,
+                    (unsigned long) stats.timeouts);
+    }
+
+    void logState(const char *prefix, const StateStats &stats, double period_s) {
+        if (subscribers_.empty()) {
+            return;
+        }
+
+        RCLCPP_INFO(get_logger(), "%s grp_state: %.1f msg/s per subscriber, %lu missed, %lu reordered, max gap %.1f ms",
+                    prefix, stats.received / period_s / subscribers_.size(), (unsigned long) stats.missed,
+                    (unsigned long) stats.reordered, stats.max_gap_ms);
+    }
+
+    bool runLoad() {
+        atomic<bool> stop {false};
+        vector<thread> workers;
+
+        const double period_s = client_rate_ > 0 ? 1 / client_rate_ : 0;
+
+        for (const auto &client : clients_) {
+            workers.emplace_back([this, client, period_s, &stop] () {client->run(period_s, timeout_s_, stop);});
+        }
+
+        RCLCPP_INFO(get_logger(), "%zu clients, %zu subscribers, %.0f s (%.0f s warmup)", clients_.size(),
+                    subscribers_.size(), duration_s_, warmup_s_);
+
+        const auto time_start  = SoakClock::now();
+        const auto time_warm   = time_start + chrono::duration_cast<SoakClock::duration>(chrono::duration<double>(warmup_s_));
+        const auto time_end    = time_start + chrono::duration_cast<SoakClock::duration>(chrono::duration<double>(duration_s_));
+        const auto report_step = chrono::duration_cast<SoakClock::duration>(chrono::duration<double>(report_period_s_));
+
+        auto time_report = time_start + report_step;
+        auto time_interval = time_start;
+        bool warm = false;
+        bool children_ok = true;
+
+        long rss_start_kb = -1;
+        vector<pair<double, long>> rss_samples; // Seconds since the warmup, kB
+
+        while (rclcpp::ok() && SoakClock::now() < time_end) {
+            this_thread::sleep_for(chrono::milliseconds(100));
+
+            if (!checkChildren()) {
+                children_ok = false;
+                break;
+            }
+
+            const auto time_now = SoakClock::now();
+
+            // What the warmup saw (startup, allocator and DDS discovery) is left out
+            if (!warm && time_now >= time_warm) {
+                for (const auto &client : clients_) {
+                    client->clearTotal();
+                }
+
+                for (const auto &subscriber : subscribers_) {
+                    subscriber->clearTotal();
+                }
+
+                rss_start_kb = target_pid_ > 0 ? getRssKb((pid_t) target_pid_) : -1;
+                warm = true;
+            }
+
+            if (time_now >= time_report) {
+                const double interval_s = chrono::duration<double>(time_now - time_interval).count();
+                const double elapsed_min = chrono::duration<double>(time_now - time_start).count() / 60;
+                char prefix[32];
+                snprintf(prefix, sizeof(prefix), "[%.1f min]", elapsed_min);
+
+                for (const auto &entry : mergeByService(true)) {
+                    logCalls(prefix, entry.first, entry.second, interval_s);
+                }
+
+                logState(prefix, mergeState(true), interval_s);
+
+                const long rss_kb = target_pid_ > 0 ? getRssKb((pid_t) target_pid_) : -1;
+
+                if (rss_kb >= 0) {
+                    RCLCPP_INFO(get_logger(), "%s RSS %ld kB%s", prefix, rss_kb, warm ? "" : " (warmup)");
+
+                    if (warm) {
+                        rss_samples.emplace_back(chrono::duration<double>(time_now - time_warm).count(), rss_kb);
+                    }
+                }
+
+                time_interval = time_now;
+                time_report  += report_step;
+            }
+        }
+
+        const auto time_stop = SoakClock::now();
+
+        stop = true;
+
+        for (auto &worker : workers) {
+            worker.join();
+        }
+
+        if (!warm) {
+            RCLCPP_ERROR(get_logger(), "Stopped within the warmup, nothing to evaluate");
+            return false;
+        }
+
+        const long rss_end_kb = target_pid_ > 0 ? getRssKb((pid_t) target_pid_) : -1;
+
+        return evaluate(chrono::duration<double>(time_stop - time_warm).count(), rss_start_kb, rss_end_kb,
+                        getRssSlope(rss_samples)) && children_ok;
+    }
+
+    bool evaluate(double measured_s, long rss_start_kb, long rss_end_kb, double rss_slope) {
+        const map<string, CallStats> by_service = mergeByService(false);
+        CallStats calls;
+
+        for (const auto &entry : by_service) {
+            logCalls("[total]", entry.first, entry.second, measured_s);
+            calls.merge(entry.second);
+        }
+
+        const StateStats state = mergeState(false);
+        logState("[total]", state, measured_s);
+
+        const double throughput = calls.calls / measured_s;
+        const double p99_ms     = calls.latency.getQuantileMs(0.99);
+        const long rss_growth   = (rss_start_kb >= 0 && rss_end_kb >= 0) ? rss_end_kb - rss_start_kb : 0;
+
+        RCLCPP_INFO(get_logger(), "[total] %.1f calls/s over %.0f s, p99 %.2f ms", throughput, measured_s, p99_ms);
+
+        if (rss_start_kb >= 0 && rss_end_kb >= 0) {
+            RCLCPP_INFO(get_logger(), "[total] RSS %ld -> %ld kB (%+ld kB, %+.0f kB/h)", rss_start_kb, rss_end_kb,
+                        rss_growth, rss_slope);
+        }
+
+        vector<pair<string, double>> report = {
+            {"measured_s", measured_s},
+            {"throughput", throughput},
+            {"calls", (double) calls.calls},
+            {"failed", (double) calls.failed},
+            {"timeouts", (double) calls.timeouts},
+            {"p50_ms", calls.latency.getQuantileMs(0.5)},
+            {"p99_ms", p99_ms},
+            {"p999_ms", calls.latency.getQuantileMs(0.999)},
+            {"max_ms", calls.latency.getMaxMs()},
+            {"state_received", (double) state.received},
+            {"state_missed", (double) state.missed},
+            {"state_reordered", (double) state.reordered},
+            {"state_max_gap_ms", state.max_gap_ms},
+            {"rss_start_kb", (double) rss_start_kb},
+            {"rss_end_kb", (double) rss_end_kb},
+            {"rss_growth_kb", (double) rss_growth},
+            {"rss_slope_kb_per_h", rss_slope},
+        };
+
+        for (const auto &entry : by_service) {
+            report.emplace_back(entry.first + ".throughput", entry.second.calls / measured_s);
+            report.emplace_back(entry.first + ".p99_ms", entry.second.latency.getQuantileMs(0.99));
+        }
+
+        if (!report_file_.empty() && !saveKeyValues(report_file_, report)) {
+            RCLCPP_ERROR(get_logger(), "Cannot write %s: %s", report_file_.c_str(), strerror(errno));
+        }
+
+        vector<string> failures;
+
+        if (fail_timeouts_ >= 0 && calls.timeouts > (uint64_t) fail_timeouts_) {
+            failures.push_back(to_string(calls.timeouts) + " timeouts");
+        }
+
+        if (fail_failed_ >= 0 && calls.failed > (uint64_t) fail_failed_) {
+            failures.push_back(to_string(calls.failed) + " failed calls");
+        }
+
+        if (fail_p99_ms_ >= 0 && p99_ms > fail_p99_ms_) {
+            failures.push_back("p99 " + to_string(p99_ms) + " ms");
+        }
+
+        if (fail_throughput_ >= 0 && throughput < fail_throughput_) {
+            failures.push_back("throughput " + to_string(throughput) + " calls/s");
+        }
+
+        if (fail_missed_ >= 0 && state.missed > (uint64_t) fail_missed_) {
+            failures.push_back(to_string(state.missed) + " grp_state messages missed");
+        }
+
+        if (fail_state_gap_ms_ >= 0 && state.max_gap_ms > fail_state_gap_ms_) {
+            failures.push_back("grp_state gap " + to_string(state.max_gap_ms) + " ms");
+        }
+
+        if (fail_rss_growth_kb_ >= 0 && rss_growth > fail_rss_growth_kb_) {
+            failures.push_back("RSS growth " + to_string(rss_growth) + " kB");
+        }
+
+        if (!baseline_file_.empty()) {
+            map<string, double> baseline;
+
+            if (!loadKeyValues(baseline_file_, baseline)) {
+                failures.push_back("baseline " + baseline_file_ + " unreadable");
+            } else {
+                // Per service as well, so that one service slowing down is not hidden by the others
+                for (const auto &entry : report) {
+                    const string &key = entry.first;
+                    const auto found  = baseline.find(key);
+
+                    if (found == baseline.end()) {
+                        continue;
+                    }
+
+                    const bool higher_worse = endsWith(key, "p99_ms");
+                    const bool lower_worse  = endsWith(key, "throughput");
+
+                    if (higher_worse && entry.second > found->second * (1 + baseline_tolerance_)) {
+                        failures.push_back(key + " " + to_string(entry.second) + " (baseline " + to_string(found->second) + ")");
+                    } else if (lower_worse && entry.second < found->second * (1 - baseline_tolerance_)) {
+                        failures.push_back(key + " " + to_string(entry.second) + " (baseline " + to_string(found->second) + ")");
+                    }
+                }
+            }
+        }
+
+        for (const auto &failure : failures) {
+            RCLCPP_ERROR(get_logger(), "Regression: %s", failure.c_str());
+        }
+
+        return failures.empty();
+    }
+};
+
+int main(int argc, char *argv[]) {
+    rclcpp::init(argc, argv);
+
+    int result;
+
+    {
+        auto soak = make_shared<DatcSoak>();
+        result = soak->run();
+    }
+
+    rclcpp::shutdown();
+
+    return result;
+}
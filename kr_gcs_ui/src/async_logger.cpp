@@ -0,0 +1,344 @@
+/**
+ * @file async_logger.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "async_logger.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+static_assert((kLogQueueSize & (kLogQueueSize - 1)) == 0, "kLogQueueSize must be a power of two");
+
+static int64_t clockNs(clockid_t clock) {
+    timespec time;
+    clock_gettime(clock, &time);
+    return time.tv_sec * 1000000000L + time.tv_nsec;
+}
+
+static const char *baseName(const char *path) {
+    const char *slash = strrchr(path, '/');
+    return slash != NULL ? slash + 1 : path;
+}
+
+// Never destroyed, so that it outlives every static that logs from its destructor; shutdown() at exit
+// writes out what is left
+AsyncLogger &AsyncLogger::instance() {
+    static AsyncLogger *logger = new AsyncLogger();
+    return *logger;
+}
+
+AsyncLogger::AsyncLogger() {
+    for (size_t i = 0; i < kLogQueueSize; i++) {
+        slots_[i].sequence.store(i, memory_order_relaxed);
+    }
+
+    running_ = true;
+    writer_thread_ = thread(&AsyncLogger::run, this);
+
+    atexit([] () {AsyncLogger::instance().shutdown();});
+}
+
+void AsyncLogger::log(LogSite &site, LOG_LEVEL level, const char *format, ...) {
+    if (!site.registered.exchange(true)) {
+        LogSite *head = sites_.load();
+
+        do {
+            site.next = head;
+        } while (!sites_.compare_exchange_weak(head, &site));
+    }
+
+    // Per site: kLogSiteBurst messages per window, the rest is counted and reported with the next one
+    const int64_t now_ns = clockNs(CLOCK_MONOTONIC);
+    int64_t window_start = site.window_start_ns.load(memory_order_relaxed);
+
+    if (now_ns - window_start >= kLogSiteWindowNs && site.window_start_ns.compare_exchange_strong(window_start, now_ns)) {
+        site.window_count = 0;
+    }
+
+    if (site.window_count.fetch_add(1) >= kLogSiteBurst) {
+        site.suppressed++;
+        suppressed_++;
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+
+    if (running_) {
+        if (!push(site, level, site.suppressed.exchange(0), format, args)) {
+            dropped_++;
+        }
+    } else {
+        // After shutdown(): nothing is left to block
+        LogRecord record;
+
+        record.level      = level;
+        record.site       = &site;
+        record.stamp_ns   = clockNs(CLOCK_REALTIME);
+        record.suppressed = site.suppressed.exchange(0);
+        vsnprintf(record.text, kLogTextMax, format, args);
+
+        unique_lock<mutex> lg(output_mutex_);
+        writeRecord(record);
+        flushRepeats(0, true);
+    }
+
+    va_end(args);
+}
+
+bool AsyncLogger::push(LogSite &site, LOG_LEVEL level, uint32_t suppressed, const char *format, va_list args) {
+    size_t pos = enqueue_pos_.load(memory_order_relaxed);
+    Slot *slot;
+
+    for (;;) {
+        slot = &slots_[pos & (kLogQueueSize - 1)];
+        const intptr_t diff = (intptr_t) slot->sequence.load(memory_order_acquire) - (intptr_t) pos;
+
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Full: the writer is behind by a whole ring
+            site.suppressed += suppressed;
+            return false;
+        } else {
+            pos = enqueue_pos_.load(memory_order_relaxed);
+        }
+    }
+
+    LogRecord &record = slot->record;
+
+    record.level      = level;
+    record.site       = &site;
+    record.stamp_ns   = clockNs(CLOCK_REALTIME);
+    record.suppressed = suppressed;
+    vsnprintf(record.text, kLogTextMax, format, args);
+
+    slot->sequence.store(pos + 1, memory_order_release);
+
+    return true;
+}
+
+bool AsyncLogger::pop(LogRecord &record) {
+    Slot &slot = slots_[dequeue_pos_ & (kLogQueueSize - 1)];
+
+    if (slot.sequence.load(memory_order_acquire) != dequeue_pos_ + 1) {
+        return false;
+    }
+
+    record = slot.record;
+    slot.sequence.store(dequeue_pos_ + kLogQueueSize, memory_order_release);
+    dequeue_pos_++;
+
+    return true;
+}
+
+void AsyncLogger::setSink(const void *owner, LogSink sink) {
+    unique_lock<mutex> lg(output_mutex_);
+
+    for (auto it = sinks_.begin(); it != sinks_.end(); ++it) {
+        if (it->first == owner) {
+            sinks_.erase(it);
+            break;
+        }
+    }
+
+    if (sink) {
+        sinks_.emplace_back(owner, sink);
+    }
+}
+
+bool AsyncLogger::setFile(const string &path, string &error) {
+    FILE *file = NULL;
+
+    if (!path.empty()) {
+        file = fopen(path.c_str(), "a");
+
+        if (file == NULL) {
+            error = "Cannot open " + path + ": " + strerror(errno);
+            return false;
+        }
+    }
+
+    unique_lock<mutex> lg(output_mutex_);
+
+    if (file_ != NULL) {
+        fclose(file_);
+    }
+
+    file_      = file;
+    file_path_ = path;
+
+    return true;
+}
+
+string AsyncLogger::getFile() {
+    unique_lock<mutex> lg(output_mutex_);
+    return file_path_;
+}
+
+void AsyncLogger::flush(int timeout_ms) {
+    const size_t target = enqueue_pos_.load();
+    const auto deadline = chrono::steady_clock::now() + chrono::milliseconds(timeout_ms);
+
+    while (running_ && written_pos_.load() < target && chrono::steady_clock::now() < deadline) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+}
+
+void AsyncLogger::shutdown() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    writer_thread_.join();
+
+    unique_lock<mutex> lg(output_mutex_);
+    drain();
+    flushRepeats(0, true);
+    reportSuppressed(INT64_MAX);
+
+    fflush(file_ != NULL ? file_ : stdout);
+}
+
+void AsyncLogger::run() {
+    while (running_) {
+        {
+            unique_lock<mutex> lg(output_mutex_);
+
+            drain();
+            flushRepeats(clockNs(CLOCK_REALTIME), false);
+            reportSuppressed(clockNs(CLOCK_MONOTONIC));
+
+            fflush(file_ != NULL ? file_ : stdout);
+        }
+
+        this_thread::sleep_for(chrono::milliseconds(kLogWritePeriodMs));
+    }
+}
+
+// Under output_mutex_
+void AsyncLogger::drain() {
+    LogRecord record;
+
+    while (pop(record)) {
+        writeRecord(record);
+        written_pos_ = dequeue_pos_;
+    }
+
+    const uint64_t dropped = dropped_;
+
+    if (dropped > dropped_reported_) {
+        char text[kLogTextMax];
+        snprintf(text, sizeof(text), "%lu log messages dropped, the queue was full",
+                 (unsigned long) (dropped - dropped_reported_));
+        write(LOG_LEVEL::WARN, clockNs(CLOCK_REALTIME), text);
+
+        dropped_reported_ = dropped;
+    }
+}
+
+// Consecutive copies of a line from the same site are counted instead of written
+void AsyncLogger::writeRecord(const LogRecord &record) {
+    if (has_last_ && record.site == last_.site && record.level == last_.level && record.suppressed == 0 &&
+        strcmp(record.text, last_.text) == 0) {
+        repeats_++;
+        repeat_stamp_ns_ = record.stamp_ns;
+        return;
+    }
+
+    flushRepeats(0, true);
+
+    if (record.suppressed > 0) {
+        char text[kLogTextMax + 64];
+        snprintf(text, sizeof(text), "%s (%u similar messages suppressed)", record.text, record.suppressed);
+        write(record.level, record.stamp_ns, text);
+    } else {
+        write(record.level, record.stamp_ns, record.text);
+    }
+
+    last_     = record;
+    has_last_ = true;
+}
+
+void AsyncLogger::flushRepeats(int64_t now_ns, bool force) {
+    if (repeats_ == 0 || (!force && now_ns - repeat_stamp_ns_ < kLogRepeatFlushNs)) {
+        return;
+    }
+
+    char text[kLogTextMax];
+    snprintf(text, sizeof(text), "Last message repeated %u times", repeats_);
+    write(last_.level, repeat_stamp_ns_, text);
+
+    repeats_ = 0;
+}
+
+// Sites that went quiet with messages still counted; now_ns is CLOCK_MONOTONIC
+void AsyncLogger::reportSuppressed(int64_t now_ns) {
+    for (LogSite *site = sites_.load(); site != NULL; site = site->next) {
+        if (site->suppressed == 0 || now_ns - site->window_start_ns < kLogSiteWindowNs) {
+            continue;
+        }
+
+        const uint32_t suppressed = site->suppressed.exchange(0);
+
+        if (suppressed > 0) {
+            char text[kLogTextMax];
+            snprintf(text, sizeof(text), "%u messages suppressed (%s:%d)", suppressed, baseName(site->file), site->line);
+            write(LOG_LEVEL::WARN, clockNs(CLOCK_REALTIME), text);
+        }
+    }
+}
+
+void AsyncLogger::write(LOG_LEVEL level, int64_t stamp_ns, const char *text) {
+    if (file_ != NULL) {
+        const time_t sec = stamp_ns / 1000000000L;
+        tm local;
+        char stamp[32];
+
+        localtime_r(&sec, &local);
+        strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &local);
+        fprintf(file_, "%s.%03d [%s] %s\n", stamp, (int) (stamp_ns / 1000000 % 1000), getLevelName(level), text);
+    } else if (!sinks_.empty()) {
+        sinks_.back().second(level, text);
+    } else {
+        fprintf(level >= LOG_LEVEL::WARN ? stderr : stdout, "[%s] %s\n", getLevelName(level), text);
+    }
+}
+
+bool AsyncLogger::parseLevel(const string &str, LOG_LEVEL &level) {
+    if (str == "debug") {
+        level = LOG_LEVEL::DEBUG;
+    } else if (str == "info") {
+        level = LOG_LEVEL::INFO;
+    } else if (str == "warn") {
+        level = LOG_LEVEL::WARN;
+    } else if (str == "error") {
+        level = LOG_LEVEL::ERROR;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+const char *AsyncLogger::getLevelName(LOG_LEVEL level) {
+    switch (level) {
+        case LOG_LEVEL::DEBUG: return "DEBUG";
+        case LOG_LEVEL::INFO:  return "INFO";
+        case LOG_LEVEL::WARN:  return "WARN";
+        case LOG_LEVEL::ERROR: return "ERROR";
+    }
+
+    return "";
+}
@@ -0,0 +1,95 @@
+/**
+ * @file command_runner.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "command_runner.hpp"
+#include "datc_trace.hpp"
+#include "async_logger.hpp"
+
+#include <chrono>
+
+CommandRunner::CommandRunner(QObject *parent) : QObject(parent) {
+    thread_ = thread(&CommandRunner::run, this);
+}
+
+CommandRunner::~CommandRunner() {
+    stop();
+}
+
+quint64 CommandRunner::submit(const QString &name, function<bool()> job, bool urgent) {
+    unique_lock<mutex> lg(mutex_);
+
+    const quint64 id = next_id_++;
+
+    DATC_TRACE(command_enqueue, id, name.toUtf8().constData());
+
+    if (urgent) {
+        queue_.push_front({id, name, job});
+    } else {
+        queue_.push_back({id, name, job});
+    }
+
+    cv_.notify_one();
+
+    return id;
+}
+
+void CommandRunner::stop() {
+    {
+        unique_lock<mutex> lg(mutex_);
+        running_ = false;
+        queue_.clear();
+    }
+
+    cv_.notify_one();
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void CommandRunner::run() {
+    while (true) {
+        Job job;
+
+        {
+            unique_lock<mutex> lg(mutex_);
+            cv_.wait(lg, [this] () {return !running_ || !queue_.empty();});
+
+            if (!running_) {
+                return;
+            }
+
+            job = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        DATC_TRACE(command_dequeue, job.id);
+
+        const auto time_start = chrono::steady_clock::now();
+
+        bool success = false;
+
+        try {
+            success = job.func();
+        } catch (const std::exception &e) {
+            DATC_LOG_ERROR("%s: %s", job.name.toUtf8().constData(), e.what());
+        }
+
+        DATC_TRACE(command_exit, job.id, success);
+
+        const qint64 elapsed_ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - time_start).count();
+
+        if (!success) {
+            DATC_LOG_ERROR("%s failed (%lld ms)", job.name.toUtf8().constData(), (long long) elapsed_ms);
+        }
+
+        Q_EMIT commandFinished(job.id, success, elapsed_ms);
+    }
+}
@@ -0,0 +1,104 @@
+/**
+ * @file command_sequence.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "command_sequence.hpp"
+
+const char *kStatusFlagFields[kStatusFlagCount] = {
+    "motor_enabled",
+    "gripper_initialized",
+    "position_ctrl_mode",
+    "velocity_ctrl_mode",
+    "current_ctrl_mode",
+    "grp_opened",
+    "grp_closed",
+    "motor_fault",
+};
+
+SequenceStep SequenceStep::makeCommand(uint16_t command, int16_t value_1, int16_t value_2) {
+    SequenceStep step;
+
+    step.type    = SEQUENCE_STEP::COMMAND;
+    step.command = command;
+    step.value_1 = value_1;
+    step.value_2 = value_2;
+
+    return step;
+}
+
+SequenceStep SequenceStep::makeWaitState(STATUS_FLAG flag, bool value, int timeout_ms) {
+    SequenceStep step;
+
+    step.type       = SEQUENCE_STEP::WAIT_STATE;
+    step.flag       = flag;
+    step.value      = value;
+    step.timeout_ms = timeout_ms;
+
+    return step;
+}
+
+SequenceStep SequenceStep::makeDelay(int delay_ms) {
+    SequenceStep step;
+
+    step.type     = SEQUENCE_STEP::DELAY;
+    step.delay_ms = delay_ms;
+
+    return step;
+}
+
+string SequenceStep::describe() const {
+    switch (type) {
+        case SEQUENCE_STEP::COMMAND:
+            return "command " + to_string(command) + " (" + to_string(value_1) + ", " + to_string(value_2) + ")";
+
+        case SEQUENCE_STEP::WAIT_STATE:
+            return string("wait ") + getStatusFlagName(flag) + " = " + (value ? "true" : "false") +
+                   " (" + to_string(timeout_ms) + " ms)";
+
+        case SEQUENCE_STEP::DELAY:
+            return "delay " + to_string(delay_ms) + " ms";
+    }
+
+    return "";
+}
+
+string checkSequence(const vector<SequenceStep> &steps) {
+    if (steps.empty()) {
+        return "The sequence has no steps";
+    } else if (steps.size() > kSequenceStepsMax) {
+        return "A sequence has at most " + to_string(kSequenceStepsMax) + " steps";
+    }
+
+    for (size_t i = 0; i < steps.size(); i++) {
+        const SequenceStep &step = steps[i];
+
+        if (step.type == SEQUENCE_STEP::WAIT_STATE && (step.timeout_ms < 1 || step.timeout_ms > kSequenceWaitMaxMs)) {
+            return "Step " + to_string(i) + ": timeout_ms must be within [1, " + to_string(kSequenceWaitMaxMs) + "]";
+        } else if (step.type == SEQUENCE_STEP::DELAY && (step.delay_ms < 0 || step.delay_ms > kSequenceWaitMaxMs)) {
+            return "Step " + to_string(i) + ": delay_ms must be within [0, " + to_string(kSequenceWaitMaxMs) + "]";
+        }
+    }
+
+    return "";
+}
+
+const char *getStatusFlagName(STATUS_FLAG flag) {
+    return kStatusFlagFields[(size_t) flag];
+}
+
+bool parseStatusFlag(const string &name, STATUS_FLAG &flag) {
+    for (size_t i = 0; i < kStatusFlagCount; i++) {
+        if (name == kStatusFlagFields[i]) {
+            flag = (STATUS_FLAG) i;
+            return true;
+        }
+    }
+
+    return false;
+}
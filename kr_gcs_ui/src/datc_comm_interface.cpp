@@ -10,180 +10,79 @@
  */
 #include "datc_comm_interface.hpp"
 
-const uint kFreq = 100;
-
-DatcCommInterface::DatcCommInterface(int argc, char **argv) {
-    rclcpp::init(argc, argv);
-    nh_ = rclcpp::Node::make_shared("DATC_Control_Interface");
-
-    // Publisher
-    publisher_grp_state_ = nh_->create_publisher<GripperMsg> ("grp_state", 1000);
-
-    // Server
-    // srv_modbus_init_release_ = nh_->create_service<SingleBoolean>("modbus_init_release",
-    //                            [&] (const shared_ptr<SingleBoolean::Request> req, shared_ptr<SingleBoolean::Response> res) {
-    //                                req;
-    //                            });
-
-    srv_motor_enable_ = nh_->create_service<Void>("motor_enable",
-                        [&] (const shared_ptr<Void::Request> req, shared_ptr<Void::Response> res) {
-                            COUT("[Service called] motor_enable");
-                            res->successed = motorEnable();
-                        });
-
-    srv_motor_disable_ = nh_->create_service<Void>("motor_disable",
-                         [&] (const shared_ptr<Void::Request> req, shared_ptr<Void::Response> res) {
-                             COUT("[Service called] motor_disable");
-                             res->successed = motorDisable();
-                         });
-
-    srv_modbus_slave_change_ = nh_->create_service<SingleInt>("modbus_slave_change",
-                               [&] (const shared_ptr<SingleInt::Request> req, shared_ptr<SingleInt::Response> res) {
-                                   COUT("[Service called] modbus_slave_change, input: " << (uint) req->value);
-                                   res->successed = modbusSlaveChange((uint) req->value);
-                               });
-
-    srv_set_modbus_addr_ = nh_->create_service<SingleInt>("set_modbus_addr",
-                           [&] (const shared_ptr<SingleInt::Request> req, shared_ptr<SingleInt::Response> res) {
-                               COUT("[Service called] set_modbus_addr, input: " << (uint) req->value);
-                               res->successed = setModbusAddr((uint) req->value);
-                           });
-
-    srv_set_finger_pos_ = nh_->create_service<SingleInt>("set_finger_pos",
-                          [&] (const shared_ptr<SingleInt::Request> req, shared_ptr<SingleInt::Response> res) {
-                              COUT("[Service called] set_finger_pos, input: " << (uint) req->value);
-                              res->successed = setFingerPos((uint) req->value);
-                          });
-
-    srv_set_motor_torque_ = nh_->create_service<SingleInt>("set_motor_torque",
-                            [&] (const shared_ptr<SingleInt::Request> req, shared_ptr<SingleInt::Response> res) {
-                                COUT("[Service called] set_motor_torque, input: " << (uint) req->value);
-                                res->successed = setMotorTorque((uint) req->value);
-                            });
-
-    srv_set_motor_speed_ = nh_->create_service<SingleInt>("set_motor_speed",
-                           [&] (const shared_ptr<SingleInt::Request> req, shared_ptr<SingleInt::Response> res) {
-                               COUT("[Service called] set_motor_speed, input: " << (uint) req->value);
-                               res->successed = setMotorSpeed((uint) req->value);
-                           });
-
-    srv_motor_stop_ = nh_->create_service<Void>("motor_stop",
-                      [&] (const shared_ptr<Void::Request> req, shared_ptr<Void::Response> res) {
-                          COUT("[Service called] motor_stop");
-                          res->successed = motorStop();
-                      });
-
-    srv_grp_initialize_ = nh_->create_service<Void>("gripper_initialize",
-                          [&] (const shared_ptr<Void::Request> req, shared_ptr<Void::Response> res) {
-                              COUT("[Service called] gripper_initialize");
-                              res->successed = grpInitialize();
-                          });
-
-    srv_grp_open_ = nh_->create_service<Void>("grp_open",
-                    [&] (const shared_ptr<Void::Request> req, shared_ptr<Void::Response> res) {
-                        COUT("[Service called] grp_open");
-                        res->successed = grpOpen();
-                    });
-
-    srv_grp_close_ = nh_->create_service<Void>("grp_close",
-                     [&] (const shared_ptr<Void::Request> req, shared_ptr<Void::Response> res) {
-                         COUT("[Service called] grp_close");
-                         res->successed = grpClose();
-                     });
-
-    srv_vacuum_grp_on_ = nh_->create_service<Void>("vacuum_grp_on",
-                         [&] (const shared_ptr<Void::Request> req, shared_ptr<Void::Response> res) {
-                             COUT("[Service called] vacuum_grp_on");
-                             res->successed = vacuumGrpOn();
-                         });
-
-    srv_vacuum_grp_off_ = nh_->create_service<Void>("vacuum_grp_off",
-                          [&] (const shared_ptr<Void::Request> req, shared_ptr<Void::Response> res) {
-                              COUT("[Service called] vacuum_grp_off");
-                              res->successed = vacuumGrpOff();
-                          });
-
-    // srv_motor_pos_ctrl_ = nh_->create_service<PosVelCurCtrl>("motor_pos_ctrl",
-    //                       [&] (const shared_ptr<PosVelCurCtrl::Request> req, shared_ptr<PosVelCurCtrl::Response> res) {
-    //                           res->successed = motorPosCtrl(req->position, req->duration);
-    //                       });
-
-    srv_motor_vel_ctrl_ = nh_->create_service<PosVelCurCtrl>("motor_vel_ctrl",
-                          [&] (const shared_ptr<PosVelCurCtrl::Request> req, shared_ptr<PosVelCurCtrl::Response> res) {
-                              COUT("[Service called] motor_vel_ctrl, input: " << req->velocity);
-                              res->successed = motorVelCtrl(req->velocity);
-                          });
-
-    srv_motor_cur_ctrl_ = nh_->create_service<PosVelCurCtrl>("motor_cur_ctrl",
-                          [&] (const shared_ptr<PosVelCurCtrl::Request> req, shared_ptr<PosVelCurCtrl::Response> res) {
-                              COUT("[Service called] motor_cur_ctrl, input: " << req->current);
-                              res->successed = motorCurCtrl(req->current);
-                          });
-
-    COUT("DATC ros interface init.");
-    start();
+// At the configured poll_rate; the buffer is resized when it changes
+const uint kTelemetryHistorySec = 600;
+
+// onPollCycle() is overridden here, so polling must not begin before this object is fully constructed
+DatcCommInterface::DatcCommInterface() :
+    DatcRosInterface(rclcpp::NodeOptions().append_parameter_override("autostart", false)),
+    telemetry_((size_t) (getPollRate() * kTelemetryHistorySec)),
+    telemetry_rate_(getPollRate()) {
+    qRegisterMetaType<DatcSnapshot>("DatcSnapshot");
+
+    clock_gettime(CLOCK_MONOTONIC, &time_start_);
+
+    executor_.add_node(get_node_base_interface());
+    spin_thread_ = thread([this] () {executor_.spin();});
 }
 
 DatcCommInterface::~DatcCommInterface() {
-    modbusRelease();
-}
+    // Its command handler calls into this object
+    releaseTcp();
 
-bool DatcCommInterface::init(const char *port_name, uint slave_address, int baudrate) {
-    return modbusInit(port_name, slave_address, baudrate);
-}
+    executor_.cancel();
 
-void DatcCommInterface::pubTopic() {
-    if (getConnectionState()) {
-        DatcStatus datc_status = getDatcStatus();
-        grp_control_msg::msg::GripperMsg msg;
-
-        msg.motor_position  = datc_status.motor_pos;
-        msg.motor_velocity  = datc_status.motor_vel;
-        msg.motor_current   = datc_status.motor_cur;
-        msg.finger_position = datc_status.finger_pos;
-
-        msg.motor_enabled       = datc_status.enable;
-        msg.gripper_initialized = datc_status.initialize;
-        msg.position_ctrl_mode  = datc_status.motor_pos_ctrl;
-        msg.velocity_ctrl_mode  = datc_status.motor_vel_ctrl;
-        msg.current_ctrl_mode   = datc_status.motor_cur_ctrl;
-        msg.grp_opened          = datc_status.grp_open;
-        msg.grp_closed          = datc_status.grp_close;
-        msg.motor_fault         = datc_status.fault;
-
-        publisher_grp_state_->publish(msg);
+    if (spin_thread_.joinable()) {
+        spin_thread_.join();
     }
+
+    // onPollCycle() is ours, so the poll thread has to end before this object does
+    stop();
 }
 
-// Main loop
-void DatcCommInterface::run() {
-    double period = 1 / (double) kFreq;
+DatcSnapshot DatcCommInterface::getSnapshot() {
+    DatcSnapshot snapshot;
 
-    timespec time_prev, time_current;
-    clock_gettime(CLOCK_MONOTONIC, &time_prev);
+    snapshot.status     = getDatcStatus();
+    snapshot.connected  = getConnectionState();
+    snapshot.active     = isActive();
+    snapshot.recv_err   = getModbusRecvErr();
+    snapshot.slave_addr = getSlaveAddr();
 
-    while(rclcpp::ok()) {
-        clock_gettime(CLOCK_MONOTONIC, &time_current);
+    snapshot.tcp_running = isTcpRunning();
 
-        double dt = (time_current.tv_sec - time_prev.tv_sec) + ((time_current.tv_nsec - time_prev.tv_nsec) * 0.000000001);
+    return snapshot;
+}
 
-        if(dt >= period) {
-            if (getConnectionState()) {
-                rclcpp::spin_some(nh_);
+void DatcCommInterface::onPollCycle(const timespec &time_current, bool sample_read) {
+    // Allocates, but only on a change of poll_rate
+    const double poll_rate = getPollRate();
 
-                if (mbc_.getConnectionState()) {
-                    readDatcData();
-                    pubTopic();
-                }
-            }
+    if (poll_rate != telemetry_rate_) {
+        telemetry_.setCapacity((size_t) (poll_rate * kTelemetryHistorySec));
+        telemetry_rate_ = poll_rate;
+    }
 
-            time_prev = time_current;
-        }
+    if (sample_read) {
+        double t = (time_current.tv_sec - time_start_.tv_sec) + ((time_current.tv_nsec - time_start_.tv_nsec) * 0.000000001);
+        telemetry_.push({t, status_.finger_pos / 10.0f, (float) status_.motor_cur});
     }
 
-    motorDisable();
-    modbusRelease();
+    // Only changes are sent, so an idle gripper costs the GUI thread nothing
+    DatcSnapshot snapshot = getSnapshot();
 
-    Q_EMIT rclcpp::shutdown();
+    if (snapshot != snapshot_prev_) {
+        Q_EMIT datcSnapshotUpdated(snapshot);
+        snapshot_prev_ = snapshot;
+    }
 }
 
+void DatcCommInterface::onSerialPortsChanged(const vector<string> &ports) {
+    QStringList list;
+
+    for (const auto &port : ports) {
+        list << QString::fromStdString(port);
+    }
+
+    Q_EMIT serialPortsChanged(list);
+}
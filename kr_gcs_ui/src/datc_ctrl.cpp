@@ -10,14 +10,35 @@
  */
 #include "datc_ctrl.hpp"
 
+#include <algorithm>
+#include <ctime>
+
 DatcCtrl::DatcCtrl() {
 }
 
 DatcCtrl::~DatcCtrl() {
 }
 
+// Display names of the STATUS_FLAGs
+const char *kStatusFlagNames[kStatusFlagCount] = {
+    "Motor Enable",
+    "Gripper Initialize",
+    "Motor Position Control",
+    "Motor Velocity Control",
+    "Motor Current Control",
+    "Gripper Open",
+    "Gripper Close",
+    "Motor Fault",
+};
+
 bool DatcCtrl::modbusInit(const char *port_name, uint16_t slave_address, int baudrate) {
-    return mbc_.modbusInit(port_name, slave_address, baudrate);
+    if (!mbc_.modbusInit(port_name, slave_address, baudrate)) {
+        return false;
+    }
+
+    selectRegisterMap();
+
+    return true;
 }
 
 bool DatcCtrl::modbusRelease() {
@@ -26,7 +47,41 @@ bool DatcCtrl::modbusRelease() {
 }
 
 bool DatcCtrl::modbusSlaveChange(uint16_t slave_addr) {
-    return mbc_.slaveChange(slave_addr);
+    if (!mbc_.slaveChange(slave_addr)) {
+        return false;
+    }
+
+    selectRegisterMap();
+
+    return true;
+}
+
+// Per slave: its firmware version register picks the variant, anything unknown gets the default one
+void DatcCtrl::selectRegisterMap() {
+    const RegisterMap *map = &kRegisterMaps[kRegisterMapDefault];
+    firmware_version_ = -1;
+
+    if (kVersionRegAddr >= 0) {
+        vector<uint16_t> reg;
+
+        if (!mbc_.recvData(kVersionRegAddr, 1, reg)) {
+            DATC_LOG_WARN("Firmware version unreadable, using the default register map");
+        } else {
+            firmware_version_ = reg[0];
+
+            const RegisterMap *found = findRegisterMap(reg[0]);
+
+            if (found != NULL) {
+                map = found;
+            } else {
+                DATC_LOG_WARN("No register map for firmware version %u, using the default one", reg[0]);
+            }
+        }
+    }
+
+    register_map_ = map;
+
+    DATC_LOG_INFO("Register map: %s", map->name);
 }
 
 bool DatcCtrl::motorEnable() {
@@ -44,7 +99,7 @@ bool DatcCtrl::motorDisable() {
 bool DatcCtrl::setModbusAddr(uint16_t slave_addr) {
     // TODO: modbus addr 범위 지정 필요
     if (slave_addr < 1 || slave_addr >= 100) {
-        COUT("\"setModbusAddr\" function error. Check the input slave address.");
+        DATC_LOG_ERROR("\"setModbusAddr\" function error. Check the input slave address.");
         return false;
     }
 
@@ -64,13 +119,13 @@ bool DatcCtrl::grpClose() {
 }
 
 bool DatcCtrl::setFingerPos(uint16_t finger_pos) {
-    string error_prefix = "[Set Finger Position]";
+    const char *error_prefix = "[Set Finger Position]";
 
     if (finger_pos < kFingerPosMin) {
-        printf("[Error] %s Invalid range of finger position ( < %d)\n", error_prefix.c_str(), kFingerPosMin);
+        DATC_LOG_WARN("%s Invalid range of finger position ( < %d)", error_prefix, kFingerPosMin);
         finger_pos = kFingerPosMin;
     } else if (finger_pos > kFingerPosMax) {
-        printf("[Error] %s Invalid range of finger position ( > %d)\n", error_prefix.c_str(), kFingerPosMax);
+        DATC_LOG_WARN("%s Invalid range of finger position ( > %d)", error_prefix, kFingerPosMax);
         finger_pos = kFingerPosMax;
     }
 
@@ -78,13 +133,13 @@ bool DatcCtrl::setFingerPos(uint16_t finger_pos) {
 }
 
 bool DatcCtrl::motorVelCtrl(int16_t vel) {
-    string error_prefix = "[Motor Velocity Control]";
+    const char *error_prefix = "[Motor Velocity Control]";
 
     if (abs(vel) < kVelMin) {
-        printf("[Error] %s Invalid range of speed ( < %d)\n", error_prefix.c_str(), kVelMin);
+        DATC_LOG_WARN("%s Invalid range of speed ( < %d)", error_prefix, kVelMin);
         vel = (vel >= 0) ? kVelMin : -kVelMin;
     } else if (abs(vel) > kVelMax) {
-        printf("[Error] %s Invalid range of speed ( > %d)\n", error_prefix.c_str(), kVelMax);
+        DATC_LOG_WARN("%s Invalid range of speed ( > %d)", error_prefix, kVelMax);
         vel = (vel >= 0) ? kVelMax : -kVelMax;
     }
 
@@ -92,10 +147,10 @@ bool DatcCtrl::motorVelCtrl(int16_t vel) {
 }
 
 bool DatcCtrl::motorCurCtrl(int16_t cur) {
-    string error_prefix = "[Motor Current Control]";
+    const char *error_prefix = "[Motor Current Control]";
 
     if (abs(cur) > kCurMax) {
-        printf("[Error] %s Invalid range of current ( > %d)\n", error_prefix.c_str(), kCurMax);
+        DATC_LOG_WARN("%s Invalid range of current ( > %d)", error_prefix, kCurMax);
         cur = (cur >= 0) ? kCurMax : -kCurMax;
     }
 
@@ -103,7 +158,7 @@ bool DatcCtrl::motorCurCtrl(int16_t cur) {
 }
 
 bool DatcCtrl::motorPosCtrl(int16_t pos_deg, uint16_t duration) {
-    string error_prefix = "[Motor Position Control]";
+    const char *error_prefix = "[Motor Position Control]";
     checkDurationRange(error_prefix, duration);
     return command(DATC_COMMAND::MOTOR_POSITION_CONTROL, pos_deg, duration);
 }
@@ -117,13 +172,13 @@ bool DatcCtrl::vacuumGrpOff() {
 }
 
 bool DatcCtrl::setMotorTorque(uint16_t torque_ratio) {
-    string error_prefix = "[Set Motor Torque]";
+    const char *error_prefix = "[Set Motor Torque]";
 
     if (torque_ratio < kTorqueRatioMin) {
-        printf("[Error] %s Motor torque is too low ( < %d)\n", error_prefix.c_str(), kTorqueRatioMin);
+        DATC_LOG_WARN("%s Motor torque is too low ( < %d)", error_prefix, kTorqueRatioMin);
         torque_ratio = kTorqueRatioMin;
     } else if (torque_ratio > kTorqueRatioMax) {
-        printf("[Error] %s Motor torque is too high ( > %d)\n", error_prefix.c_str(), kTorqueRatioMax);
+        DATC_LOG_WARN("%s Motor torque is too high ( > %d)", error_prefix, kTorqueRatioMax);
         torque_ratio = kTorqueRatioMax;
     }
 
@@ -131,13 +186,13 @@ bool DatcCtrl::setMotorTorque(uint16_t torque_ratio) {
 }
 
 bool DatcCtrl::setMotorSpeed (uint16_t speed_ratio) {
-    string error_prefix = "[Set Motor Speed]";
+    const char *error_prefix = "[Set Motor Speed]";
 
     if (speed_ratio < kSpeedRatioMin) {
-        printf("[Error] %s Motor torque is too low ( < %d)\n", error_prefix.c_str(), kSpeedRatioMin);
+        DATC_LOG_WARN("%s Motor torque is too low ( < %d)", error_prefix, kSpeedRatioMin);
         speed_ratio = kSpeedRatioMin;
     } else if (speed_ratio > kSpeedRatioMax) {
-        printf("[Error] %s Motor torque is too high ( > %d)\n", error_prefix.c_str(), kSpeedRatioMax);
+        DATC_LOG_WARN("%s Motor torque is too high ( > %d)", error_prefix, kSpeedRatioMax);
         speed_ratio = kSpeedRatioMax;
     }
 
@@ -145,44 +200,49 @@ bool DatcCtrl::setMotorSpeed (uint16_t speed_ratio) {
 }
 
 bool DatcCtrl::readDatcData() {
-    static map<uint16_t, pair<bool*, string>> status_info;
-
-    if (status_info.size() == 0) {
-        // Bit, Value, Status 순서
-        status_info.insert({0, make_pair(&status_.enable        , "Motor Enable")});
-        status_info.insert({1, make_pair(&status_.initialize    , "Gripper Initialize")});
-        status_info.insert({2, make_pair(&status_.motor_pos_ctrl, "Motor Position Control")});
-        status_info.insert({3, make_pair(&status_.motor_vel_ctrl, "Motor Velocity Control")});
-        status_info.insert({4, make_pair(&status_.motor_cur_ctrl, "Motor Current Control")});
-        status_info.insert({5, make_pair(&status_.grp_open      , "Gripper Open")});
-        status_info.insert({6, make_pair(&status_.grp_close     , "Gripper Close")});
-        status_info.insert({9, make_pair(&status_.fault         , "Motor Fault")});
-    }
+    const RegisterMap &map = *register_map_.load();
+
+    bool *flags[kStatusFlagCount] = {
+        &status_.enable, &status_.initialize, &status_.motor_pos_ctrl, &status_.motor_vel_ctrl,
+        &status_.motor_cur_ctrl, &status_.grp_open, &status_.grp_close, &status_.fault,
+    };
 
     // Read input register //
-    uint16_t reg_addr = 10;
-    uint16_t reg_num  = 8;
+    READ_PROFILE profile = read_profile_;
+
+    if (profile == READ_PROFILE::MIXED) {
+        profile = (read_count_ % read_full_every_ == 0) ? READ_PROFILE::FULL : READ_PROFILE::MINIMAL;
+    }
+
+    read_count_++;
+
+    const int reg_num = (profile == READ_PROFILE::FULL)    ? map.status_count :
+                        (profile == READ_PROFILE::MINIMAL) ? map.minimal_count : 1;
     vector<uint16_t> reg;
 
-    if (mbc_.recvData(reg_addr, reg_num, reg)) {
+    // Registers outside this read, or that the variant does not have, keep their value
+    auto regAt = [&reg, reg_num] (int8_t offset, uint16_t fallback) {
+        return (offset >= 0 && offset < reg_num) ? reg[offset] : fallback;
+    };
+
+    if (mbc_.recvData(map.status_addr, reg_num, reg)) {
+        last_read_count_ = reg_num;
+
         uint16_t status    = reg[0];
         status_.states     = status;
-        status_.motor_pos  = (int16_t) reg[1];
-        status_.motor_cur  = (int16_t) reg[2];
-        status_.motor_vel  = (int16_t) reg[3];
-        status_.finger_pos = reg[4];
-        status_.voltage    = reg[7];
+        status_.motor_pos  = (int16_t) regAt(map.motor_pos, status_.motor_pos);
+        status_.motor_cur  = (int16_t) regAt(map.motor_cur, status_.motor_cur);
+        status_.motor_vel  = (int16_t) regAt(map.motor_vel, status_.motor_vel);
+        status_.finger_pos = regAt(map.finger_pos, status_.finger_pos);
+        status_.voltage    = regAt(map.voltage, status_.voltage);
 
         status_.status_str = "---";
 
-        for (int i = 0; i < 16; i++) {
-            if (status_info.find(i) != status_info.end()) {
-                if (status & (0x01 << i)) {
-                    *status_info[i].first = true;
-                    status_.status_str = status_info[i].second;
-                } else {
-                    *status_info[i].first = false;
-                }
+        for (size_t i = 0; i < kStatusFlagCount; i++) {
+            *flags[i] = map.bits[i] >= 0 && (status & (0x01 << map.bits[i]));
+
+            if (*flags[i]) {
+                status_.status_str = kStatusFlagNames[i];
             }
         }
 
@@ -190,6 +250,8 @@ bool DatcCtrl::readDatcData() {
             status_.status_str = "Motor Disabled";
         }
 
+        DATC_TRACE(status_sample, status_.states, status_.motor_vel, status_.finger_pos);
+
         flag_modbus_recv_err_ = false;
         return true;
     } else {
@@ -198,13 +260,13 @@ bool DatcCtrl::readDatcData() {
     }
 }
 
-bool DatcCtrl::checkDurationRange(string error_prefix, uint16_t &duration) {
+bool DatcCtrl::checkDurationRange(const char *error_prefix, uint16_t &duration) {
     if (duration < kDurationMin) {
-        printf("[Error] %s Duration is too short ( < %dms)\n", error_prefix.c_str(), kDurationMin);
+        DATC_LOG_WARN("%s Duration is too short ( < %dms)", error_prefix, kDurationMin);
         duration = kDurationMin;
         return false;
     } else if (duration > kDurationMax) {
-        printf("[Error] %s Duration is too long ( > %dms)\n", error_prefix.c_str(), kDurationMax);
+        DATC_LOG_WARN("%s Duration is too long ( > %dms)", error_prefix, kDurationMax);
         duration = kDurationMax;
         return false;
     }
@@ -212,7 +274,68 @@ bool DatcCtrl::checkDurationRange(string error_prefix, uint16_t &duration) {
     return true;
 }
 
+bool DatcCtrl::commandByCode(uint16_t code, int16_t value_1, int16_t value_2) {
+    switch ((DATC_COMMAND) code) {
+        case DATC_COMMAND::MOTOR_ENABLE:           return motorEnable();
+        case DATC_COMMAND::MOTOR_STOP:             return motorStop();
+        case DATC_COMMAND::MOTOR_DISABLE:          return motorDisable();
+        case DATC_COMMAND::MOTOR_POSITION_CONTROL: return motorPosCtrl(value_1, (uint16_t) value_2);
+        case DATC_COMMAND::MOTOR_VELOCITY_CONTROL: return motorVelCtrl(value_1);
+        case DATC_COMMAND::MOTOR_CURRENT_CONTROL:  return motorCurCtrl(value_1);
+        case DATC_COMMAND::CHANGE_MODBUS_ADDRESS:  return setModbusAddr((uint16_t) value_1);
+        case DATC_COMMAND::GRIPPER_INITIALIZE:     return grpInitialize();
+        case DATC_COMMAND::GRIPPER_OPEN:           return grpOpen();
+        case DATC_COMMAND::GRIPPER_CLOSE:          return grpClose();
+        case DATC_COMMAND::SET_FINGER_POSITION:    return setFingerPos((uint16_t) value_1);
+        case DATC_COMMAND::VACUUM_GRIPPER_ON:      return vacuumGrpOn();
+        case DATC_COMMAND::VACUUM_GRIPPER_OFF:     return vacuumGrpOff();
+        case DATC_COMMAND::IMPEDANCE_ON:           return impedanceOn();
+        case DATC_COMMAND::IMPEDANCE_OFF:          return impedanceOff();
+        case DATC_COMMAND::SET_IMPEDANCE_PARAMS:   return setImpedanceParams(value_1, value_2);
+        case DATC_COMMAND::SET_MOTOR_TORQUE:       return setMotorTorque((uint16_t) value_1);
+        case DATC_COMMAND::SET_MOTOR_SPEED:        return setMotorSpeed((uint16_t) value_1);
+
+        default:
+            DATC_LOG_ERROR("Undefined command %u", code);
+            return false;
+    }
+}
+
+bool DatcCtrl::isCommandCode(uint16_t code) {
+    switch ((DATC_COMMAND) code) {
+        case DATC_COMMAND::MOTOR_ENABLE:
+        case DATC_COMMAND::MOTOR_STOP:
+        case DATC_COMMAND::MOTOR_DISABLE:
+        case DATC_COMMAND::MOTOR_POSITION_CONTROL:
+        case DATC_COMMAND::MOTOR_VELOCITY_CONTROL:
+        case DATC_COMMAND::MOTOR_CURRENT_CONTROL:
+        case DATC_COMMAND::CHANGE_MODBUS_ADDRESS:
+        case DATC_COMMAND::GRIPPER_INITIALIZE:
+        case DATC_COMMAND::GRIPPER_OPEN:
+        case DATC_COMMAND::GRIPPER_CLOSE:
+        case DATC_COMMAND::SET_FINGER_POSITION:
+        case DATC_COMMAND::VACUUM_GRIPPER_ON:
+        case DATC_COMMAND::VACUUM_GRIPPER_OFF:
+        case DATC_COMMAND::IMPEDANCE_ON:
+        case DATC_COMMAND::IMPEDANCE_OFF:
+        case DATC_COMMAND::SET_IMPEDANCE_PARAMS:
+        case DATC_COMMAND::SET_MOTOR_TORQUE:
+        case DATC_COMMAND::SET_MOTOR_SPEED:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
 bool DatcCtrl::command(DATC_COMMAND cmd, uint16_t value_1, uint16_t value_2) {
+    timespec time_command;
+    clock_gettime(CLOCK_MONOTONIC, &time_command);
+
+    last_command_ns_   = time_command.tv_sec * 1000000000L + time_command.tv_nsec;
+    last_command_code_ = (uint16_t) cmd;
+    command_count_++;
+
     switch (cmd) {
         case DATC_COMMAND::MOTOR_ENABLE:
             return SEND_CMD(cmd);
@@ -269,7 +392,7 @@ bool DatcCtrl::command(DATC_COMMAND cmd, uint16_t value_1, uint16_t value_2) {
             return SEND_CMD_VECTOR(vector<uint16_t> ({(uint16_t) cmd, value_1}));
 
         default:
-            COUT("Error: Undefined command.");
+            DATC_LOG_ERROR("Undefined command.");
             return false;
     }
 }
@@ -284,23 +407,219 @@ bool DatcCtrl::impedanceOff() {
 }
 
 bool DatcCtrl::setImpedanceParams(int16_t slave_num, int16_t stiffness_level) {
-    string error_prefix = "[Set Impedance M]";
+    const char *error_prefix = "[Set Impedance M]";
 
     if (slave_num < 1) {
-        printf("[Error] %s slave_num is too small ( < %d)\n", error_prefix.c_str(), 1);
+        DATC_LOG_WARN("%s slave_num is too small ( < %d)", error_prefix, 1);
         slave_num = 1;
     } else if (slave_num > 100) {
-        printf("[Error] %s slave_num is too large ( > %d)\n", error_prefix.c_str(), 100);
+        DATC_LOG_WARN("%s slave_num is too large ( > %d)", error_prefix, 100);
         slave_num = 100;
     }
 
     if (stiffness_level < 1) {
-        printf("[Error] %s stiffness_level is too small ( < %d)\n", error_prefix.c_str(), 1);
+        DATC_LOG_WARN("%s stiffness_level is too small ( < %d)", error_prefix, 1);
         stiffness_level = 1;
     } else if (stiffness_level > 10) {
-        printf("[Error] %s stiffness_level is too large ( > %d)\n", error_prefix.c_str(), 10);
+        DATC_LOG_WARN("%s stiffness_level is too large ( > %d)", error_prefix, 10);
         stiffness_level = 10;
     }
 
     return command(DATC_COMMAND::SET_IMPEDANCE_PARAMS, slave_num, stiffness_level);
 }
+
+void DatcCtrl::setReadProfile(READ_PROFILE profile, int full_every) {
+    read_full_every_ = std::max(2, full_every);
+    read_profile_    = profile;
+}
+
+bool DatcCtrl::parseReadProfile(const string &str, READ_PROFILE &profile) {
+    if (str == "full") {
+        profile = READ_PROFILE::FULL;
+    } else if (str == "minimal") {
+        profile = READ_PROFILE::MINIMAL;
+    } else if (str == "status") {
+        profile = READ_PROFILE::STATUS;
+    } else if (str == "mixed") {
+        profile = READ_PROFILE::MIXED;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+const char *DatcCtrl::getReadProfileName(READ_PROFILE profile) {
+    switch (profile) {
+        case READ_PROFILE::MINIMAL: return "minimal";
+        case READ_PROFILE::STATUS:  return "status";
+        case READ_PROFILE::MIXED:   return "mixed";
+        default:                    return "full";
+    }
+}
+
+double DatcCtrl::estimateReadTimeUs(READ_PROFILE profile, int full_every, int baudrate, const RegisterMap &map) {
+    auto transaction = [baudrate] (int reg_num) {
+        const double char_us    = 10 * 1e6 / baudrate;
+        const double silence_us = (baudrate > 19200) ? 1750 : 3.5 * char_us; // Fixed above 19200 bps
+
+        // FC03 request 8 bytes, response 5 + 2n bytes
+        return (8 + 5 + 2 * reg_num) * char_us + 2 * silence_us;
+    };
+
+    switch (profile) {
+        case READ_PROFILE::MINIMAL: return transaction(map.minimal_count);
+        case READ_PROFILE::STATUS:  return transaction(1);
+        case READ_PROFILE::MIXED:
+            full_every = std::max(2, full_every);
+            return (transaction(map.status_count) + (full_every - 1) * transaction(map.minimal_count)) / full_every;
+        default:                    return transaction(map.status_count);
+    }
+}
+
+bool DatcCtrl::startSequence(const vector<SequenceStep> &steps, uint64_t &id, string &error) {
+    error = checkSequence(steps);
+
+    for (size_t i = 0; i < steps.size() && error.empty(); i++) {
+        if (steps[i].type == SEQUENCE_STEP::COMMAND && !isCommandCode(steps[i].command)) {
+            error = "Step " + to_string(i) + ": undefined command " + to_string(steps[i].command);
+        }
+    }
+
+    if (!error.empty()) {
+        return false;
+    }
+
+    unique_lock<mutex> lg(sequence_mutex_);
+
+    if (sequence_progress_.state == SEQUENCE_STATE::RUNNING) {
+        error = "Sequence #" + to_string(sequence_progress_.id) + " is still running";
+        return false;
+    }
+
+    sequence_ = steps;
+
+    sequence_progress_ = SequenceProgress();
+    sequence_progress_.id    = sequence_next_id_++;
+    sequence_progress_.state = SEQUENCE_STATE::RUNNING;
+    sequence_progress_.steps = steps.size();
+
+    sequence_start_ns_    = -1;
+    step_start_ns_        = -1;
+    sequence_deadline_ns_ = 0;
+
+    id = sequence_progress_.id;
+
+    return true;
+}
+
+void DatcCtrl::cancelSequence(const string &reason) {
+    unique_lock<mutex> lg(sequence_mutex_);
+
+    if (sequence_progress_.state == SEQUENCE_STATE::RUNNING) {
+        timespec time_current;
+        clock_gettime(CLOCK_MONOTONIC, &time_current);
+
+        finishSequence(SEQUENCE_STATE::CANCELED, reason, time_current.tv_sec * 1000000000L + time_current.tv_nsec);
+    }
+}
+
+SequenceProgress DatcCtrl::getSequenceProgress() {
+    unique_lock<mutex> lg(sequence_mutex_);
+    return sequence_progress_;
+}
+
+// sequence_mutex_ held
+void DatcCtrl::finishSequence(SEQUENCE_STATE state, const string &message, int64_t time_ns) {
+    sequence_progress_.state      = state;
+    sequence_progress_.message    = message;
+    sequence_progress_.elapsed_ns = (sequence_start_ns_ < 0) ? 0 : time_ns - sequence_start_ns_;
+
+    sequence_.clear();
+    sequence_deadline_ns_ = 0;
+}
+
+// Runs as many steps as are due. A step's time starts when it is entered, so a delay or timeout after a
+// command counts from the end of that command's transaction.
+void DatcCtrl::stepSequence(int64_t time_ns, bool sample_read) {
+    unique_lock<mutex> lg(sequence_mutex_);
+
+    if (sequence_progress_.state != SEQUENCE_STATE::RUNNING) {
+        return;
+    }
+
+    if (sequence_start_ns_ < 0) {
+        sequence_start_ns_   = time_ns;
+        sequence_fault_prev_ = status_.fault;
+    }
+
+    // A fault that comes up during the sequence ends it, unless the sequence is waiting for it
+    if (sample_read) {
+        const SequenceStep &step = sequence_[sequence_progress_.step];
+        const bool fault_rose    = status_.fault && !sequence_fault_prev_;
+
+        sequence_fault_prev_ = status_.fault;
+
+        if (fault_rose && !(step.type == SEQUENCE_STEP::WAIT_STATE && step.flag == STATUS_FLAG::FAULT)) {
+            finishSequence(SEQUENCE_STATE::FAILED, "Motor fault at step " + to_string(sequence_progress_.step), time_ns);
+            return;
+        }
+    }
+
+    while (sequence_progress_.step < sequence_.size()) {
+        const SequenceStep &step = sequence_[sequence_progress_.step];
+        const bool entered = step_start_ns_ < 0;
+        bool done = false;
+
+        if (entered) {
+            step_start_ns_ = time_ns;
+        }
+
+        switch (step.type) {
+            case SEQUENCE_STEP::COMMAND: {
+                if (!commandByCode(step.command, step.value_1, step.value_2)) {
+                    finishSequence(SEQUENCE_STATE::FAILED, "Step " + to_string(sequence_progress_.step) + ": " +
+                                   step.describe() + " failed", time_ns);
+                    return;
+                }
+
+                timespec time_sent;
+                clock_gettime(CLOCK_MONOTONIC, &time_sent);
+                time_ns = time_sent.tv_sec * 1000000000L + time_sent.tv_nsec;
+
+                done = true;
+                break;
+            }
+
+            case SEQUENCE_STEP::DELAY: {
+                const int64_t deadline_ns = step_start_ns_ + step.delay_ms * 1000000L;
+
+                done = time_ns >= deadline_ns;
+                sequence_deadline_ns_ = done ? 0 : deadline_ns;
+                break;
+            }
+
+            case SEQUENCE_STEP::WAIT_STATE:
+                // The sample this step was entered with may predate the command before it
+                done = !entered && sample_read && status_.getFlag(step.flag) == step.value;
+
+                if (!done && time_ns - step_start_ns_ >= step.timeout_ms * 1000000L) {
+                    finishSequence(SEQUENCE_STATE::FAILED, "Step " + to_string(sequence_progress_.step) + ": " +
+                                   step.describe() + " timed out", time_ns);
+                    return;
+                }
+
+                break;
+        }
+
+        if (!done) {
+            sequence_progress_.elapsed_ns = time_ns - sequence_start_ns_;
+            return;
+        }
+
+        sequence_progress_.step++;
+        step_start_ns_ = -1;
+    }
+
+    finishSequence(SEQUENCE_STATE::SUCCEEDED, "", time_ns);
+}
@@ -0,0 +1,2024 @@
+/**
+ * @file datc_ros_interface.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "datc_ros_interface.hpp"
+#include "process_stats.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <sys/stat.h>
+#include <rclcpp_components/register_node_macro.hpp>
+
+const int kReconnectTries      = 10;
+const int kReconnectIntervalMs = 500; // udev needs a moment to set the permissions of a new node
+
+const size_t kLatencyReportCycles = 1000; // Wakeup latency percentiles are logged once after this many cycles
+
+const double kPollRateMax = 500;
+
+const double kEstimatorRateMax      = 2000;
+const double kEstimatorLeadMaxMs    = 1000;
+const double kEstimatorMaxAgePeriods = 3;   // No estimate once the last sample is older than this many poll periods
+const int    kEstimatorIdleMs       = 100;
+
+const int kSequenceWaitPollMs = 2; // runSequence()
+
+const int kHealthIdleMs = 100; // Health thread: slave changes are picked up within this long
+
+static int64_t getMonotonicNs() {
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec * 1000000000L + time.tv_nsec;
+}
+
+DatcRosInterface::DatcRosInterface(const rclcpp::NodeOptions &options) :
+    rclcpp_lifecycle::LifecycleNode("DATC_Control_Interface", options), latency_(kLatencyReportCycles) {
+    declareLogParameters();
+
+    // Rates & QoS, reconfigurable at runtime
+    poll_rate_       = declare_parameter<double>("poll_rate", kPollRateDefault);
+    publish_rate_    = declare_parameter<double>("publish_rate", kPollRateDefault);
+    qos_reliability_ = declare_parameter<string>("qos.reliability", "reliable");
+    qos_depth_       = declare_parameter<int>("qos.depth", 10);
+
+    // Status registers read per poll, reconfigurable at runtime
+    read_profile_name_ = declare_parameter<string>("read.profile", "full");
+    read_full_every_   = declare_parameter<int>("read.full_every", 10);
+
+    READ_PROFILE read_profile;
+
+    if (!parseReadProfile(read_profile_name_, read_profile) || read_full_every_ < 2) {
+        RCLCPP_ERROR(get_logger(), "read.profile must be full, minimal, status or mixed and read.full_every at least 2, "
+                     "using full");
+        read_profile_name_ = "full";
+        read_full_every_   = 10;
+        read_profile       = READ_PROFILE::FULL;
+    }
+
+    setReadProfile(read_profile, (int) read_full_every_);
+
+    statistics_enabled_   = declare_parameter<bool>("statistics.enable", false);
+    statistics_period_ms_ = declare_parameter<int>("statistics.period_ms", 1000);
+
+    rcl_interfaces::msg::SetParametersResult check = checkRateQos(poll_rate_, publish_rate_, qos_reliability_, qos_depth_);
+
+    if (!check.successful) {
+        RCLCPP_ERROR(get_logger(), "%s, using the defaults", check.reason.c_str());
+
+        poll_rate_       = kPollRateDefault;
+        publish_rate_    = kPollRateDefault;
+        qos_reliability_ = "reliable";
+        qos_depth_       = 10;
+    }
+
+    publish_decimation_ = getDecimation(poll_rate_, publish_rate_);
+
+    // Publisher
+    createStatePublisher();
+
+    // Same message as ROS 2 topic statistics (which only exist on the subscription side): the period
+    // between grp_state messages, measured where they are published
+    publisher_statistics_ = create_publisher<MetricsMessage> ("statistics", 10);
+
+    publisher_grasp_event_ = create_publisher<GraspEvent> ("grasp_event", 10);
+
+    publisher_estimate_ = create_publisher<GripperEstimate> ("grp_state_estimate", 10);
+
+    // Latched: a late subscriber gets the last transition, whose sample holds the current flags
+    publisher_state_transition_ = create_publisher<StateTransition> ("grp_state_transition",
+                                                                     rclcpp::QoS(1).reliable().transient_local());
+
+    // Latched as well, it is published every health.publish_period_s only
+    publisher_health_ = create_publisher<GripperHealth> ("grp_health", rclcpp::QoS(1).reliable().transient_local());
+
+    // Server
+    // srv_modbus_init_release_ = create_service<SingleBoolean>("modbus_init_release",
+    //                            [this] (const shared_ptr<SingleBoolean::Request> req, shared_ptr<SingleBoolean::Response> res) {
+    //                                req;
+    //                            });
+
+    srv_motor_enable_ = create_service<Void>("motor_enable",
+                        [this] (const shared_ptr<Void::Request> req, shared_ptr<Void::Response> res) {
+                            DATC_TRACE(service_entry, "motor_enable");
+                            DATC_LOG_INFO("[Service called] motor_enable");
+                            res->successed = acceptCommand("motor_enable") && motorEnable();
+                            DATC_TRACE(service_exit, "motor_enable", res->successed);
+                        });
+
+    // Disable and stop are accepted in any state, the rest only while active
+    srv_motor_disable_ = create_service<Void>("motor_disable",
+                         [this] (const shared_ptr<Void::Request> req, shared_ptr<Void::Response> res) {
+                             DATC_TRACE(service_entry, "motor_disable");
+                             DATC_LOG_INFO("[Service called] motor_disable");
+                             res->successed = motorDisable();
+                             DATC_TRACE(service_exit, "motor_disable", res->successed);
+                         });
+
+    srv_modbus_slave_change_ = create_service<SingleInt>("modbus_slave_change",
+                               [this] (const shared_ptr<SingleInt::Request> req, shared_ptr<SingleInt::Response> res) {
+                                   DATC_TRACE(service_entry, "modbus_slave_change");
+                                   DATC_LOG_INFO("[Service called] modbus_slave_change, input: %u", (uint) req->value);
+                                   res->successed = acceptCommand("modbus_slave_change") && modbusSlaveChange((uint) req->value);
+                                   DATC_TRACE(service_exit, "modbus_slave_change", res->successed);
+                               });
+
+    srv_set_modbus_addr_ = create_service<SingleInt>("set_modbus_addr",
+                           [this] (const shared_ptr<SingleInt::Request> req, shared_ptr<SingleInt::Response> res) {
+                               DATC_TRACE(service_entry, "set_modbus_addr");
+                               DATC_LOG_INFO("[Service called] set_modbus_addr, input: %u", (uint) req->value);
+                               res->successed = acceptCommand("set_modbus_addr") && setModbusAddr((uint) req->value);
+                               DATC_TRACE(service_exit, "set_modbus_addr", res->successed);
+                           });
+
+    srv_set_finger_pos_ = create_service<SingleInt>("set_finger_pos",
+                          [this] (const shared_ptr<SingleInt::Request> req, shared_ptr<SingleInt::Response> res) {
+                              DATC_TRACE(service_entry, "set_finger_pos");
+                              DATC_LOG_INFO("[Service called] set_finger_pos, input: %u", (uint) req->value);
+                              res->successed = acceptCommand("set_finger_pos") && setFingerPos((uint) req->value);
+                              DATC_TRACE(service_exit, "set_finger_pos", res->successed);
+                          });
+
+    srv_set_motor_torque_ = create_service<SingleInt>("set_motor_torque",
+                            [this] (const shared_ptr<SingleInt::Request> req, shared_ptr<SingleInt::Response> res) {
+                                DATC_TRACE(service_entry, "set_motor_torque");
+                                DATC_LOG_INFO("[Service called] set_motor_torque, input: %u", (uint) req->value);
+                                res->successed = acceptCommand("set_motor_torque") && setMotorTorque((uint) req->value);
+                                DATC_TRACE(service_exit, "set_motor_torque", res->successed);
+                            });
+
+    srv_set_motor_speed_ = create_service<SingleInt>("set_motor_speed",
+                           [this] (const shared_ptr<SingleInt::Request> req, shared_ptr<SingleInt::Response> res) {
+                               DATC_TRACE(service_entry, "set_motor_speed");
+                               DATC_LOG_INFO("[Service called] set_motor_speed, input: %u", (uint) req->value);
+                               res->successed = acceptCommand("set_motor_speed") && setMotorSpeed((uint) req->value);
+                               DATC_TRACE(service_exit, "set_motor_speed", res->successed);
+                           });
+
+    srv_motor_stop_ = create_service<Void>("motor_stop",
+                      [this] (const shared_ptr<Void::Request> req, shared_ptr<Void::Response> res) {
+                          DATC_TRACE(service_entry, "motor_stop");
+                          DATC_LOG_INFO("[Service called] motor_stop");
+                          res->successed = motorStop();
+                          DATC_TRACE(service_exit, "motor_stop", res->successed);
+                      });
+
+    srv_grp_initialize_ = create_service<Void>("gripper_initialize",
+                          [this] (const shared_ptr<Void::Request> req, shared_ptr<Void::Response> res) {
+                              DATC_TRACE(service_entry, "gripper_initialize");
+                              DATC_LOG_INFO("[Service called] gripper_initialize");
+                              res->successed = acceptCommand("gripper_initialize") && grpInitialize();
+                              DATC_TRACE(service_exit, "gripper_initialize", res->successed);
+                          });
+
+    srv_grp_open_ = create_service<Void>("grp_open",
+                    [this] (const shared_ptr<Void::Request> req, shared_ptr<Void::Response> res) {
+                        DATC_TRACE(service_entry, "grp_open");
+                        DATC_LOG_INFO("[Service called] grp_open");
+                        res->successed = acceptCommand("grp_open") && grpOpen();
+                        DATC_TRACE(service_exit, "grp_open", res->successed);
+                    });
+
+    srv_grp_close_ = create_service<Void>("grp_close",
+                     [this] (const shared_ptr<Void::Request> req, shared_ptr<Void::Response> res) {
+                         DATC_TRACE(service_entry, "grp_close");
+                         DATC_LOG_INFO("[Service called] grp_close");
+                         res->successed = acceptCommand("grp_close") && grpClose();
+                         DATC_TRACE(service_exit, "grp_close", res->successed);
+                     });
+
+    srv_vacuum_grp_on_ = create_service<Void>("vacuum_grp_on",
+                         [this] (const shared_ptr<Void::Request> req, shared_ptr<Void::Response> res) {
+                             DATC_TRACE(service_entry, "vacuum_grp_on");
+                             DATC_LOG_INFO("[Service called] vacuum_grp_on");
+                             res->successed = acceptCommand("vacuum_grp_on") && vacuumGrpOn();
+                             DATC_TRACE(service_exit, "vacuum_grp_on", res->successed);
+                         });
+
+    srv_vacuum_grp_off_ = create_service<Void>("vacuum_grp_off",
+                          [this] (const shared_ptr<Void::Request> req, shared_ptr<Void::Response> res) {
+                              DATC_TRACE(service_entry, "vacuum_grp_off");
+                              DATC_LOG_INFO("[Service called] vacuum_grp_off");
+                              res->successed = acceptCommand("vacuum_grp_off") && vacuumGrpOff();
+                              DATC_TRACE(service_exit, "vacuum_grp_off", res->successed);
+                          });
+
+    // srv_motor_pos_ctrl_ = create_service<PosVelCurCtrl>("motor_pos_ctrl",
+    //                       [this] (const shared_ptr<PosVelCurCtrl::Request> req, shared_ptr<PosVelCurCtrl::Response> res) {
+    //                           res->successed = motorPosCtrl(req->position, req->duration);
+    //                       });
+
+    srv_motor_vel_ctrl_ = create_service<PosVelCurCtrl>("motor_vel_ctrl",
+                          [this] (const shared_ptr<PosVelCurCtrl::Request> req, shared_ptr<PosVelCurCtrl::Response> res) {
+                              DATC_TRACE(service_entry, "motor_vel_ctrl");
+                              DATC_LOG_INFO("[Service called] motor_vel_ctrl, input: %d", (int) req->velocity);
+                              res->successed = acceptCommand("motor_vel_ctrl") && motorVelCtrl(req->velocity);
+                              DATC_TRACE(service_exit, "motor_vel_ctrl", res->successed);
+                          });
+
+    srv_motor_cur_ctrl_ = create_service<PosVelCurCtrl>("motor_cur_ctrl",
+                          [this] (const shared_ptr<PosVelCurCtrl::Request> req, shared_ptr<PosVelCurCtrl::Response> res) {
+                              DATC_TRACE(service_entry, "motor_cur_ctrl");
+                              DATC_LOG_INFO("[Service called] motor_cur_ctrl, input: %d", (int) req->current);
+                              res->successed = acceptCommand("motor_cur_ctrl") && motorCurCtrl(req->current);
+                              DATC_TRACE(service_exit, "motor_cur_ctrl", res->successed);
+                          });
+
+    // Also while inactive: the counters are kept across deactivation
+    srv_get_health_ = create_service<GetHealth>("get_health",
+                      [this] (const shared_ptr<GetHealth::Request> req, shared_ptr<GetHealth::Response> res) {
+                          DATC_LOG_INFO("[Service called] get_health, reset_window: %d", (int) req->reset_window);
+
+                          HealthSummary summary;
+                          uint slave;
+
+                          {
+                              unique_lock<mutex> lg(health_mutex_);
+
+                              summary = health_.summarize(getMonotonicNs());
+                              slave   = health_slave_;
+
+                              if (req->reset_window) {
+                                  health_.clearWindow();
+                              }
+                          }
+
+                          toHealthMsg(summary, slave, res->health);
+                          res->successed = health_enabled_ && slave != 0;
+                      });
+
+    // Command sequences, e.g. tool change: run on the poll thread, so waits end on the sample that shows
+    // the state and delays on their deadline
+    action_run_sequence_ = rclcpp_action::create_server<RunSequence>(this, "run_sequence",
+                           [this] (const rclcpp_action::GoalUUID &, shared_ptr<const RunSequence::Goal> goal) {
+                               vector<SequenceStep> steps;
+                               string error;
+
+                               if (!acceptCommand("run_sequence")) {
+                                   return rclcpp_action::GoalResponse::REJECT;
+                               }
+
+                               if (!toSequenceSteps(*goal, steps, error)) {
+                                   DATC_LOG_WARN("run_sequence %s rejected: %s", goal->name.c_str(), error.c_str());
+                                   return rclcpp_action::GoalResponse::REJECT;
+                               }
+
+                               unique_lock<mutex> lg(sequence_goal_mutex_);
+
+                               if (sequence_goal_ || getSequenceProgress().state == SEQUENCE_STATE::RUNNING) {
+                                   DATC_LOG_WARN("run_sequence %s rejected: a sequence is running", goal->name.c_str());
+                                   return rclcpp_action::GoalResponse::REJECT;
+                               }
+
+                               return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+                           },
+                           [] (const shared_ptr<SequenceGoalHandle>) {
+                               return rclcpp_action::CancelResponse::ACCEPT;
+                           },
+                           [this] (const shared_ptr<SequenceGoalHandle> goal_handle) {
+                               acceptSequenceGoal(goal_handle);
+                           });
+
+    // Read by configure
+    const string port = declare_parameter<string>("port", "");
+    declare_parameter<int>("slave_address", 1);
+    declare_parameter<int>("baudrate", 115200);
+
+    // Real-time profile of the poll thread (all off by default)
+    rt_profile_.policy        = declare_parameter<string>("rt.policy", "other");
+    rt_profile_.priority      = declare_parameter<int>("rt.priority", 80);
+    rt_profile_.isolated_core = declare_parameter<bool>("rt.isolated_core", false);
+    rt_profile_.lock_memory   = declare_parameter<bool>("rt.lock_memory", false);
+
+    for (auto cpu : declare_parameter<vector<int64_t>>("rt.cpus", vector<int64_t>())) {
+        rt_profile_.cpus.push_back((int) cpu);
+    }
+
+    declareGraspParameters();
+    declareEstimatorParameters();
+    declareHealthParameters();
+
+    // Shared-memory status channel, off unless named
+    const string shm_name = declare_parameter<string>("shm.name", "");
+
+    if (!shm_name.empty()) {
+        string error;
+
+        if (shm_writer_.open(shm_name, error)) {
+            RCLCPP_INFO(get_logger(), "Status shared memory: /dev/shm%s", shm_name.c_str());
+        } else {
+            RCLCPP_ERROR(get_logger(), "Status shared memory %s: %s", shm_name.c_str(), error.c_str());
+        }
+    }
+
+    // TCP bridge, off unless given a port
+    const string tcp_address = declare_parameter<string>("tcp.address", "0.0.0.0");
+    const int tcp_port       = declare_parameter<int>("tcp.port", 0);
+    tcp_send_status_         = declare_parameter<bool>("tcp.send_status", true);
+
+    if (tcp_port < 0 || tcp_port > 65535) {
+        RCLCPP_ERROR(get_logger(), "Invalid tcp.port %d", tcp_port);
+    } else if (tcp_port > 0) {
+        initTcp(tcp_address, (uint16_t) tcp_port);
+    }
+
+    // A component has no owner that would call start(), so it polls on its own by default
+    const bool autostart     = declare_parameter<bool>("autostart", true);
+
+    // Without a lifecycle manager, a node given a port brings itself up as before
+    const bool auto_activate = declare_parameter<bool>("auto_activate", true);
+
+    // After all declarations: declare_parameter runs this callback too, and it rejects the startup-only ones
+    param_callback_handle_ = add_on_set_parameters_callback([this] (const vector<rclcpp::Parameter> &params) {
+        return onSetParameters(params);
+    });
+
+    if (!port.empty() && auto_activate) {
+        if (configure().id() == lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE) {
+            activate();
+        }
+    }
+
+    if (autostart) {
+        start();
+    }
+
+    DATC_LOG_INFO("DATC ros interface init.");
+}
+
+DatcRosInterface::~DatcRosInterface() {
+    // Its command handler calls into this object
+    releaseTcp();
+    stop();
+
+    // The sink holds a copy of the logger, but later lines would carry the name of a node that is gone.
+    // Only this node's sink is removed; the others in the process keep theirs.
+    AsyncLogger::instance().flush();
+    AsyncLogger::instance().setSink(this, LogSink());
+}
+
+bool DatcRosInterface::init(const char *port_name, uint slave_address, int baudrate) {
+    first_sample_traced_ = false;
+
+    if (!modbusInit(port_name, slave_address, baudrate)) {
+        return false;
+    }
+
+    unique_lock<mutex> lg(port_mutex_);
+
+    port_name_     = port_name;
+    port_stable_   = SerialPortWatcher::getStablePath(port_name_);
+    slave_address_ = slave_address;
+    baudrate_      = baudrate;
+
+    return true;
+}
+
+bool DatcRosInterface::bringUp(const string &port_name, uint slave_address, int baudrate) {
+    // A new port or slave needs a new configuration
+    if (!bringDown()) {
+        return false;
+    }
+
+    set_parameters({rclcpp::Parameter("port", port_name),
+                    rclcpp::Parameter("slave_address", (int) slave_address),
+                    rclcpp::Parameter("baudrate", baudrate)});
+
+    if (configure().id() != lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE) {
+        return false;
+    }
+
+    return activate().id() == lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE;
+}
+
+bool DatcRosInterface::bringDown() {
+    if (get_current_state().id() == lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE) {
+        deactivate();
+    }
+
+    if (get_current_state().id() == lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE) {
+        cleanup();
+    }
+
+    return get_current_state().id() == lifecycle_msgs::msg::State::PRIMARY_STATE_UNCONFIGURED;
+}
+
+bool DatcRosInterface::acceptCommand(const char *name) {
+    if (!active_) {
+        DATC_LOG_WARN("%s rejected: the interface is not active", name);
+        return false;
+    }
+
+    return true;
+}
+
+DatcRosInterface::CallbackReturn DatcRosInterface::on_configure(const rclcpp_lifecycle::State &) {
+    const string port       = get_parameter("port").as_string();
+    const int slave_address = get_parameter("slave_address").as_int();
+    const int baudrate      = get_parameter("baudrate").as_int();
+
+    if (port.empty()) {
+        RCLCPP_ERROR(get_logger(), "Cannot configure without the port parameter");
+        return CallbackReturn::FAILURE;
+    }
+
+    if (!init(port.c_str(), slave_address, baudrate)) {
+        RCLCPP_ERROR(get_logger(), "Failed to open %s (%d bps)", port.c_str(), baudrate);
+        return CallbackReturn::FAILURE;
+    }
+
+    // An open port says nothing about the gripper behind it. The poll thread does not read while
+    // inactive, so the bus is ours here.
+    if (!readDatcData()) {
+        RCLCPP_ERROR(get_logger(), "No answer from slave #%d on %s (%d bps)", slave_address, port.c_str(), baudrate);
+        modbusRelease();
+        return CallbackReturn::FAILURE;
+    }
+
+    configured_ = true;
+
+    RCLCPP_INFO(get_logger(), "Connected to %s (slave #%d, %d bps)", port.c_str(), slave_address, baudrate);
+    logReadProfile(baudrate);
+
+    return CallbackReturn::SUCCESS;
+}
+
+DatcRosInterface::CallbackReturn DatcRosInterface::on_activate(const rclcpp_lifecycle::State &) {
+    unique_lock<mutex> lg(publisher_mutex_);
+
+    publisher_grp_state_->on_activate();
+    publisher_statistics_->on_activate();
+    publisher_grasp_event_->on_activate();
+    publisher_estimate_->on_activate();
+    publisher_state_transition_->on_activate();
+    publisher_health_->on_activate();
+    active_ = true;
+
+    return CallbackReturn::SUCCESS;
+}
+
+DatcRosInterface::CallbackReturn DatcRosInterface::on_deactivate(const rclcpp_lifecycle::State &) {
+    unique_lock<mutex> lg(publisher_mutex_);
+
+    active_ = false;
+    publisher_grp_state_->on_deactivate();
+    publisher_statistics_->on_deactivate();
+    publisher_grasp_event_->on_deactivate();
+    publisher_estimate_->on_deactivate();
+    publisher_state_transition_->on_deactivate();
+    publisher_health_->on_deactivate();
+
+    return CallbackReturn::SUCCESS;
+}
+
+DatcRosInterface::CallbackReturn DatcRosInterface::on_cleanup(const rclcpp_lifecycle::State &) {
+    releasePort();
+    return CallbackReturn::SUCCESS;
+}
+
+DatcRosInterface::CallbackReturn DatcRosInterface::on_shutdown(const rclcpp_lifecycle::State &state) {
+    on_deactivate(state);
+    releasePort();
+    return CallbackReturn::SUCCESS;
+}
+
+// Back to unconfigured, without the port
+DatcRosInterface::CallbackReturn DatcRosInterface::on_error(const rclcpp_lifecycle::State &state) {
+    on_deactivate(state);
+    releasePort();
+    return CallbackReturn::SUCCESS;
+}
+
+void DatcRosInterface::releasePort() {
+    unique_lock<mutex> lg(reconnect_mutex_);
+
+    // First, so that the poll thread does not reconnect behind our back
+    configured_ = false;
+
+    if (getConnectionState()) {
+        modbusRelease();
+        RCLCPP_INFO(get_logger(), "Port released");
+    }
+}
+
+void DatcRosInterface::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+
+    if (!port_watcher_.start([this] (SERIAL_PORT_EVENT event, const string &path) {onSerialPortEvent(event, path);})) {
+        RCLCPP_WARN(get_logger(), "Serial port hotplug detection is unavailable");
+    }
+
+    poll_thread_      = thread(&DatcRosInterface::run, this);
+    estimator_thread_ = thread(&DatcRosInterface::runEstimator, this);
+
+    startHealth();
+}
+
+void DatcRosInterface::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    port_watcher_.stop();
+
+    if (poll_thread_.joinable()) {
+        poll_thread_.join();
+    }
+
+    if (estimator_thread_.joinable()) {
+        estimator_thread_.join();
+    }
+
+    thread health_thread;
+
+    {
+        unique_lock<mutex> lg(health_thread_mutex_);
+        health_thread = std::move(health_thread_);
+    }
+
+    if (health_thread.joinable()) {
+        health_thread.join();
+    }
+
+    if (getConnectionState()) {
+        motorDisable();
+        modbusRelease();
+    }
+}
+
+rcl_interfaces::msg::SetParametersResult DatcRosInterface::checkRateQos(double poll_rate, double publish_rate,
+                                                                         const string &reliability, int64_t depth) {
+    rcl_interfaces::msg::SetParametersResult result;
+    result.successful = false;
+
+    if (!(poll_rate >= 1 && poll_rate <= kPollRateMax)) {
+        result.reason = "poll_rate must be within [1, " + to_string((int) kPollRateMax) + "] Hz";
+    } else if (!(publish_rate > 0 && publish_rate <= poll_rate)) {
+        result.reason = "publish_rate must be within (0, poll_rate] Hz";
+    } else if (reliability != "reliable" && reliability != "best_effort") {
+        result.reason = "qos.reliability must be 'reliable' or 'best_effort'";
+    } else if (depth < 1) {
+        result.reason = "qos.depth must be at least 1";
+    } else {
+        result.successful = true;
+    }
+
+    return result;
+}
+
+int DatcRosInterface::getDecimation(double poll_rate, double publish_rate) {
+    return std::max(1, (int) std::lround(poll_rate / publish_rate));
+}
+
+void DatcRosInterface::createStatePublisher() {
+    rclcpp::QoS qos((size_t) qos_depth_);
+
+    if (qos_reliability_ == "best_effort") {
+        qos.best_effort();
+    } else {
+        qos.reliable();
+    }
+
+    auto publisher = create_publisher<GripperMsg> ("grp_state", qos);
+
+    unique_lock<mutex> lg(publisher_mutex_);
+
+    if (active_) {
+        publisher->on_activate();
+    }
+
+    publisher_grp_state_ = publisher;
+}
+
+rcl_interfaces::msg::SetParametersResult DatcRosInterface::onSetParameters(const vector<rclcpp::Parameter> &params) {
+    double poll_rate      = poll_rate_;
+    double publish_rate   = publish_rate_;
+    string reliability    = qos_reliability_;
+    int64_t depth         = qos_depth_;
+    string read_profile   = read_profile_name_;
+    int64_t read_full_every = read_full_every_;
+    bool statistics       = statistics_enabled_;
+    int64_t statistics_ms = statistics_period_ms_;
+
+    map<string, GraspProfile> grasp_profiles = grasp_profiles_;
+    string grasp_profile  = grasp_profile_name_;
+    bool grasp_enable     = grasp_enabled_;
+    bool grasp_changed    = false;
+
+    bool estimator_enable = estimator_enabled_;
+    double estimator_rate = estimator_rate_;
+    double estimator_lead = estimator_lead_ms_;
+    EstimatorNoise estimator_finger = estimator_finger_noise_;
+    EstimatorNoise estimator_motor  = estimator_motor_noise_;
+
+    string log_level = log_level_name_;
+    string log_file  = log_file_;
+
+    bool health_enable    = health_enabled_;
+    double health_window  = health_window_s_;
+    double health_publish = health_publish_period_s_;
+    double health_save    = health_save_period_s_;
+
+    for (const auto &param : params) {
+        const string &name = param.get_name();
+
+        if (name == "poll_rate") {
+            poll_rate = param.as_double();
+        } else if (name == "publish_rate") {
+            publish_rate = param.as_double();
+        } else if (name == "qos.reliability") {
+            reliability = param.as_string();
+        } else if (name == "qos.depth") {
+            depth = param.as_int();
+        } else if (name == "read.profile") {
+            read_profile = param.as_string();
+        } else if (name == "read.full_every") {
+            read_full_every = param.as_int();
+        } else if (name == "statistics.enable") {
+            statistics = param.as_bool();
+        } else if (name == "statistics.period_ms") {
+            statistics_ms = param.as_int();
+        } else if (name == "grasp.enable") {
+            grasp_enable = param.as_bool();
+        } else if (name == "grasp.profile") {
+            grasp_profile = param.as_string();
+            grasp_changed = true;
+        } else if (name == "estimator.enable") {
+            estimator_enable = param.as_bool();
+        } else if (name == "estimator.rate") {
+            estimator_rate = param.as_double();
+        } else if (name == "estimator.lead_ms") {
+            estimator_lead = param.as_double();
+        } else if (name.compare(0, 17, "estimator.finger.") == 0 || name.compare(0, 16, "estimator.motor.") == 0) {
+            EstimatorNoise &noise = (name.compare(0, 17, "estimator.finger.") == 0) ? estimator_finger : estimator_motor;
+
+            if (!setEstimatorNoiseField(noise, name.substr(name.rfind('.') + 1), param.as_double())) {
+                rcl_interfaces::msg::SetParametersResult result;
+                result.successful = false;
+                result.reason = "Unknown estimator parameter " + name;
+                return result;
+            }
+        } else if (name == "log.level") {
+            log_level = param.as_string();
+        } else if (name == "log.file") {
+            log_file = param.as_string();
+        } else if (name == "health.enable") {
+            health_enable = param.as_bool();
+        } else if (name == "health.window_s") {
+            health_window = param.as_double();
+        } else if (name == "health.publish_period_s") {
+            health_publish = param.as_double();
+        } else if (name == "health.save_period_s") {
+            health_save = param.as_double();
+        } else if (name.compare(0, 3, "rt.") == 0 || name == "grasp.profiles" || name == "shm.name" ||
+                   name == "health.directory" || name.compare(0, 4, "tcp.") == 0) {
+            rcl_interfaces::msg::SetParametersResult result;
+            result.successful = false;
+            result.reason = name + " is only read at startup";
+            return result;
+        } else if (name.compare(0, 6, "grasp.") == 0) {
+            // grasp.<profile>.<field>
+            const size_t dot = name.rfind('.');
+            auto it = grasp_profiles.find(name.substr(6, dot - 6));
+
+            if (it == grasp_profiles.end() || !setGraspProfileField(it->second, name.substr(dot + 1), param)) {
+                rcl_interfaces::msg::SetParametersResult result;
+                result.successful = false;
+                result.reason = "Unknown grasp parameter " + name;
+                return result;
+            }
+
+            grasp_changed = true;
+        }
+    }
+
+    rcl_interfaces::msg::SetParametersResult result = checkRateQos(poll_rate, publish_rate, reliability, depth);
+
+    READ_PROFILE profile;
+
+    if (result.successful && !parseReadProfile(read_profile, profile)) {
+        result.successful = false;
+        result.reason = "read.profile must be full, minimal, status or mixed";
+    } else if (result.successful && read_full_every < 2) {
+        result.successful = false;
+        result.reason = "read.full_every must be at least 2";
+    }
+
+    if (result.successful && statistics_ms < 100) {
+        result.successful = false;
+        result.reason = "statistics.period_ms must be at least 100";
+    }
+
+    if (result.successful && grasp_profiles.count(grasp_profile) == 0) {
+        result.successful = false;
+        result.reason = "No grasp profile named " + grasp_profile + " (see grasp.profiles)";
+    }
+
+    for (const auto &profile : grasp_profiles) {
+        const string error = profile.second.check();
+
+        if (result.successful && !error.empty()) {
+            result.successful = false;
+            result.reason = "grasp." + profile.first + ": " + error;
+        }
+    }
+
+    if (result.successful && !(estimator_rate >= 1 && estimator_rate <= kEstimatorRateMax)) {
+        result.successful = false;
+        result.reason = "estimator.rate must be within [1, " + to_string((int) kEstimatorRateMax) + "] Hz";
+    } else if (result.successful && !(estimator_lead >= 0 && estimator_lead <= kEstimatorLeadMaxMs)) {
+        result.successful = false;
+        result.reason = "estimator.lead_ms must be within [0, " + to_string((int) kEstimatorLeadMaxMs) + "]";
+    } else if (result.successful && !(estimator_finger.accel_std > 0 && estimator_finger.pos_std > 0 &&
+                                      estimator_motor.accel_std > 0 && estimator_motor.pos_std > 0)) {
+        result.successful = false;
+        result.reason = "estimator.*.accel_std and estimator.*.pos_std must be positive";
+    }
+
+    if (result.successful && !(health_window >= kHealthWindowMinS && health_window <= kHealthWindowMaxS)) {
+        result.successful = false;
+        result.reason = "health.window_s must be within [" + to_string((int) kHealthWindowMinS) + ", " +
+                        to_string((int) kHealthWindowMaxS) + "]";
+    } else if (result.successful && !(health_publish >= 1 && health_save >= 1)) {
+        result.successful = false;
+        result.reason = "health.publish_period_s and health.save_period_s must be at least 1";
+    }
+
+    LOG_LEVEL level = LOG_LEVEL::INFO;
+
+    if (result.successful && !AsyncLogger::parseLevel(log_level, level)) {
+        result.successful = false;
+        result.reason = "log.level must be debug, info, warn or error";
+    }
+
+    // Last, as it is the only check with an effect: the file is open once it passes
+    string error;
+
+    if (result.successful && log_file != AsyncLogger::instance().getFile() && !AsyncLogger::instance().setFile(log_file, error)) {
+        result.successful = false;
+        result.reason = "log.file: " + error;
+    }
+
+    if (!result.successful) {
+        return result;
+    }
+
+    const bool qos_changed  = reliability != qos_reliability_ || depth != qos_depth_;
+    const bool read_changed = read_profile != read_profile_name_ || read_full_every != read_full_every_ ||
+                              poll_rate != poll_rate_;
+
+    poll_rate_            = poll_rate;
+    publish_rate_         = publish_rate;
+    publish_decimation_   = getDecimation(poll_rate, publish_rate);
+    qos_reliability_      = reliability;
+    qos_depth_            = depth;
+    statistics_enabled_   = statistics;
+    statistics_period_ms_ = statistics_ms;
+    grasp_enabled_        = grasp_enable;
+    read_profile_name_    = read_profile;
+    read_full_every_      = read_full_every;
+    log_level_name_       = log_level;
+    log_file_             = log_file;
+
+    AsyncLogger::instance().setLevel(level);
+
+    setReadProfile(profile, (int) read_full_every);
+
+    const bool estimator_changed = estimator_enable != estimator_enabled_ || estimator_rate != estimator_rate_ ||
+                                   estimator_lead != estimator_lead_ms_;
+
+    estimator_rate_         = estimator_rate;
+    estimator_lead_ms_      = estimator_lead;
+    estimator_finger_noise_ = estimator_finger;
+    estimator_motor_noise_  = estimator_motor;
+
+    {
+        unique_lock<mutex> lg(estimator_mutex_);
+        estimator_.setNoise(estimator_finger, estimator_motor);
+    }
+
+    estimator_enabled_ = estimator_enable;
+
+    if (estimator_changed) {
+        RCLCPP_INFO(get_logger(), "State estimator %s (%.0f Hz, lead %.1f ms)", estimator_enable ? "on" : "off",
+                    estimator_rate, estimator_lead);
+    }
+
+    if (health_enable && !health_enabled_) {
+        makeHealthDirectory();
+    }
+
+    health_enabled_          = health_enable;
+    health_publish_period_s_ = health_publish;
+    health_save_period_s_    = health_save;
+
+    if (health_enable) {
+        startHealth();
+    }
+
+    if (health_window != health_window_s_) {
+        unique_lock<mutex> lg(health_mutex_);
+
+        health_.setWindow(health_window);
+        health_window_s_ = health_window;
+    }
+
+    if (grasp_changed) {
+        grasp_profiles_     = grasp_profiles;
+        grasp_profile_name_ = grasp_profile;
+        setGraspProfile(grasp_profile, grasp_profiles[grasp_profile]);
+    }
+
+    if (qos_changed) {
+        // Existing subscriptions reconnect to the new publisher by themselves if their QoS is compatible
+        createStatePublisher();
+        RCLCPP_INFO(get_logger(), "grp_state QoS: %s, depth %ld", reliability.c_str(), (long) depth);
+    }
+
+    RCLCPP_INFO(get_logger(), "Poll %.1f Hz, publish %.1f Hz (every %d samples)",
+                poll_rate, poll_rate / publish_decimation_, publish_decimation_.load());
+
+    if (read_changed && configured_) {
+        logReadProfile(get_parameter("baudrate").as_int());
+    }
+
+    return result;
+}
+
+// What the read profile costs on the bus at this baud rate, and whether poll_rate still fits
+void DatcRosInterface::logReadProfile(int baudrate) {
+    const READ_PROFILE profile = getReadProfile();
+    const double read_us = estimateReadTimeUs(profile, (int) read_full_every_, baudrate, getRegisterMap());
+    const double rate_max = 1e6 / read_us;
+
+    RCLCPP_INFO(get_logger(), "Read profile %s (%s): %.2f ms per read at %d bps, poll rate up to %.0f Hz",
+                getReadProfileName(profile), getRegisterMap().name, read_us / 1000, baudrate, rate_max);
+
+    if (poll_rate_ > rate_max) {
+        RCLCPP_WARN(get_logger(), "poll_rate %.1f Hz exceeds what the bus allows; reads will overrun the period",
+                    poll_rate_.load());
+    }
+
+    if (profile == READ_PROFILE::STATUS && grasp_enabled_) {
+        RCLCPP_WARN(get_logger(), "Grasp detection needs the motor values, which the status profile does not read");
+    }
+
+    if (profile == READ_PROFILE::STATUS && estimator_enabled_) {
+        RCLCPP_WARN(get_logger(), "The state estimator needs the positions, which the status profile does not read");
+    }
+}
+
+// Poll thread. Running min/max/mean/stddev of the publish period, sent every statistics.period_ms.
+void DatcRosInterface::updateStatistics(const timespec &time_pub) {
+    if (!statistics_enabled_) {
+        stat_count_ = 0;
+        stat_has_prev_ = false;
+        return;
+    }
+
+    const double t = time_pub.tv_sec + time_pub.tv_nsec * 1e-9;
+
+    if (stat_has_prev_) {
+        const double period_ms = (t - stat_time_prev_) * 1000;
+
+        stat_count_++;
+
+        const double delta = period_ms - stat_mean_;
+        stat_mean_ += delta / stat_count_;
+        stat_m2_   += delta * (period_ms - stat_mean_);
+
+        stat_min_ = (stat_count_ == 1) ? period_ms : std::min(stat_min_, period_ms);
+        stat_max_ = (stat_count_ == 1) ? period_ms : std::max(stat_max_, period_ms);
+    } else {
+        stat_window_start_ = now();
+    }
+
+    stat_time_prev_ = t;
+    stat_has_prev_  = true;
+
+    const rclcpp::Time time_now = now();
+
+    if ((time_now - stat_window_start_).nanoseconds() < statistics_period_ms_ * 1000000L || stat_count_ == 0) {
+        return;
+    }
+
+    auto msg = make_unique<MetricsMessage>();
+
+    msg->measurement_source_name = get_name();
+    msg->metrics_source          = "message_period";
+    msg->unit                    = "ms";
+    msg->window_start            = stat_window_start_;
+    msg->window_stop             = time_now;
+
+    auto point = [] (uint8_t type, double value) {
+        statistics_msgs::msg::StatisticDataPoint p;
+        p.data_type = type;
+        p.data      = value;
+        return p;
+    };
+
+    msg->statistics.push_back(point(StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE, stat_mean_));
+    msg->statistics.push_back(point(StatisticDataType::STATISTICS_DATA_TYPE_MINIMUM, stat_min_));
+    msg->statistics.push_back(point(StatisticDataType::STATISTICS_DATA_TYPE_MAXIMUM, stat_max_));
+    msg->statistics.push_back(point(StatisticDataType::STATISTICS_DATA_TYPE_STDDEV,
+                                    stat_count_ > 1 ? std::sqrt(stat_m2_ / (stat_count_ - 1)) : 0.0));
+    msg->statistics.push_back(point(StatisticDataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT, (double) stat_count_));
+
+    publisher_statistics_->publish(std::move(msg));
+
+    stat_count_        = 0;
+    stat_mean_         = 0;
+    stat_m2_           = 0;
+    stat_window_start_ = time_now;
+}
+
+// Lines of the async logger go to this node's logger unless log.file is set. Level and file are
+// process-wide: without log.level / log.file, a node keeps what an earlier node in the process set.
+void DatcRosInterface::declareLogParameters() {
+    const rclcpp::Logger logger = get_logger();
+
+    AsyncLogger::instance().setSink(this, [logger] (LOG_LEVEL level, const char *text) {
+        switch (level) {
+            case LOG_LEVEL::DEBUG: RCLCPP_DEBUG(logger, "%s", text); break;
+            case LOG_LEVEL::INFO:  RCLCPP_INFO (logger, "%s", text); break;
+            case LOG_LEVEL::WARN:  RCLCPP_WARN (logger, "%s", text); break;
+            case LOG_LEVEL::ERROR: RCLCPP_ERROR(logger, "%s", text); break;
+        }
+    });
+
+    string level_name = AsyncLogger::getLevelName(AsyncLogger::instance().getLevel());
+    transform(level_name.begin(), level_name.end(), level_name.begin(), ::tolower);
+
+    log_level_name_ = declare_parameter<string>("log.level", level_name);
+    log_file_       = declare_parameter<string>("log.file", AsyncLogger::instance().getFile());
+
+    LOG_LEVEL level = LOG_LEVEL::INFO;
+
+    if (!AsyncLogger::parseLevel(log_level_name_, level)) {
+        RCLCPP_ERROR(get_logger(), "log.level must be debug, info, warn or error, using info");
+        log_level_name_ = "info";
+        level = LOG_LEVEL::INFO;
+    }
+
+    AsyncLogger::instance().setLevel(level);
+
+    string error;
+
+    if (log_file_ != AsyncLogger::instance().getFile() && !AsyncLogger::instance().setFile(log_file_, error)) {
+        RCLCPP_ERROR(get_logger(), "log.file: %s", error.c_str());
+        log_file_ = AsyncLogger::instance().getFile();
+    }
+}
+
+void DatcRosInterface::declareGraspParameters() {
+    grasp_enabled_ = declare_parameter<bool>("grasp.enable", false);
+
+    const vector<string> names = declare_parameter<vector<string>>("grasp.profiles", vector<string>({"default"}));
+
+    for (const auto &name : names) {
+        const string prefix = "grasp." + name + ".";
+        GraspProfile profile;
+
+        profile.arm_velocity    = declare_parameter<int>(prefix + "arm_velocity", profile.arm_velocity);
+        profile.current_rise_ma = declare_parameter<int>(prefix + "current_rise_ma", profile.current_rise_ma);
+        profile.plateau_pos     = declare_parameter<int>(prefix + "plateau_pos", profile.plateau_pos);
+        profile.velocity_drop   = declare_parameter<double>(prefix + "velocity_drop", profile.velocity_drop);
+        profile.confirm_samples = declare_parameter<int>(prefix + "confirm_samples", profile.confirm_samples);
+        profile.hold_current_ma = declare_parameter<int>(prefix + "hold_current_ma", profile.hold_current_ma);
+
+        const string action = declare_parameter<string>(prefix + "action", GraspProfile::getActionName(profile.action));
+        string error = profile.check();
+
+        if (!GraspProfile::parseAction(action, profile.action)) {
+            error = "action must be stop, hold or none";
+        }
+
+        if (!error.empty()) {
+            RCLCPP_ERROR(get_logger(), "grasp.%s: %s, using the defaults", name.c_str(), error.c_str());
+            profile = GraspProfile();
+        }
+
+        grasp_profiles_[name] = profile;
+    }
+
+    if (grasp_profiles_.empty()) {
+        grasp_profiles_["default"] = GraspProfile();
+    }
+
+    grasp_profile_name_ = declare_parameter<string>("grasp.profile", grasp_profiles_.begin()->first);
+
+    if (grasp_profiles_.count(grasp_profile_name_) == 0) {
+        RCLCPP_ERROR(get_logger(), "No grasp profile named %s", grasp_profile_name_.c_str());
+        grasp_profile_name_ = grasp_profiles_.begin()->first;
+    }
+
+    setGraspProfile(grasp_profile_name_, grasp_profiles_[grasp_profile_name_]);
+}
+
+bool DatcRosInterface::setGraspProfileField(GraspProfile &profile, const string &field, const rclcpp::Parameter &param) {
+    if (field == "arm_velocity") {
+        profile.arm_velocity = param.as_int();
+    } else if (field == "current_rise_ma") {
+        profile.current_rise_ma = param.as_int();
+    } else if (field == "plateau_pos") {
+        profile.plateau_pos = param.as_int();
+    } else if (field == "velocity_drop") {
+        profile.velocity_drop = param.as_double();
+    } else if (field == "confirm_samples") {
+        profile.confirm_samples = param.as_int();
+    } else if (field == "hold_current_ma") {
+        profile.hold_current_ma = param.as_int();
+    } else if (field == "action") {
+        return GraspProfile::parseAction(param.as_string(), profile.action);
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+// Picked up by the poll thread at its next sample
+void DatcRosInterface::setGraspProfile(const string &name, const GraspProfile &profile) {
+    unique_lock<mutex> lg(grasp_mutex_);
+
+    grasp_pending_name_    = name;
+    grasp_pending_profile_ = profile;
+    grasp_profile_changed_ = true;
+}
+
+// Poll thread. The action goes out in the same cycle as the sample that confirmed the contact.
+void DatcRosInterface::detectGrasp(const timespec &time_sample) {
+    if (grasp_profile_changed_.exchange(false)) {
+        unique_lock<mutex> lg(grasp_mutex_);
+
+        grasp_detector_.setProfile(grasp_pending_profile_);
+        grasp_active_name_ = grasp_pending_name_;
+    }
+
+    if (!grasp_enabled_) {
+        grasp_detector_.reset();
+        return;
+    }
+
+    if (!grasp_detector_.update(status_, time_sample.tv_sec * 1000000000L + time_sample.tv_nsec)) {
+        return;
+    }
+
+    const GraspProfile &profile = grasp_detector_.getProfile();
+    const GraspContact &contact = grasp_detector_.getContact();
+
+    bool successed = true;
+
+    if (profile.action == GRASP_ACTION::STOP) {
+        successed = motorStop();
+    } else if (profile.action == GRASP_ACTION::HOLD) {
+        successed = motorCurCtrl(contact.motor_cur < 0 ? -profile.hold_current_ma : profile.hold_current_ma);
+    }
+
+    timespec time_action;
+    clock_gettime(CLOCK_MONOTONIC, &time_action);
+
+    auto msg = make_unique<GraspEvent>();
+
+    msg->stamp            = now();
+    msg->profile          = grasp_active_name_;
+    msg->finger_position  = contact.finger_pos;
+    msg->motor_position   = contact.motor_pos;
+    msg->motor_current    = contact.motor_cur;
+    msg->peak_velocity    = contact.peak_vel;
+    msg->action           = GraspProfile::getActionName(profile.action);
+    msg->action_successed = successed;
+    msg->detection_latency_ms = (time_action.tv_sec * 1000000000L + time_action.tv_nsec - contact.onset_ns) / 1e6;
+
+    DATC_LOG_INFO("Grasp detected at %.1f %% (%d mA), %s in %.1f ms", contact.finger_pos / 10.0,
+                  contact.motor_cur, msg->action.c_str(), msg->detection_latency_ms);
+
+    publisher_grasp_event_->publish(std::move(msg));
+}
+
+void DatcRosInterface::declareEstimatorParameters() {
+    estimator_enabled_ = declare_parameter<bool>("estimator.enable", false);
+    estimator_rate_    = declare_parameter<double>("estimator.rate", kEstimatorRateDefault);
+    estimator_lead_ms_ = declare_parameter<double>("estimator.lead_ms", 0.0);
+
+    if (!(estimator_rate_ >= 1 && estimator_rate_ <= kEstimatorRateMax) ||
+        !(estimator_lead_ms_ >= 0 && estimator_lead_ms_ <= kEstimatorLeadMaxMs)) {
+        RCLCPP_ERROR(get_logger(), "estimator.rate must be within [1, %d] Hz and estimator.lead_ms within [0, %d], "
+                     "using the defaults", (int) kEstimatorRateMax, (int) kEstimatorLeadMaxMs);
+        estimator_rate_    = kEstimatorRateDefault;
+        estimator_lead_ms_ = 0;
+    }
+
+    for (auto axis : {make_pair("finger", &estimator_finger_noise_), make_pair("motor", &estimator_motor_noise_)}) {
+        const string prefix = string("estimator.") + axis.first + ".";
+        EstimatorNoise &noise = *axis.second;
+
+        noise.accel_std = declare_parameter<double>(prefix + "accel_std", noise.accel_std);
+        noise.pos_std   = declare_parameter<double>(prefix + "pos_std", noise.pos_std);
+
+        if (!(noise.accel_std > 0 && noise.pos_std > 0)) {
+            RCLCPP_ERROR(get_logger(), "%saccel_std and %spos_std must be positive, using the defaults",
+                         prefix.c_str(), prefix.c_str());
+            noise = EstimatorNoise();
+        }
+    }
+
+    estimator_.setNoise(estimator_finger_noise_, estimator_motor_noise_);
+}
+
+bool DatcRosInterface::setEstimatorNoiseField(EstimatorNoise &noise, const string &field, double value) {
+    if (field == "accel_std") {
+        noise.accel_std = value;
+    } else if (field == "pos_std") {
+        noise.pos_std = value;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+// Poll thread, on every sample. A command or a status change starts a new motion, so the velocity of
+// the last one is dropped before this sample is applied.
+void DatcRosInterface::updateEstimator(int64_t time_sample_ns) {
+    if (!estimator_enabled_) {
+        resetEstimator();
+        return;
+    }
+
+    const uint32_t commands = getCommandCount();
+    const bool new_motion = estimator_has_prev_ &&
+                            (commands != estimator_commands_prev_ || status_.states != estimator_states_prev_);
+
+    {
+        unique_lock<mutex> lg(estimator_mutex_);
+
+        if (new_motion) {
+            estimator_.resetVelocity();
+        }
+
+        // The status profile leaves the positions as they were
+        if (getReadProfile() != READ_PROFILE::STATUS) {
+            estimator_.update(status_, time_sample_ns);
+        }
+    }
+
+    estimator_commands_prev_ = commands;
+    estimator_states_prev_   = status_.states;
+    estimator_has_prev_      = true;
+}
+
+void DatcRosInterface::resetEstimator() {
+    if (!estimator_has_prev_) {
+        return;
+    }
+
+    unique_lock<mutex> lg(estimator_mutex_);
+
+    estimator_.reset();
+    estimator_has_prev_ = false;
+}
+
+// Estimator thread. Extrapolates the last sample to now + estimator.lead_ms; stops publishing when the
+// samples stop coming.
+void DatcRosInterface::runEstimator() {
+    timespec time_next, time_current;
+    clock_gettime(CLOCK_MONOTONIC, &time_next);
+
+    while (running_ && rclcpp::ok()) {
+        if (!estimator_enabled_ || !active_) {
+            this_thread::sleep_for(chrono::milliseconds(kEstimatorIdleMs));
+            clock_gettime(CLOCK_MONOTONIC, &time_next);
+            continue;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &time_current);
+
+        const int64_t now_ns     = time_current.tv_sec * 1000000000L + time_current.tv_nsec;
+        const int64_t lead_ns    = (int64_t) (estimator_lead_ms_ * 1e6);
+        const int64_t max_age_ns = (int64_t) (kEstimatorMaxAgePeriods * 1e9 / poll_rate_);
+
+        auto msg = make_unique<GripperEstimate>();
+        AxisEstimate finger, motor;
+        int64_t sample_ns = 0;
+        bool fresh;
+
+        {
+            unique_lock<mutex> lg(estimator_mutex_);
+
+            fresh = estimator_.isReady() && now_ns - estimator_.getSampleTime() <= max_age_ns;
+
+            if (fresh) {
+                estimator_.predict(now_ns + lead_ns, finger, motor);
+                sample_ns = estimator_.getSampleTime();
+
+                msg->finger_error_rms = estimator_.getFingerErrorRms();
+                msg->motor_error_rms  = estimator_.getMotorErrorRms();
+            }
+        }
+
+        if (fresh) {
+            const rclcpp::Time time_ros = now();
+
+            msg->stamp           = time_ros + rclcpp::Duration::from_nanoseconds(lead_ns);
+            msg->sample_stamp    = time_ros - rclcpp::Duration::from_nanoseconds(now_ns - sample_ns);
+            msg->finger_position = finger.pos;
+            msg->finger_velocity = finger.vel;
+            msg->motor_position  = motor.pos;
+            msg->motor_velocity  = motor.vel;
+
+            for (size_t i = 0; i < 4; i++) {
+                msg->finger_covariance[i] = finger.cov[i];
+                msg->motor_covariance[i]  = motor.cov[i];
+            }
+
+            publisher_estimate_->publish(std::move(msg));
+        }
+
+        advanceDeadline(time_next, estimator_rate_);
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &time_next, NULL);
+    }
+}
+
+void DatcRosInterface::declareHealthParameters() {
+    health_enabled_          = declare_parameter<bool>("health.enable", false);
+    health_window_s_         = declare_parameter<double>("health.window_s", kHealthWindowDefaultS);
+    health_publish_period_s_ = declare_parameter<double>("health.publish_period_s", 10.0);
+    health_save_period_s_    = declare_parameter<double>("health.save_period_s", 60.0);
+    health_directory_        = declare_parameter<string>("health.directory", "");
+
+    if (!(health_window_s_ >= kHealthWindowMinS && health_window_s_ <= kHealthWindowMaxS) ||
+        !(health_publish_period_s_ >= 1 && health_save_period_s_ >= 1)) {
+        RCLCPP_ERROR(get_logger(), "health.window_s must be within [%d, %d] and the health periods at least 1 s, "
+                     "using the defaults", (int) kHealthWindowMinS, (int) kHealthWindowMaxS);
+        health_window_s_         = kHealthWindowDefaultS;
+        health_publish_period_s_ = 10;
+        health_save_period_s_    = 60;
+    }
+
+    // Where ROS keeps its own state (logs) unless told otherwise
+    if (health_directory_.empty()) {
+        const char *ros_home = getenv("ROS_HOME");
+        const char *home     = getenv("HOME");
+
+        health_directory_ = (ros_home != NULL) ? string(ros_home) : string(home != NULL ? home : ".") + "/.ros";
+    }
+
+    if (health_enabled_) {
+        makeHealthDirectory();
+    }
+
+    health_.setWindow(health_window_s_);
+}
+
+// Only the last level. Without it the counters are still kept, but not saved.
+void DatcRosInterface::makeHealthDirectory() {
+    if (mkdir(health_directory_.c_str(), 0755) < 0 && errno != EEXIST) {
+        RCLCPP_ERROR(get_logger(), "health.directory %s: %s", health_directory_.c_str(), strerror(errno));
+    }
+}
+
+// Per adapter (its stable name) and slave address, so that grippers on different buses stay apart
+string DatcRosInterface::getWearPath(const string &port, uint slave) {
+    string name = port.substr(port.rfind('/') + 1);
+
+    for (auto &c : name) {
+        if (!isalnum((unsigned char) c) && c != '-' && c != '_' && c != '.') {
+            c = '_';
+        }
+    }
+
+    return health_directory_ + "/datc_wear_" + name + "_" + to_string(slave) + ".txt";
+}
+
+// Poll thread, on every read of an active connection
+void DatcRosInterface::updateHealth(bool sample_read, int64_t time_sample_ns) {
+    const uint32_t commands = getCommandCount();
+    const uint32_t commands_new = commands - health_commands_prev_;
+
+    health_commands_prev_ = commands;
+
+    if (!health_enabled_) {
+        return;
+    }
+
+    uint16_t command_code;
+    int64_t command_ns;
+    getLastCommand(command_code, command_ns);
+
+    // Registers outside this read hold older values (READ_PROFILE)
+    const RegisterMap &map = getRegisterMap();
+    const int read_count   = getLastReadCount();
+
+    unique_lock<mutex> lg(health_mutex_);
+
+    // Switching to another gripper's counters
+    if (health_slave_ != getSlaveAddr()) {
+        return;
+    }
+
+    health_.addCommands(commands_new, command_code, command_ns);
+
+    if (sample_read) {
+        health_.addSample(status_, time_sample_ns, map.motor_pos >= 0 && map.motor_pos < read_count,
+                          map.voltage >= 0 && map.voltage < read_count);
+    } else {
+        health_.addReadError(time_sample_ns);
+    }
+
+    health_dirty_ = true;
+}
+
+void DatcRosInterface::resetHealth() {
+    unique_lock<mutex> lg(health_mutex_);
+    health_.resetEdges();
+}
+
+static void toHealthStat(const MetricSummary &summary, HealthStat &stat) {
+    stat.count   = summary.count;
+    stat.mean    = summary.mean;
+    stat.std_dev = summary.std_dev;
+    stat.min     = summary.min;
+    stat.max     = summary.max;
+    stat.p50     = summary.p50;
+    stat.p90     = summary.p90;
+    stat.p99     = summary.p99;
+}
+
+void DatcRosInterface::toHealthMsg(const HealthSummary &summary, uint slave, GripperHealth &msg) {
+    msg.stamp         = now();
+    msg.slave_address = slave;
+
+    msg.samples          = summary.wear.samples;
+    msg.read_errors      = summary.wear.read_errors;
+    msg.commands         = summary.wear.commands;
+    msg.open_cycles      = summary.wear.open_cycles;
+    msg.close_cycles     = summary.wear.close_cycles;
+    msg.faults           = summary.wear.faults;
+    msg.motor_travel_rev = summary.wear.motor_travel_deg / 360;
+    msg.connected_hours  = summary.wear.connected_s / 3600;
+
+    msg.window_s            = summary.window_s;
+    msg.window_open_cycles  = summary.window_open_cycles;
+    msg.window_close_cycles = summary.window_close_cycles;
+    msg.window_faults       = summary.window_faults;
+    msg.window_read_errors  = summary.window_read_errors;
+    msg.fault_rate_per_hour = summary.fault_rate_per_hour;
+
+    toHealthStat(summary.grasp_current, msg.grasp_current);
+    toHealthStat(summary.close_time_ms, msg.close_time_ms);
+    toHealthStat(summary.open_time_ms, msg.open_time_ms);
+    toHealthStat(summary.voltage, msg.voltage);
+}
+
+// Health thread. Saves the counters of the gripper that was connected and loads those of the new one;
+// the poll thread does not count while health_slave_ is 0, and the files are never touched under the mutex.
+void DatcRosInterface::switchHealth(const string &path, uint slave) {
+    {
+        unique_lock<mutex> lg(health_mutex_);
+        health_slave_ = 0;
+    }
+
+    saveHealth();
+
+    WearCounters wear;
+    string error;
+
+    if (!loadWearCounters(path, wear, error)) {
+        DATC_LOG_ERROR("Wear counters: %s, counting from zero", error.c_str());
+    }
+
+    unique_lock<mutex> lg(health_mutex_);
+
+    health_.clearWear();
+    health_.addWear(wear);
+    health_.clearWindow();
+    health_.resetEdges();
+
+    health_slave_ = slave;
+    health_dirty_ = false;
+    health_path_  = path;
+
+    DATC_LOG_INFO("Wear counters of slave #%u: %s (%lu cycles)", slave, path.c_str(),
+                  (unsigned long) (wear.open_cycles + wear.close_cycles));
+}
+
+void DatcRosInterface::saveHealth() {
+    WearCounters wear;
+
+    {
+        unique_lock<mutex> lg(health_mutex_);
+
+        if (!health_dirty_ || health_path_.empty()) {
+            return;
+        }
+
+        wear = health_.getWear();
+        health_dirty_ = false;
+    }
+
+    string error;
+
+    if (!saveWearCounters(health_path_, wear, error)) {
+        DATC_LOG_ERROR("Wear counters: %s", error.c_str());
+    }
+}
+
+// The health thread runs only while health.enable is set and exits, saving the counters, once it is cleared
+void DatcRosInterface::startHealth() {
+    unique_lock<mutex> lg(health_thread_mutex_);
+
+    if (!running_ || !health_enabled_ || health_thread_running_) {
+        return;
+    }
+
+    // One that has just seen health.enable cleared
+    if (health_thread_.joinable()) {
+        health_thread_.join();
+    }
+
+    health_thread_running_ = true;
+    health_thread_         = thread(&DatcRosInterface::runHealth, this);
+}
+
+void DatcRosInterface::runHealth() {
+    int64_t time_publish_ns = getMonotonicNs();
+    int64_t time_save_ns    = time_publish_ns + (int64_t) (health_save_period_s_ * 1e9);
+
+    while (true) {
+        this_thread::sleep_for(chrono::milliseconds(kHealthIdleMs));
+
+        {
+            unique_lock<mutex> lg(health_thread_mutex_);
+
+            if (!running_ || !health_enabled_ || !rclcpp::ok()) {
+                health_thread_running_ = false;
+                break;
+            }
+        }
+
+        // Also loads the counters of the gripper connected while health was off
+        if (getConnectionState()) {
+            string port;
+
+            {
+                unique_lock<mutex> lg(port_mutex_);
+                port = port_stable_.empty() ? port_name_ : port_stable_;
+            }
+
+            const uint slave  = getSlaveAddr();
+            const string path = getWearPath(port, slave);
+
+            if (path != health_path_) {
+                switchHealth(path, slave);
+            }
+        }
+
+        const int64_t now_ns = getMonotonicNs();
+
+        if (now_ns >= time_save_ns) {
+            saveHealth();
+            time_save_ns = now_ns + (int64_t) (health_save_period_s_ * 1e9);
+        }
+
+        if (!active_ || now_ns < time_publish_ns) {
+            continue;
+        }
+
+        HealthSummary summary;
+        uint slave;
+
+        {
+            unique_lock<mutex> lg(health_mutex_);
+
+            summary = health_.summarize(now_ns);
+            slave   = health_slave_;
+        }
+
+        if (slave != 0) {
+            auto msg = make_unique<GripperHealth>();
+
+            toHealthMsg(summary, slave, *msg);
+            publisher_health_->publish(std::move(msg));
+        }
+
+        time_publish_ns = now_ns + (int64_t) (health_publish_period_s_ * 1e9);
+    }
+
+    saveHealth();
+}
+
+bool DatcRosInterface::toSequenceSteps(const RunSequence::Goal &goal, vector<SequenceStep> &steps, string &error) {
+    steps.clear();
+
+    for (size_t i = 0; i < goal.steps.size(); i++) {
+        const SequenceStepMsg &msg = goal.steps[i];
+        SequenceStep step;
+
+        if (msg.type == SequenceStepMsg::COMMAND) {
+            step = SequenceStep::makeCommand(msg.command, msg.value_1, msg.value_2);
+        } else if (msg.type == SequenceStepMsg::WAIT_STATE) {
+            STATUS_FLAG flag;
+
+            if (!parseStatusFlag(msg.flag, flag)) {
+                error = "Step " + to_string(i) + ": unknown flag " + msg.flag;
+                return false;
+            }
+
+            step = SequenceStep::makeWaitState(flag, msg.value, (int) std::min<uint32_t>(msg.timeout_ms, INT32_MAX));
+        } else if (msg.type == SequenceStepMsg::DELAY) {
+            step = SequenceStep::makeDelay((int) std::min<uint32_t>(msg.delay_ms, INT32_MAX));
+        } else {
+            error = "Step " + to_string(i) + ": unknown type " + to_string(msg.type);
+            return false;
+        }
+
+        if (step.type == SEQUENCE_STEP::COMMAND && !isCommandCode(step.command)) {
+            error = "Step " + to_string(i) + ": undefined command " + to_string(step.command);
+            return false;
+        }
+
+        steps.push_back(step);
+    }
+
+    error = checkSequence(steps);
+
+    return error.empty();
+}
+
+void DatcRosInterface::acceptSequenceGoal(const shared_ptr<SequenceGoalHandle> goal_handle) {
+    const auto goal = goal_handle->get_goal();
+    vector<SequenceStep> steps;
+    uint64_t id = 0;
+    string error;
+
+    unique_lock<mutex> lg(sequence_goal_mutex_);
+
+    if (!toSequenceSteps(*goal, steps, error) || !startSequence(steps, id, error)) {
+        auto result = make_shared<RunSequence::Result>();
+
+        result->successed = false;
+        result->message   = error;
+        goal_handle->abort(result);
+
+        RCLCPP_WARN(get_logger(), "run_sequence %s: %s", goal->name.c_str(), error.c_str());
+        return;
+    }
+
+    sequence_goal_    = goal_handle;
+    sequence_goal_id_ = id;
+    sequence_goal_steps_.clear();
+
+    for (const auto &step : steps) {
+        sequence_goal_steps_.push_back(step.describe());
+    }
+
+    RCLCPP_INFO(get_logger(), "run_sequence %s: %zu steps", goal->name.c_str(), steps.size());
+}
+
+// Poll thread, after every stepSequence(): feedback on each new step, the result once it has finished
+void DatcRosInterface::reportSequence() {
+    shared_ptr<SequenceGoalHandle> goal_handle;
+    uint64_t id;
+
+    {
+        unique_lock<mutex> lg(sequence_goal_mutex_);
+        goal_handle = sequence_goal_;
+        id          = sequence_goal_id_;
+    }
+
+    if (!goal_handle) {
+        return;
+    }
+
+    if (goal_handle->is_canceling()) {
+        cancelSequence("Canceled");
+    }
+
+    const SequenceProgress progress = getSequenceProgress();
+
+    if (progress.id != id) {
+        return;
+    }
+
+    const string &name = goal_handle->get_goal()->name;
+
+    if (progress.state == SEQUENCE_STATE::RUNNING) {
+        if (progress.id != sequence_reported_id_ || progress.step != sequence_reported_step_) {
+            auto feedback = make_shared<RunSequence::Feedback>();
+
+            feedback->step       = progress.step;
+            feedback->elapsed_ms = progress.elapsed_ns / 1e6;
+
+            {
+                unique_lock<mutex> lg(sequence_goal_mutex_);
+
+                if (progress.step < sequence_goal_steps_.size()) {
+                    feedback->description = sequence_goal_steps_[progress.step];
+                }
+            }
+
+            goal_handle->publish_feedback(feedback);
+
+            sequence_reported_id_   = progress.id;
+            sequence_reported_step_ = progress.step;
+        }
+
+        return;
+    }
+
+    auto result = make_shared<RunSequence::Result>();
+
+    result->successed  = progress.state == SEQUENCE_STATE::SUCCEEDED;
+    result->steps_done = progress.step;
+    result->message    = progress.message;
+    result->elapsed_ms = progress.elapsed_ns / 1e6;
+
+    if (progress.state == SEQUENCE_STATE::SUCCEEDED) {
+        goal_handle->succeed(result);
+        DATC_LOG_INFO("run_sequence %s: done in %.1f ms", name.c_str(), result->elapsed_ms);
+    } else if (progress.state == SEQUENCE_STATE::CANCELED && goal_handle->is_canceling()) {
+        goal_handle->canceled(result);
+        DATC_LOG_INFO("run_sequence %s: canceled at step %zu", name.c_str(), progress.step);
+    } else {
+        goal_handle->abort(result);
+        DATC_LOG_WARN("run_sequence %s: %s", name.c_str(), progress.message.c_str());
+    }
+
+    unique_lock<mutex> lg(sequence_goal_mutex_);
+    sequence_goal_.reset();
+}
+
+bool DatcRosInterface::runSequence(const vector<SequenceStep> &steps, string &error) {
+    uint64_t id;
+
+    if (!startSequence(steps, id, error)) {
+        return false;
+    }
+
+    while (true) {
+        const SequenceProgress progress = getSequenceProgress();
+
+        if (progress.id != id) {
+            // Ours has finished and another one started in between
+            error = "Result unknown";
+            return false;
+        } else if (progress.state != SEQUENCE_STATE::RUNNING) {
+            error = progress.message;
+            return progress.state == SEQUENCE_STATE::SUCCEEDED;
+        }
+
+        this_thread::sleep_for(chrono::milliseconds(kSequenceWaitPollMs));
+    }
+}
+
+void DatcRosInterface::pubTopic() {
+    if (getConnectionState()) {
+        // Published as unique_ptr so that intra-process subscribers in the same container get it without a copy
+        auto msg_ptr = make_unique<GripperMsg>();
+        toGripperMsg(status_, *msg_ptr);
+        msg_ptr->sequence = ++state_sequence_;
+
+        rclcpp_lifecycle::LifecyclePublisher<GripperMsg>::SharedPtr publisher;
+
+        {
+            unique_lock<mutex> lg(publisher_mutex_);
+            publisher = publisher_grp_state_;
+        }
+
+        publisher->publish(std::move(msg_ptr));
+    }
+}
+
+// Poll thread, on every sample regardless of publish_rate, so that no transition is missed
+void DatcRosInterface::pubStateTransition() {
+    const RegisterMap &map = getRegisterMap();
+    uint16_t mask = 0;
+
+    for (size_t i = 0; i < kStatusFlagCount; i++) {
+        if (map.bits[i] >= 0) {
+            mask |= 1 << map.bits[i];
+        }
+    }
+
+    const uint16_t states = status_.states & mask;
+
+    if (transition_has_prev_ && states == transition_states_prev_) {
+        return;
+    }
+
+    // First sample after (re)connecting: everything that is set counts as changed
+    const uint16_t changed = transition_has_prev_ ? (states ^ transition_states_prev_) : states;
+
+    auto msg = make_unique<StateTransition>();
+
+    msg->stamp           = now();
+    msg->states_previous = transition_has_prev_ ? transition_states_prev_ : 0;
+    msg->states          = states;
+
+    for (size_t i = 0; i < kStatusFlagCount; i++) {
+        if (map.bits[i] >= 0 && (changed & (1 << map.bits[i]))) {
+            msg->changed.push_back(getStatusFlagName((STATUS_FLAG) i));
+        }
+    }
+
+    toGripperMsg(status_, msg->sample);
+
+    publisher_state_transition_->publish(std::move(msg));
+
+    transition_states_prev_ = states;
+    transition_has_prev_    = true;
+}
+
+// Poll thread, right after the read. Every sample, and the flags alone whenever they change; the values
+// and the stamp then stay those of the last sample, so readers see its age grow.
+void DatcRosInterface::writeShm(bool sample_read) {
+    if (!shm_writer_.isOpen()) {
+        return;
+    }
+
+    const bool connected = getConnectionState();
+    uint8_t flags = (connected ? DATC_SHM_FLAG_CONNECTED : 0) | (active_ ? DATC_SHM_FLAG_ACTIVE : 0);
+
+    if (connected && active_ && !sample_read) {
+        flags |= DATC_SHM_FLAG_RECV_ERR;
+    }
+
+    if (sample_read) {
+        timespec time_sample;
+        clock_gettime(CLOCK_MONOTONIC, &time_sample);
+        shm_stamp_ns_ = time_sample.tv_sec * 1000000000L + time_sample.tv_nsec;
+    } else if (flags == shm_flags_prev_) {
+        return;
+    }
+
+    shm_writer_.write(status_, flags, shm_stamp_ns_);
+    shm_flags_prev_ = flags;
+}
+
+bool DatcRosInterface::initTcp(const string &addr, uint16_t port) {
+    // Runs on the bridge's command thread. Same gate as the services: only stop and disable while inactive.
+    const bool success = tcp_bridge_.start(addr, port, [this] (uint16_t code, int16_t value_1, int16_t value_2) {
+        if (code != (uint16_t) DATC_COMMAND::MOTOR_STOP && code != (uint16_t) DATC_COMMAND::MOTOR_DISABLE &&
+            !acceptCommand(("TCP command " + to_string(code)).c_str())) {
+            return false;
+        }
+
+        return commandByCode(code, value_1, value_2);
+    });
+
+    if (success) {
+        RCLCPP_INFO(get_logger(), "TCP bridge listening on %s:%d", addr.empty() ? "*" : addr.c_str(), (int) tcp_bridge_.getPort());
+    }
+
+    return success;
+}
+
+// Poll thread, every cycle. Only changes are sent, as with the GUI snapshot.
+void DatcRosInterface::sendTcpStatus() {
+    if (!tcp_bridge_.isRunning() || !tcp_send_status_) {
+        tcp_has_prev_ = false;
+        return;
+    }
+
+    const uint8_t flags = (getConnectionState() ? kTcpFlagConnected : 0) | (getModbusRecvErr() ? kTcpFlagRecvErr : 0) |
+                          (active_ ? kTcpFlagActive : 0);
+
+    if (tcp_has_prev_ && flags == tcp_flags_prev_ && status_ == tcp_status_prev_) {
+        return;
+    }
+
+    tcp_bridge_.broadcastStatus(status_, flags);
+
+    tcp_has_prev_    = true;
+    tcp_status_prev_ = status_;
+    tcp_flags_prev_  = flags;
+}
+
+void DatcRosInterface::onSerialPortEvent(SERIAL_PORT_EVENT event, const string &path) {
+    {
+        unique_lock<mutex> lg(port_mutex_);
+
+        if (path == port_name_ || (!port_stable_.empty() && path == port_stable_)) {
+            if (event == SERIAL_PORT_EVENT::REMOVED) {
+                port_removed_ = true;
+            } else {
+                port_added_ = true;
+            }
+        }
+    }
+
+    onSerialPortsChanged(port_watcher_.getPorts());
+}
+
+// Runs on the poll thread, so the bus is never released or reopened under a transaction
+void DatcRosInterface::handlePortEvents() {
+    const auto now = chrono::steady_clock::now();
+
+    if (port_removed_.exchange(false)) {
+        unique_lock<mutex> lg(reconnect_mutex_);
+
+        if (getConnectionState()) {
+            DATC_LOG_WARN("Serial port removed, reconnecting when it is plugged back in");
+            modbusRelease();
+
+            reconnect_tries_ = kReconnectTries;
+            reconnect_ready_ = false;
+        }
+    }
+
+    // Connected again by someone else (GUI, parameter) in the meantime, or cleaned up
+    if (getConnectionState() || !configured_) {
+        reconnect_tries_ = 0;
+    }
+
+    if (port_added_.exchange(false) && reconnect_tries_ > 0) {
+        reconnect_ready_ = true;
+        time_reconnect_  = now + chrono::milliseconds(kReconnectIntervalMs);
+    }
+
+    if (reconnect_tries_ == 0 || !reconnect_ready_ || now < time_reconnect_) {
+        return;
+    }
+
+    string port;
+    uint slave_address;
+    int baudrate;
+
+    {
+        unique_lock<mutex> lg(port_mutex_);
+        port          = port_stable_.empty() ? port_name_ : port_stable_;
+        slave_address = slave_address_;
+        baudrate      = baudrate_;
+    }
+
+    // Opened without reconnect_mutex_, which would otherwise keep a cleanup waiting for the whole attempt
+    const bool connected = init(port.c_str(), slave_address, baudrate);
+
+    {
+        unique_lock<mutex> lg(reconnect_mutex_);
+
+        // Cleaned up during the attempt; releasePort() may have missed the port that was still being opened
+        if (!configured_) {
+            if (getConnectionState()) {
+                modbusRelease();
+            }
+
+            reconnect_tries_ = 0;
+            return;
+        }
+    }
+
+    if (connected) {
+        DATC_LOG_INFO("Reconnected to %s (slave #%u, %d bps)", port.c_str(), slave_address, baudrate);
+        reconnect_tries_ = 0;
+    } else if (--reconnect_tries_ == 0) {
+        DATC_LOG_ERROR("Failed to reconnect to %s", port.c_str());
+    } else {
+        time_reconnect_ = now + chrono::milliseconds(kReconnectIntervalMs);
+    }
+}
+
+void DatcRosInterface::sleepUntilPoll(const timespec &time_next) {
+    const int64_t next_ns = time_next.tv_sec * 1000000000L + time_next.tv_nsec;
+    int64_t deadline_ns;
+
+    while (running_ && (deadline_ns = getSequenceDeadline()) > 0 && deadline_ns < next_ns) {
+        const timespec time_deadline = {(time_t) (deadline_ns / 1000000000L), (long) (deadline_ns % 1000000000L)};
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &time_deadline, NULL);
+
+        if (!active_ || !getConnectionState()) {
+            break;
+        }
+
+        timespec time_current;
+        clock_gettime(CLOCK_MONOTONIC, &time_current);
+
+        stepSequence(time_current.tv_sec * 1000000000L + time_current.tv_nsec, false);
+        reportSequence();
+    }
+
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &time_next, NULL);
+}
+
+void DatcRosInterface::advanceDeadline(timespec &time_next, double rate_hz) {
+    time_next.tv_nsec += (long) (1e9 / rate_hz);
+
+    while (time_next.tv_nsec >= 1000000000L) {
+        time_next.tv_nsec -= 1000000000L;
+        time_next.tv_sec++;
+    }
+
+    // After a stall (e.g. a bus timeout) restart the schedule instead of bursting to catch up
+    timespec time_current;
+    clock_gettime(CLOCK_MONOTONIC, &time_current);
+
+    if (time_next.tv_sec < time_current.tv_sec ||
+        (time_next.tv_sec == time_current.tv_sec && time_next.tv_nsec < time_current.tv_nsec)) {
+        time_next = time_current;
+    }
+}
+
+// Main loop
+void DatcRosInterface::run() {
+    if (!rt_profile_.isDefault()) {
+        const RtProfileResult rt = applyRtProfile(rt_profile_);
+
+        for (const auto &error : rt.errors) {
+            DATC_LOG_WARN("RT profile: %s", error.c_str());
+        }
+
+        DATC_LOG_INFO("Poll thread: %s", rt.applied.c_str());
+    }
+
+    timespec time_next, time_current;
+    clock_gettime(CLOCK_MONOTONIC, &time_next);
+
+    bool first_cycle = true;
+    int publish_count = 0;
+
+    while (running_ && rclcpp::ok()) {
+        clock_gettime(CLOCK_MONOTONIC, &time_current);
+
+        // Wakeup latency against the deadline we slept to
+        if (!first_cycle && !latency_.isFull()) {
+            latency_.add((time_current.tv_sec - time_next.tv_sec) * 1000000000L + (time_current.tv_nsec - time_next.tv_nsec));
+
+            if (latency_.isFull()) {
+                DATC_LOG_INFO("Poll wakeup latency: %s", latency_.report().c_str());
+            }
+        }
+
+        first_cycle = false;
+
+        bool sample_read = false;
+
+        handlePortEvents();
+
+        if (active_ && getConnectionState()) {
+            timespec time_request, time_response;
+
+            clock_gettime(CLOCK_MONOTONIC, &time_request);
+            sample_read = readDatcData();
+            clock_gettime(CLOCK_MONOTONIC, &time_response);
+
+            writeShm(sample_read);
+
+            // Sequence steps that this sample completes go out first
+            stepSequence(time_response.tv_sec * 1000000000L + time_response.tv_nsec, sample_read);
+            reportSequence();
+
+            // The slave takes the sample between the request and the response
+            const int64_t time_sample_ns = (time_request.tv_sec + time_response.tv_sec) * 500000000L +
+                                           (time_request.tv_nsec + time_response.tv_nsec) / 2;
+
+            updateHealth(sample_read, time_sample_ns);
+
+            if (sample_read) {
+                updateEstimator(time_sample_ns);
+                detectGrasp(time_current);
+                pubStateTransition();
+            }
+
+            if (++publish_count >= publish_decimation_) {
+                publish_count = 0;
+                pubTopic();
+                updateStatistics(time_current);
+            }
+
+            if (sample_read && !first_sample_traced_.exchange(true)) {
+                DATC_LOG_INFO("[Startup] First grp_state sample: %.0f ms", getProcessUptimeMs());
+            }
+        } else {
+            // No period across an inactive stretch, and the state is sent in full again afterwards
+            stat_has_prev_       = false;
+            transition_has_prev_ = false;
+
+            writeShm(false);
+            resetEstimator();
+            resetHealth();
+
+            cancelSequence(active_ ? "Connection lost" : "The interface is not active");
+            reportSequence();
+        }
+
+        sendTcpStatus();
+        onPollCycle(time_current, sample_read);
+
+        // Absolute deadlines so that the bus transaction time does not accumulate as drift
+        advanceDeadline(time_next, poll_rate_);
+        sleepUntilPoll(time_next);
+    }
+}
+
+RCLCPP_COMPONENTS_REGISTER_NODE(DatcRosInterface)
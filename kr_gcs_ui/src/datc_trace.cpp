@@ -0,0 +1,56 @@
+/**
+ * @file datc_trace.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Probes of the kr_gcs_ui provider. Only compiled with KR_GCS_TRACING, so that the tracepoints
+ *        are defined in datc_driver alone and every other module just calls these functions.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#define TRACEPOINT_CREATE_PROBES
+#define TRACEPOINT_DEFINE
+#include "datc_tracepoints.h"
+
+#include "datc_trace.hpp"
+
+void datc_trace_service_entry(const char *name) {
+    tracepoint(kr_gcs_ui, service_entry, name);
+}
+
+void datc_trace_service_exit(const char *name, bool success) {
+    tracepoint(kr_gcs_ui, service_exit, name, success);
+}
+
+void datc_trace_command_enqueue(uint64_t id, const char *name) {
+    tracepoint(kr_gcs_ui, command_enqueue, id, name);
+}
+
+void datc_trace_command_dequeue(uint64_t id) {
+    tracepoint(kr_gcs_ui, command_dequeue, id);
+}
+
+void datc_trace_command_exit(uint64_t id, bool success) {
+    tracepoint(kr_gcs_ui, command_exit, id, success);
+}
+
+void datc_trace_bus_lock_request(int function) {
+    tracepoint(kr_gcs_ui, bus_lock_request, function);
+}
+
+void datc_trace_bus_lock_acquired(int function) {
+    tracepoint(kr_gcs_ui, bus_lock_acquired, function);
+}
+
+void datc_trace_frame_tx(int function, int reg_addr, int count) {
+    tracepoint(kr_gcs_ui, frame_tx, function, reg_addr, count);
+}
+
+void datc_trace_frame_rx(int function, int reg_addr, bool success) {
+    tracepoint(kr_gcs_ui, frame_rx, function, reg_addr, success);
+}
+
+void datc_trace_status_sample(uint16_t states, int16_t motor_vel, uint16_t finger_pos) {
+    tracepoint(kr_gcs_ui, status_sample, states, motor_vel, finger_pos);
+}
@@ -0,0 +1,127 @@
+/**
+ * @file grasp_detector.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "grasp_detector.hpp"
+
+#include <cstdlib>
+
+const double kBaselineAlpha = 0.2; // EMA of the free motion current
+
+string GraspProfile::check() const {
+    if (arm_velocity < 1) {
+        return "arm_velocity must be at least 1";
+    } else if (current_rise_ma < 1) {
+        return "current_rise_ma must be at least 1";
+    } else if (plateau_pos < 0) {
+        return "plateau_pos must not be negative";
+    } else if (!(velocity_drop > 0 && velocity_drop <= 1)) {
+        return "velocity_drop must be within (0, 1]";
+    } else if (confirm_samples < 1) {
+        return "confirm_samples must be at least 1";
+    } else if (hold_current_ma < 0 || hold_current_ma > kCurMax) {
+        return "hold_current_ma must be within [0, " + to_string(kCurMax) + "]";
+    }
+
+    return "";
+}
+
+bool GraspProfile::parseAction(const string &str, GRASP_ACTION &action) {
+    if (str == "stop") {
+        action = GRASP_ACTION::STOP;
+    } else if (str == "hold") {
+        action = GRASP_ACTION::HOLD;
+    } else if (str == "none") {
+        action = GRASP_ACTION::NONE;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+const char *GraspProfile::getActionName(GRASP_ACTION action) {
+    switch (action) {
+        case GRASP_ACTION::STOP: return "stop";
+        case GRASP_ACTION::HOLD: return "hold";
+        default:                 return "none";
+    }
+}
+
+void GraspDetector::reset() {
+    armed_         = false;
+    has_prev_      = false;
+    hits_          = 0;
+    rise_onset_ns_ = -1;
+}
+
+bool GraspDetector::update(const DatcStatus &status, int64_t time_ns) {
+    const int vel  = abs(status.motor_vel);
+    const int cur  = abs(status.motor_cur);
+    const int dpos = has_prev_ ? abs((int) status.finger_pos - (int) finger_pos_prev_) : 0;
+
+    const bool first = !has_prev_;
+
+    finger_pos_prev_ = status.finger_pos;
+    has_prev_        = true;
+
+    if (!armed_) {
+        if (vel >= profile_.arm_velocity) {
+            armed_         = true;
+            peak_vel_      = vel;
+            baseline_cur_  = cur;
+            hits_          = 0;
+            rise_onset_ns_ = -1;
+        }
+
+        return false;
+    }
+
+    if (vel > peak_vel_) {
+        peak_vel_ = vel;
+    }
+
+    const bool current_rise = cur - baseline_cur_ >= profile_.current_rise_ma;
+    const bool plateau      = !first && dpos <= profile_.plateau_pos;
+    const bool vel_drop     = vel <= profile_.velocity_drop * peak_vel_;
+
+    if (current_rise) {
+        if (rise_onset_ns_ < 0) {
+            rise_onset_ns_ = time_ns;
+        }
+    } else {
+        rise_onset_ns_ = -1;
+        baseline_cur_ += (cur - baseline_cur_) * kBaselineAlpha;
+    }
+
+    if (current_rise && plateau && vel_drop) {
+        if (++hits_ >= profile_.confirm_samples) {
+            contact_.finger_pos = status.finger_pos;
+            contact_.motor_pos  = status.motor_pos;
+            contact_.motor_cur  = status.motor_cur;
+            contact_.peak_vel   = (int16_t) peak_vel_;
+            contact_.onset_ns   = rise_onset_ns_;
+            contact_.detect_ns  = time_ns;
+
+            // Re-armed by the next motion
+            armed_ = false;
+
+            return true;
+        }
+    } else {
+        hits_ = 0;
+
+        // Stopped without a contact
+        if (status.motor_vel == 0 && !current_rise) {
+            armed_ = false;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,373 @@
+/**
+ * @file health_stats.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "health_stats.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+
+void RunningStats::add(double x) {
+    count++;
+
+    const double delta = x - mean;
+    mean += delta / count;
+    m2   += delta * (x - mean);
+
+    min = (count == 1 || x < min) ? x : min;
+    max = (count == 1 || x > max) ? x : max;
+}
+
+// Chan et al., pairwise combination of two Welford accumulators
+void RunningStats::merge(const RunningStats &other) {
+    if (other.count == 0) {
+        return;
+    } else if (count == 0) {
+        *this = other;
+        return;
+    }
+
+    const double n     = (double) count + other.count;
+    const double delta = other.mean - mean;
+
+    mean += delta * other.count / n;
+    m2   += other.m2 + delta * delta * count * other.count / n;
+    min   = std::min(min, other.min);
+    max   = std::max(max, other.max);
+    count += other.count;
+}
+
+double RunningStats::getStdDev() const {
+    return count > 1 ? std::sqrt(std::max(0.0, m2 / (count - 1))) : 0.0;
+}
+
+void WindowedMetric::add(size_t slot, double x) {
+    stats_[slot].add(x);
+
+    const double scaled = (x - range_min_) / (range_max_ - range_min_) * kHealthHistogramBins;
+    const size_t bin    = (size_t) std::min(std::max(scaled, 0.0), (double) (kHealthHistogramBins - 1));
+
+    bins_[slot][bin]++;
+}
+
+void WindowedMetric::clearSlot(size_t slot) {
+    stats_[slot] = RunningStats();
+    memset(bins_[slot], 0, sizeof(bins_[slot]));
+}
+
+void WindowedMetric::clear() {
+    for (size_t i = 0; i < kHealthWindowSlots; i++) {
+        clearSlot(i);
+    }
+}
+
+MetricSummary WindowedMetric::summarize() const {
+    RunningStats stats;
+    uint64_t bins[kHealthHistogramBins] = {0};
+
+    for (size_t i = 0; i < kHealthWindowSlots; i++) {
+        stats.merge(stats_[i]);
+
+        for (size_t b = 0; b < kHealthHistogramBins; b++) {
+            bins[b] += bins_[i][b];
+        }
+    }
+
+    MetricSummary summary;
+
+    summary.count   = stats.count;
+    summary.mean    = stats.mean;
+    summary.std_dev = stats.getStdDev();
+    summary.min     = stats.min;
+    summary.max     = stats.max;
+
+    if (stats.count == 0) {
+        return summary;
+    }
+
+    // Linear within the bin, and never outside what was seen
+    const double width = (range_max_ - range_min_) / kHealthHistogramBins;
+
+    auto quantile = [&] (double q) {
+        const double target = q * stats.count;
+        double below = 0;
+
+        for (size_t b = 0; b < kHealthHistogramBins; b++) {
+            if (bins[b] > 0 && below + bins[b] >= target) {
+                const double value = range_min_ + (b + (target - below) / bins[b]) * width;
+                return std::min(std::max(value, stats.min), stats.max);
+            }
+
+            below += bins[b];
+        }
+
+        return stats.max;
+    };
+
+    summary.p50 = quantile(0.5);
+    summary.p90 = quantile(0.9);
+    summary.p99 = quantile(0.99);
+
+    return summary;
+}
+
+void WearCounters::add(const WearCounters &other) {
+    samples          += other.samples;
+    read_errors      += other.read_errors;
+    commands         += other.commands;
+    open_cycles      += other.open_cycles;
+    close_cycles     += other.close_cycles;
+    faults           += other.faults;
+    motor_travel_deg += other.motor_travel_deg;
+    connected_s      += other.connected_s;
+}
+
+// A missing file is a gripper seen for the first time: true, with zeros
+bool loadWearCounters(const string &path, WearCounters &counters, string &error) {
+    counters = WearCounters();
+
+    FILE *file = fopen(path.c_str(), "r");
+
+    if (file == NULL) {
+        if (errno == ENOENT) {
+            return true;
+        }
+
+        error = "Cannot open " + path + ": " + strerror(errno);
+        return false;
+    }
+
+    char key[64];
+    double value;
+
+    while (fscanf(file, "%63s %lf", key, &value) == 2) {
+        const string name = key;
+
+        if (name == "samples")               counters.samples          = (uint64_t) value;
+        else if (name == "read_errors")      counters.read_errors      = (uint64_t) value;
+        else if (name == "commands")         counters.commands         = (uint64_t) value;
+        else if (name == "open_cycles")      counters.open_cycles      = (uint64_t) value;
+        else if (name == "close_cycles")     counters.close_cycles     = (uint64_t) value;
+        else if (name == "faults")           counters.faults           = (uint64_t) value;
+        else if (name == "motor_travel_deg") counters.motor_travel_deg = value;
+        else if (name == "connected_s")      counters.connected_s      = value;
+    }
+
+    fclose(file);
+
+    return true;
+}
+
+bool saveWearCounters(const string &path, const WearCounters &counters, string &error) {
+    const string temp_path = path + ".tmp";
+    FILE *file = fopen(temp_path.c_str(), "w");
+
+    if (file == NULL) {
+        error = "Cannot write " + temp_path + ": " + strerror(errno);
+        return false;
+    }
+
+    fprintf(file, "samples %lu\n", (unsigned long) counters.samples);
+    fprintf(file, "read_errors %lu\n", (unsigned long) counters.read_errors);
+    fprintf(file, "commands %lu\n", (unsigned long) counters.commands);
+    fprintf(file, "open_cycles %lu\n", (unsigned long) counters.open_cycles);
+    fprintf(file, "close_cycles %lu\n", (unsigned long) counters.close_cycles);
+    fprintf(file, "faults %lu\n", (unsigned long) counters.faults);
+    fprintf(file, "motor_travel_deg %.1f\n", counters.motor_travel_deg);
+    fprintf(file, "connected_s %.1f\n", counters.connected_s);
+
+    const bool written = fflush(file) == 0 && fsync(fileno(file)) == 0;
+    fclose(file);
+
+    if (!written || rename(temp_path.c_str(), path.c_str()) != 0) {
+        error = "Cannot write " + path + ": " + strerror(errno);
+        return false;
+    }
+
+    return true;
+}
+
+HealthStats::HealthStats() :
+    grasp_current_(0, kCurMax * 1.25), close_time_ms_(0, 10000), open_time_ms_(0, 10000), voltage_(0, 500) {
+    setWindow(kHealthWindowDefaultS);
+}
+
+void HealthStats::setWindow(double window_s) {
+    window_ns_ = (int64_t) (std::min(std::max(window_s, kHealthWindowMinS), kHealthWindowMaxS) * 1e9);
+    slot_ns_   = window_ns_ / kHealthWindowSlots;
+
+    clearWindow();
+}
+
+void HealthStats::clearWindow() {
+    for (size_t i = 0; i < kHealthWindowSlots; i++) {
+        counters_[i] = SlotCounters();
+    }
+
+    grasp_current_.clear();
+    close_time_ms_.clear();
+    open_time_ms_.clear();
+    voltage_.clear();
+
+    slot_id_         = -1;
+    window_start_ns_ = -1;
+}
+
+// Slot of time_ns, clearing the ones that fell out of the window on the way
+size_t HealthStats::advance(int64_t time_ns) {
+    const int64_t id = time_ns / slot_ns_;
+
+    if (slot_id_ < 0) {
+        slot_id_         = id;
+        window_start_ns_ = time_ns;
+    } else if (id > slot_id_) {
+        const int64_t steps = std::min<int64_t>(id - slot_id_, kHealthWindowSlots);
+
+        for (int64_t i = 1; i <= steps; i++) {
+            const size_t slot = (slot_id_ + i) % kHealthWindowSlots;
+
+            counters_[slot] = SlotCounters();
+            grasp_current_.clearSlot(slot);
+            close_time_ms_.clearSlot(slot);
+            open_time_ms_.clearSlot(slot);
+            voltage_.clearSlot(slot);
+        }
+
+        slot_id_ = id;
+    }
+
+    return slot_id_ % kHealthWindowSlots;
+}
+
+void HealthStats::addCommands(uint32_t commands, uint16_t last_code, int64_t last_ns) {
+    if (commands == 0) {
+        return;
+    }
+
+    wear_.commands += commands;
+
+    // Any other command ends the motion being timed
+    if (last_code == (uint16_t) DATC_COMMAND::GRIPPER_CLOSE || last_code == (uint16_t) DATC_COMMAND::GRIPPER_OPEN) {
+        motion_command_  = last_code;
+        motion_start_ns_ = last_ns;
+    } else {
+        motion_command_ = 0;
+    }
+}
+
+void HealthStats::addSample(const DatcStatus &status, int64_t time_ns, bool motor_read, bool voltage_read) {
+    const size_t slot = advance(time_ns);
+    SlotCounters &counters = counters_[slot];
+
+    wear_.samples++;
+
+    if (has_prev_) {
+        const int64_t gap_ns = time_ns - prev_ns_;
+
+        if (gap_ns > 0 && gap_ns < kHealthGapNs) {
+            wear_.connected_s += gap_ns * 1e-9;
+        }
+
+        if (status.grp_open && !prev_open_) {
+            wear_.open_cycles++;
+            counters.open_cycles++;
+
+            if (motion_command_ == (uint16_t) DATC_COMMAND::GRIPPER_OPEN) {
+                open_time_ms_.add(slot, (time_ns - motion_start_ns_) * 1e-6);
+                motion_command_ = 0;
+            }
+        }
+
+        if (status.grp_close && !prev_close_) {
+            wear_.close_cycles++;
+            counters.close_cycles++;
+
+            if (motion_command_ == (uint16_t) DATC_COMMAND::GRIPPER_CLOSE) {
+                close_time_ms_.add(slot, (time_ns - motion_start_ns_) * 1e-6);
+                motion_command_ = 0;
+            }
+        }
+
+        if (status.fault && !prev_fault_) {
+            wear_.faults++;
+            counters.faults++;
+        }
+    }
+
+    if (motor_read) {
+        // int16 difference, so that a position that wraps around counts the short way
+        if (has_prev_motor_) {
+            wear_.motor_travel_deg += std::abs((int16_t) (status.motor_pos - prev_motor_pos_));
+        }
+
+        if (status.grp_close) {
+            grasp_current_.add(slot, std::abs(status.motor_cur));
+        }
+
+        prev_motor_pos_ = status.motor_pos;
+        has_prev_motor_ = true;
+    }
+
+    if (voltage_read) {
+        voltage_.add(slot, status.voltage);
+    }
+
+    prev_open_  = status.grp_open;
+    prev_close_ = status.grp_close;
+    prev_fault_ = status.fault;
+    prev_ns_    = time_ns;
+    has_prev_   = true;
+}
+
+void HealthStats::addReadError(int64_t time_ns) {
+    counters_[advance(time_ns)].read_errors++;
+    wear_.read_errors++;
+}
+
+void HealthStats::resetEdges() {
+    has_prev_       = false;
+    has_prev_motor_ = false;
+    motion_command_ = 0;
+}
+
+HealthSummary HealthStats::summarize(int64_t time_ns) {
+    HealthSummary summary;
+
+    summary.wear = wear_;
+
+    if (slot_id_ < 0) {
+        return summary;
+    }
+
+    advance(time_ns);
+
+    for (size_t i = 0; i < kHealthWindowSlots; i++) {
+        summary.window_open_cycles  += counters_[i].open_cycles;
+        summary.window_close_cycles += counters_[i].close_cycles;
+        summary.window_faults       += counters_[i].faults;
+        summary.window_read_errors  += counters_[i].read_errors;
+    }
+
+    summary.window_s = std::min(time_ns - window_start_ns_, window_ns_) * 1e-9;
+
+    if (summary.window_s > 0) {
+        summary.fault_rate_per_hour = summary.window_faults / (summary.window_s / 3600);
+    }
+
+    summary.grasp_current = grasp_current_.summarize();
+    summary.close_time_ms = close_time_ms_.summarize();
+    summary.open_time_ms  = open_time_ms_.summarize();
+    summary.voltage       = voltage_.summarize();
+
+    return summary;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file jog_stream.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "jog_stream.hpp"
+
+void JogStream::setPeriod(double period_s) {
+    unique_lock<mutex> lg(mutex_);
+    period_ = chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(period_s));
+}
+
+bool JogStream::setTarget(uint16_t target) {
+    unique_lock<mutex> lg(mutex_);
+
+    target_  = target;
+    pending_ = true;
+
+    if (queued_) {
+        return false;
+    }
+
+    queued_ = true;
+    return true;
+}
+
+void JogStream::resetSent() {
+    unique_lock<mutex> lg(mutex_);
+    has_sent_ = false;
+}
+
+void JogStream::cancel() {
+    {
+        unique_lock<mutex> lg(mutex_);
+
+        pending_  = false;
+        queued_   = false;
+        has_sent_ = false;
+        cancels_++;
+    }
+
+    cancel_cv_.notify_all();
+}
+
+bool JogStream::send(function<bool(uint16_t)> send_func) {
+    uint16_t target;
+
+    {
+        unique_lock<mutex> lg(mutex_);
+        const uint64_t cancels = cancels_;
+
+        // Targets set meanwhile replace the one this job was queued for. A cancel ends the wait, and
+        // queued_ is then already reset for the targets after it.
+        if (cancel_cv_.wait_until(lg, time_sent_ + period_, [this, cancels] {return cancels_ != cancels;})) {
+            return true;
+        }
+
+        queued_ = false;
+
+        if (!pending_) {
+            return true;
+        }
+
+        pending_ = false;
+        target   = target_;
+
+        if (has_sent_ && target == sent_) {
+            return true;
+        }
+    }
+
+    const auto time_start = chrono::steady_clock::now();
+    const bool success    = send_func(target);
+
+    unique_lock<mutex> lg(mutex_);
+
+    has_sent_  = success;
+    sent_      = target;
+    time_sent_ = time_start;
+
+    return success;
+}
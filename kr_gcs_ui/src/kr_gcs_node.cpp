@@ -0,0 +1,28 @@
+/**
+ * @file kr_gcs_node.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Headless DATC interface node (no Qt).
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "datc_ros_interface.hpp"
+#include "process_stats.hpp"
+
+int main(int argc, char *argv[]) {
+    rclcpp::init(argc, argv);
+
+    auto node = make_shared<DatcRosInterface>();
+    node->start();
+
+    RCLCPP_INFO(node->get_logger(), "[Startup] Node ready: %.0f ms, RSS: %ld kB", getProcessUptimeMs(), getRssKb());
+
+    rclcpp::spin(node->get_node_base_interface());
+
+    node->stop();
+    rclcpp::shutdown();
+
+    return 0;
+}
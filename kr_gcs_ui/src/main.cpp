@@ -13,6 +13,8 @@
 #include <QFontDatabase>
 
 int main(int argc, char *argv[]) {
+    rclcpp::init(argc, argv);
+
     QApplication app(argc, argv);
 
     // Font load
@@ -26,16 +28,19 @@ int main(int argc, char *argv[]) {
 
     bool flag_init_success = false;
 
-    gripper_ui::MainWindow w(argc, argv, flag_init_success);
+    gripper_ui::MainWindow w(flag_init_success);
 
     if (flag_init_success) {
+        // Startup timing and memory are printed by MainWindow on the first paint
         w.show();
 
         app.connect(&app, SIGNAL(lastWindowClosed()), &app, SLOT(quit()));
         int result = app.exec();
 
+        rclcpp::shutdown();
         return result;
     } else {
+        rclcpp::shutdown();
         return -1;
     }
 }
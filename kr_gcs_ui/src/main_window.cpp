@@ -9,60 +9,89 @@
  *
  */
 #include "main_window.hpp"
+#include "process_stats.hpp"
 
 using namespace Qt;
 
 namespace gripper_ui {
 
-MainWindow::MainWindow(int argc, char **argv, bool &success, QWidget *parent) : QMainWindow(parent) {
+// Initial slider values (%)
+const int kFingerPosInitValue = 50;
+const int kTorqueInitValue    = 100;
+const int kSpeedInitValue     = 75;
+
+const char kTcpAddrDefault[]   = "0.0.0.0";
+const uint16_t kTcpPortDefault = 5000;
+
+const int kImpedanceSettleMs = 100; // After impedance on / off, before initializing
+
+// Same rule as the services: everything else is only accepted while the interface is active
+const QStringList kUngatedCommands = {"modbus_init", "modbus_release", "motor_stop", "motor_disable"};
+
+MainWindow::MainWindow(bool &success, QWidget *parent) : QMainWindow(parent) {
     ui_ = new Ui::MainWindow();
 
-    modbus_widget_         = new ModbusWidget(this);
-    datc_ctrl_widget_      = new DatcCtrlWidget(this);
-    tcp_widget_            = new TcpWidget(this);
-    advanced_ctrl_widget_  = new AdvancedCtrlWidget(this);
-    impedance_ctrl_widget_ = new ImpedanceCtrlWidget(this);
+    // Only the first page is built here; the others are built the first time they are selected
+    modbus_widget_ = new ModbusWidget(this);
 
     ui_->setupUi(this);
 
     //setWindowIcon(QIcon(":/images/icon.png"));
-    datc_interface_ = new DatcCommInterface(argc, argv);
 
-    // Stacked widget
-    ui_->stackedWidget->addWidget(modbus_widget_);
-    ui_->stackedWidget->addWidget(datc_ctrl_widget_);
-    ui_->stackedWidget->addWidget(advanced_ctrl_widget_);
-    ui_->stackedWidget->addWidget(impedance_ctrl_widget_);
+    // ROS node setup runs in parallel with the rest of the window construction and the first paint
+    interface_init_thread_ = thread([this, gui_thread = QThread::currentThread()] () {
+        DatcCommInterface *datc_interface = new DatcCommInterface();
+        datc_interface->moveToThread(gui_thread);
 
-#ifndef RCLCPP__RCLCPP_HPP_
-    ui_->stackedWidget->addWidget(tcp_widget_);
-#endif
+        datc_interface_pending_ = datc_interface;
+        QMetaObject::invokeMethod(this, "onDatcInterfaceReady", Qt::QueuedConnection);
+    });
+
+    // Bus commands from the buttons
+    command_runner_ = new CommandRunner(this);
+    QObject::connect(command_runner_, &CommandRunner::commandFinished,
+                     this, &MainWindow::onCommandFinished, Qt::QueuedConnection);
 
-    ui_->stackedWidget->setCurrentIndex((int) WidgetSeq::MODBUS_WIDGET);
+    // Stacked widget
+    ui_->stackedWidget->addWidget(modbus_widget_);
 
     // GUI setting
+    // Styles are parsed once; switching them afterwards only re-polishes through a dynamic property
+    // (menu buttons) or the :enabled/:disabled pseudo-states (command buttons).
     menu_btn_active_str_   = "background-color:#FFFFFF;color:#000000";
     menu_btn_inactive_str_ = "background-color:#888888;color:#FFFFFF";
 
     btn_active_str_   = "background-color:#FFFFFF;color:#888888;border-style:outset;border-width:7;";
     btn_inactive_str_ = "background-color:#BBBBBB;color:#888888;border-style:inset;border-width:7;";
 
-    // Initial value setting
-    int finger_pos_init_value = 50;
-    int torque_init_value = 100;
-    int speed_init_value  = 75;
+    const QString menu_btn_qss = "QPushButton[active=\"true\"]{"  + menu_btn_active_str_   + "}" +
+                                 "QPushButton[active=\"false\"]{" + menu_btn_inactive_str_ + "}";
+    cmd_state_qss_ = "QPushButton[cmd_state=\"pending\"]{background-color:#E0A030;color:#FFFFFF;}"
+                     "QPushButton[cmd_state=\"failed\"]{background-color:#C03030;color:#FFFFFF;}";
+    btn_qss_ = "QPushButton:enabled{"  + btn_active_str_   + "}" +
+               "QPushButton:disabled{" + btn_inactive_str_ + "}" + cmd_state_qss_;
 
-    datc_ctrl_widget_->ui_.horizontalSlider_finger_pos->setValue(finger_pos_init_value);
-    datc_ctrl_widget_->ui_.verticalSlider_torque->setValue      (torque_init_value);
-    datc_ctrl_widget_->ui_.verticalSlider_speed ->setValue      (speed_init_value);
+    for (auto btn : {ui_->pushButton_select_modbus, ui_->pushButton_select_datc_ctrl, ui_->pushButton_select_adv,
+                     ui_->pushButton_select_tcp, ui_->pushButton_select_imped_ctrl, ui_->pushButton_select_plot}) {
+        btn->setStyleSheet(menu_btn_qss);
+    }
 
-    datc_ctrl_widget_->ui_.doubleSpinBox_finger_pos->setValue((double) finger_pos_init_value);
-    datc_ctrl_widget_->ui_.doubleSpinBox_torque->setValue    ((double) torque_init_value);
-    datc_ctrl_widget_->ui_.doubleSpinBox_speed->setValue     ((double) speed_init_value);
+    selectPage(WidgetSeq::MODBUS_WIDGET);
 
-    // Initial values setting of impedance ctrl widget
-    impedance_ctrl_widget_->ui_.horizontalSlider_finger_pos->setValue(finger_pos_init_value);
-    impedance_ctrl_widget_->ui_.doubleSpinBox_finger_pos->setValue((double) finger_pos_init_value);
+    for (auto btn : {modbus_widget_->ui_.pushButton_modbus_start, modbus_widget_->ui_.pushButton_modbus_stop,
+                     modbus_widget_->ui_.pushButton_modbus_set_slave_addr,
+                     modbus_widget_->ui_.pushButton_modbus_slave_change}) {
+        btn->setStyleSheet(btn_qss_);
+        btn->setEnabled(false);
+    }
+
+    // Pages that command the DATC wait for the ROS interface
+    for (auto btn : {ui_->pushButton_select_datc_ctrl, ui_->pushButton_select_adv, ui_->pushButton_select_tcp,
+                     ui_->pushButton_select_imped_ctrl, ui_->pushButton_select_plot}) {
+        btn->setEnabled(false);
+    }
+
+    ui_->lineEdit_monitor_mode->setText(" Starting ROS interface...");
 
     // Combo box setting
     modbus_widget_->ui_.comboBox_serial_port->setEnabled(true);
@@ -78,19 +107,143 @@ MainWindow::MainWindow(int argc, char **argv, bool &success, QWidget *parent) :
     modbus_widget_->ui_.comboBox_baudrate->addItems({"9600", "19200", "38400", "57600", "115200"});
     modbus_widget_->ui_.comboBox_baudrate->setCurrentIndex(4);
 
-    // Check box setting
-    QString checkbox_qstr = "QCheckBox::indicator {width:25px; height: 25px;}";
+    // Modbus RTU related btn
+    QObject::connect(modbus_widget_->ui_.pushButton_modbus_start, SIGNAL(clicked()), this, SLOT(initModbus()));
+    QObject::connect(modbus_widget_->ui_.pushButton_modbus_stop , SIGNAL(clicked()), this, SLOT(releaseModbus()));
+    QObject::connect(modbus_widget_->ui_.pushButton_modbus_slave_change  , SIGNAL(clicked()), this, SLOT(changeSlaveAddress()));
+    QObject::connect(modbus_widget_->ui_.pushButton_modbus_set_slave_addr, SIGNAL(clicked()), this, SLOT(setSlaveAddr()));
+
+    traceStartup("Window constructed");
+    success = true;
+}
 
-    tcp_widget_->ui_.checkBox_tcp_send_status->setStyleSheet(checkbox_qstr);
+MainWindow::~MainWindow() {
+    // Queued commands still refer to datc_interface_
+    command_runner_->stop();
 
-    checkbox_qstr = "QCheckBox::indicator {width:20px; height: 20px;}";
+    if (interface_init_thread_.joinable()) {
+        interface_init_thread_.join();
+    }
 
-    advanced_ctrl_widget_->ui_.checkBox_motor_speed_reverse  ->setStyleSheet(checkbox_qstr);
-    advanced_ctrl_widget_->ui_.checkBox_motor_current_reverse->setStyleSheet(checkbox_qstr);
+    if (port_scan_thread_.joinable()) {
+        port_scan_thread_.join();
+    }
 
-    // Label
-    advanced_ctrl_widget_->ui_.label_motor_speed  ->setText("(100 % : " + QString::number(kVelMax) + " rpm)");
-    advanced_ctrl_widget_->ui_.label_motor_current->setText("(100 % : " + QString::number(kCurMax) + " mA)");
+    // Only one of the two is set, depending on whether onDatcInterfaceReady() ran
+    delete datc_interface_;
+    delete datc_interface_pending_;
+}
+
+void MainWindow::onDatcInterfaceReady() {
+    interface_init_thread_.join();
+
+    datc_interface_ = datc_interface_pending_;
+    datc_interface_pending_ = NULL;
+
+    traceStartup("ROS interface ready");
+
+    for (auto btn : {ui_->pushButton_select_datc_ctrl, ui_->pushButton_select_adv, ui_->pushButton_select_tcp,
+                     ui_->pushButton_select_imped_ctrl, ui_->pushButton_select_plot}) {
+        btn->setEnabled(true);
+    }
+
+    ui_->lineEdit_monitor_mode->setText("");
+
+    // Status display is driven by the poll thread, which only signals on change
+    updateDatcSnapshot(DatcSnapshot());
+    QObject::connect(datc_interface_, &DatcCommInterface::datcSnapshotUpdated,
+                     this, &MainWindow::updateDatcSnapshot, Qt::QueuedConnection);
+
+    // From here on the port list follows hotplug events instead of the refresh button
+    QObject::connect(datc_interface_, &DatcCommInterface::serialPortsChanged,
+                     this, &MainWindow::setSerialPortList, Qt::QueuedConnection);
+
+    datc_interface_->start();
+
+    if (!port_scan_thread_.joinable()) {
+        QStringList ports;
+
+        for (const auto &port : datc_interface_->getSerialPorts()) {
+            ports << QString::fromStdString(port);
+        }
+
+        setSerialPortList(ports);
+    }
+}
+
+void MainWindow::paintEvent(QPaintEvent *event) {
+    QMainWindow::paintEvent(event);
+
+    if (!first_paint_traced_) {
+        first_paint_traced_ = true;
+        COUT("[Startup] First paint: " << getProcessUptimeMs() << " ms, RSS: " << getRssKb() << " kB");
+    }
+}
+
+void MainWindow::traceStartup(const char *event) {
+    COUT("[Startup] " << event << ": " << getProcessUptimeMs() << " ms");
+}
+
+QWidget *MainWindow::getPage(WidgetSeq seq) {
+    switch (seq) {
+    case WidgetSeq::MODBUS_WIDGET:
+        return modbus_widget_;
+
+    case WidgetSeq::DATC_CTRL_WIDGET:
+        if (datc_ctrl_widget_ == NULL) {
+            setupDatcCtrlWidget();
+        }
+        return datc_ctrl_widget_;
+
+    case WidgetSeq::ADVANCED_CTRL_WIDGET:
+        if (advanced_ctrl_widget_ == NULL) {
+            setupAdvancedCtrlWidget();
+        }
+        return advanced_ctrl_widget_;
+
+    case WidgetSeq::IMPEDANCE_CTRL_WIDGET:
+        if (impedance_ctrl_widget_ == NULL) {
+            setupImpedanceCtrlWidget();
+        }
+        return impedance_ctrl_widget_;
+
+    case WidgetSeq::TELEMETRY_WIDGET:
+        if (telemetry_widget_ == NULL) {
+            telemetry_widget_ = new TelemetryWidget(datc_interface_->getTelemetry(), this);
+            ui_->stackedWidget->addWidget(telemetry_widget_);
+        }
+        return telemetry_widget_;
+
+    case WidgetSeq::TCP_WIDGET:
+        if (tcp_widget_ == NULL) {
+            setupTcpWidget();
+        }
+        return tcp_widget_;
+    }
+
+    return modbus_widget_;
+}
+
+void MainWindow::setupDatcCtrlWidget() {
+    datc_ctrl_widget_ = new DatcCtrlWidget(this);
+    ui_->stackedWidget->addWidget(datc_ctrl_widget_);
+
+    // Initial value setting
+    datc_ctrl_widget_->ui_.horizontalSlider_finger_pos->setValue(kFingerPosInitValue);
+    datc_ctrl_widget_->ui_.verticalSlider_torque->setValue      (kTorqueInitValue);
+    datc_ctrl_widget_->ui_.verticalSlider_speed ->setValue      (kSpeedInitValue);
+
+    datc_ctrl_widget_->ui_.doubleSpinBox_finger_pos->setValue((double) kFingerPosInitValue);
+    datc_ctrl_widget_->ui_.doubleSpinBox_torque->setValue    ((double) kTorqueInitValue);
+    datc_ctrl_widget_->ui_.doubleSpinBox_speed->setValue     ((double) kSpeedInitValue);
+
+    // Slider & spin box synchronization
+    syncSliderSpinbox(datc_ctrl_widget_->ui_.horizontalSlider_finger_pos, datc_ctrl_widget_->ui_.doubleSpinBox_finger_pos);
+    syncSliderSpinbox(datc_ctrl_widget_->ui_.verticalSlider_torque      , datc_ctrl_widget_->ui_.doubleSpinBox_torque);
+    syncSliderSpinbox(datc_ctrl_widget_->ui_.verticalSlider_speed       , datc_ctrl_widget_->ui_.doubleSpinBox_speed);
+
+    setupJog(datc_ctrl_widget_->ui_.horizontalSlider_finger_pos, datc_ctrl_widget_->ui_.doubleSpinBox_finger_pos,
+             datc_ctrl_widget_->ui_.checkBox_jog, datc_ctrl_widget_->ui_.pushButton_set_position);
 
     // DATC control related btn
     QObject::connect(datc_ctrl_widget_->ui_.pushButton_cmd_enable  , SIGNAL(clicked()), this, SLOT(datcEnable()));
@@ -106,6 +259,32 @@ MainWindow::MainWindow(int argc, char **argv, bool &success, QWidget *parent) :
 
     QObject::connect(datc_ctrl_widget_->ui_.pushButton_set_torque, SIGNAL(clicked()), this, SLOT(datcSetTorque()));
     QObject::connect(datc_ctrl_widget_->ui_.pushButton_set_speed , SIGNAL(clicked()), this, SLOT(datcSetSpeed()));
+}
+
+void MainWindow::setupAdvancedCtrlWidget() {
+    advanced_ctrl_widget_ = new AdvancedCtrlWidget(this);
+    ui_->stackedWidget->addWidget(advanced_ctrl_widget_);
+
+    // Slider & spin box synchronization
+    const int vel_min_percent = (int) ((double) kVelMin / (double) kVelMax * 100);
+
+    advanced_ctrl_widget_->ui_.horizontalSlider_motor_speed->setMinimum(vel_min_percent);
+    advanced_ctrl_widget_->ui_.doubleSpinBox_motor_speed   ->setMinimum((double) vel_min_percent);
+
+    syncSliderSpinbox(advanced_ctrl_widget_->ui_.horizontalSlider_motor_speed,
+                      advanced_ctrl_widget_->ui_.doubleSpinBox_motor_speed);
+    syncSliderSpinbox(advanced_ctrl_widget_->ui_.horizontalSlider_motor_current,
+                      advanced_ctrl_widget_->ui_.doubleSpinBox_motor_current);
+
+    // Check box setting
+    const QString checkbox_qstr = "QCheckBox::indicator {width:20px; height: 20px;}";
+
+    advanced_ctrl_widget_->ui_.checkBox_motor_speed_reverse  ->setStyleSheet(checkbox_qstr);
+    advanced_ctrl_widget_->ui_.checkBox_motor_current_reverse->setStyleSheet(checkbox_qstr);
+
+    // Label
+    advanced_ctrl_widget_->ui_.label_motor_speed  ->setText("(100 % : " + QString::number(kVelMax) + " rpm)");
+    advanced_ctrl_widget_->ui_.label_motor_current->setText("(100 % : " + QString::number(kCurMax) + " mA)");
 
     // Advanced control related btn
     QObject::connect(advanced_ctrl_widget_->ui_.pushButton_cmd_enable  , SIGNAL(clicked()), this, SLOT(datcEnable()));
@@ -120,12 +299,21 @@ MainWindow::MainWindow(int argc, char **argv, bool &success, QWidget *parent) :
 
     QObject::connect(advanced_ctrl_widget_->ui_.pushButton_set_motor_speed  , SIGNAL(clicked()), this, SLOT(datcMotorVelCtrl()));
     QObject::connect(advanced_ctrl_widget_->ui_.pushButton_set_motor_current, SIGNAL(clicked()), this, SLOT(datcMotorCurCtrl()));
+}
 
-    // Modbus RTU related btn
-    QObject::connect(modbus_widget_->ui_.pushButton_modbus_start, SIGNAL(clicked()), this, SLOT(initModbus()));
-    QObject::connect(modbus_widget_->ui_.pushButton_modbus_stop , SIGNAL(clicked()), this, SLOT(releaseModbus()));
-    QObject::connect(modbus_widget_->ui_.pushButton_modbus_slave_change  , SIGNAL(clicked()), this, SLOT(changeSlaveAddress()));
-    QObject::connect(modbus_widget_->ui_.pushButton_modbus_set_slave_addr, SIGNAL(clicked()), this, SLOT(setSlaveAddr()));
+void MainWindow::setupImpedanceCtrlWidget() {
+    impedance_ctrl_widget_ = new ImpedanceCtrlWidget(this);
+    ui_->stackedWidget->addWidget(impedance_ctrl_widget_);
+
+    // Initial values setting of impedance ctrl widget
+    impedance_ctrl_widget_->ui_.horizontalSlider_finger_pos->setValue(kFingerPosInitValue);
+    impedance_ctrl_widget_->ui_.doubleSpinBox_finger_pos->setValue((double) kFingerPosInitValue);
+
+    syncSliderSpinbox(impedance_ctrl_widget_->ui_.horizontalSlider_finger_pos,
+                      impedance_ctrl_widget_->ui_.doubleSpinBox_finger_pos);
+
+    setupJog(impedance_ctrl_widget_->ui_.horizontalSlider_finger_pos, impedance_ctrl_widget_->ui_.doubleSpinBox_finger_pos,
+             impedance_ctrl_widget_->ui_.checkBox_jog, impedance_ctrl_widget_->ui_.pushButton_set_position);
 
     // Impedance control related btn
     QObject::connect(impedance_ctrl_widget_->ui_.pushButton_cmd_impedance_on       , SIGNAL(clicked()), this, SLOT(datcImpedanceOn()));
@@ -142,351 +330,479 @@ MainWindow::MainWindow(int argc, char **argv, bool &success, QWidget *parent) :
     QObject::connect(impedance_ctrl_widget_->ui_.pushButton_cmd_grp_stop      , SIGNAL(clicked()), this, SLOT(datcStop()));
     QObject::connect(impedance_ctrl_widget_->ui_.pushButton_cmd_grp_vacuum_on , SIGNAL(clicked()), this, SLOT(datcVacuumGrpOn()));
     QObject::connect(impedance_ctrl_widget_->ui_.pushButton_cmd_grp_vacuum_off, SIGNAL(clicked()), this, SLOT(datcVacuumGrpOff()));
+}
+
+void MainWindow::setupTcpWidget() {
+    tcp_widget_ = new TcpWidget(this);
+    ui_->stackedWidget->addWidget(tcp_widget_);
+
+    for (auto btn : {tcp_widget_->ui_.pushButton_tcp_start, tcp_widget_->ui_.pushButton_tcp_stop}) {
+        btn->setStyleSheet(btn_qss_);
+    }
+
+    // Check box setting
+    tcp_widget_->ui_.checkBox_tcp_send_status->setStyleSheet("QCheckBox::indicator {width:25px; height: 25px;}");
+
+    if (tcp_widget_->ui_.lineEdit_tcp_addr->text().isEmpty()) {
+        tcp_widget_->ui_.lineEdit_tcp_addr->setText(kTcpAddrDefault);
+    }
+
+    if (tcp_widget_->ui_.lineEdit_tcp_port->text().isEmpty()) {
+        tcp_widget_->ui_.lineEdit_tcp_port->setText(QString::number(kTcpPortDefault));
+    }
 
-#ifndef RCLCPP__RCLCPP_HPP_
     // TCP socket commiunication related btn
     QObject::connect(tcp_widget_->ui_.pushButton_tcp_start, SIGNAL(clicked()), this, SLOT(startTcpComm()));
     QObject::connect(tcp_widget_->ui_.pushButton_tcp_stop , SIGNAL(clicked()), this, SLOT(stopTcpComm()));
-#else
-    ui_->pushButton_select_tcp->setHidden(true);
-#endif
+    QObject::connect(tcp_widget_->ui_.checkBox_tcp_send_status, &QCheckBox::toggled, this, [this] (bool checked) {
+        datc_interface_->setTcpSendStatus(checked);
+    });
 
-    timer_ = new QTimer(this);
-    connect(timer_, SIGNAL(timeout()), this, SLOT(timerCallback()));
-    timer_->start(100); // msec
+    datc_interface_->setTcpSendStatus(tcp_widget_->ui_.checkBox_tcp_send_status->isChecked());
 
-    datc_interface_->start();
-    success = true;
+    // Built after the first snapshot, so the buttons start from the current state
+    tcp_widget_->ui_.pushButton_tcp_start->setEnabled(!snapshot_prev_.tcp_running);
+    tcp_widget_->ui_.pushButton_tcp_stop ->setEnabled(snapshot_prev_.tcp_running);
 }
 
-MainWindow::~MainWindow() {
-    if(datc_interface_ != NULL) {
-        datc_interface_->~DatcCommInterface();
-    }
+void MainWindow::selectPage(WidgetSeq seq) {
+    ui_->stackedWidget->setCurrentWidget(getPage(seq));
 
-    if(timer_ != NULL) {
-        delete timer_;
-    }
+    setMenuButtonActive(ui_->pushButton_select_modbus    , seq == WidgetSeq::MODBUS_WIDGET);
+    setMenuButtonActive(ui_->pushButton_select_datc_ctrl , seq == WidgetSeq::DATC_CTRL_WIDGET);
+    setMenuButtonActive(ui_->pushButton_select_adv       , seq == WidgetSeq::ADVANCED_CTRL_WIDGET);
+    setMenuButtonActive(ui_->pushButton_select_tcp       , seq == WidgetSeq::TCP_WIDGET);
+    setMenuButtonActive(ui_->pushButton_select_imped_ctrl, seq == WidgetSeq::IMPEDANCE_CTRL_WIDGET);
+    setMenuButtonActive(ui_->pushButton_select_plot      , seq == WidgetSeq::TELEMETRY_WIDGET);
 }
 
-void MainWindow::timerCallback() {
-    static std::function setButtonStyle([=] (QPushButton *btn) {
-        bool is_activated = btn->isEnabled();
-        btn->setStyleSheet(is_activated ? btn_active_str_ : btn_inactive_str_);
-    });
-
-    DatcStatus datc_status = datc_interface_->getDatcStatus();
+void MainWindow::updateDatcSnapshot(const DatcSnapshot &snapshot) {
+    const DatcSnapshot &prev = snapshot_prev_;
+    const bool force = !snapshot_applied_;
 
     // Display
-    ui_->lineEdit_monitor_finger_position->setText(QString::number((double) datc_status.finger_pos / 10 , 'f', 1) + " %");
-    ui_->lineEdit_monitor_current        ->setText(QString::number(datc_status.motor_cur) + " mA");
+    if (force || snapshot.status.finger_pos != prev.status.finger_pos) {
+        ui_->lineEdit_monitor_finger_position->setText(QString::number((double) snapshot.status.finger_pos / 10 , 'f', 1) + " %");
+    }
 
-    // Comm. status check
-    const bool is_modbus_connected = datc_interface_->getConnectionState();
+    if (force || snapshot.status.motor_cur != prev.status.motor_cur) {
+        ui_->lineEdit_monitor_current->setText(QString::number(snapshot.status.motor_cur) + " mA");
+    }
 
-    modbus_widget_->ui_.pushButton_modbus_start->setEnabled(!is_modbus_connected);
-    modbus_widget_->ui_.pushButton_modbus_stop ->setEnabled(is_modbus_connected);
-    modbus_widget_->ui_.pushButton_modbus_set_slave_addr->setEnabled(is_modbus_connected);
-    modbus_widget_->ui_.pushButton_modbus_slave_change->setEnabled(is_modbus_connected);
+    // Comm. status check
+    const bool is_modbus_connected = snapshot.connected;
 
-    setButtonStyle(modbus_widget_->ui_.pushButton_modbus_start);
-    setButtonStyle(modbus_widget_->ui_.pushButton_modbus_stop);
-    setButtonStyle(modbus_widget_->ui_.pushButton_modbus_set_slave_addr);
-    setButtonStyle(modbus_widget_->ui_.pushButton_modbus_slave_change);
+    if (force || is_modbus_connected != prev.connected) {
+        modbus_widget_->ui_.pushButton_modbus_start->setEnabled(!is_modbus_connected);
+        modbus_widget_->ui_.pushButton_modbus_stop ->setEnabled(is_modbus_connected);
+        modbus_widget_->ui_.pushButton_modbus_set_slave_addr->setEnabled(is_modbus_connected);
+        modbus_widget_->ui_.pushButton_modbus_slave_change->setEnabled(is_modbus_connected);
+    }
 
     if (is_modbus_connected) {
-        if (datc_interface_->getModbusRecvErr()) {
-            ui_->lineEdit_monitor_mode->setText("Failed to read input register.");
-        } else {
-            ui_->lineEdit_monitor_mode->setText(" " + QString::fromStdString(datc_status.status_str));
+        if (force || !prev.connected || snapshot.active != prev.active || snapshot.recv_err != prev.recv_err ||
+            snapshot.status.states != prev.status.states) {
+            if (!snapshot.active) {
+                ui_->lineEdit_monitor_mode->setText(" Inactive (lifecycle)");
+            } else if (snapshot.recv_err) {
+                ui_->lineEdit_monitor_mode->setText("Failed to read input register.");
+            } else {
+                ui_->lineEdit_monitor_mode->setText(" " + QString::fromStdString(snapshot.status.status_str));
+            }
         }
 
-        QString qstr_slave_addr = (datc_interface_->getSlaveAddr() == 0) ?
-                                  "N/A" : QString::number(datc_interface_->getSlaveAddr());
-
-        ui_->lineEdit_current_slave_addr->setText(qstr_slave_addr);
-    } else {
+        if (force || !prev.connected || snapshot.slave_addr != prev.slave_addr) {
+            QString qstr_slave_addr = (snapshot.slave_addr == 0) ? "N/A" : QString::number(snapshot.slave_addr);
+            ui_->lineEdit_current_slave_addr->setText(qstr_slave_addr);
+        }
+    } else if (force || prev.connected) {
         ui_->lineEdit_current_slave_addr->setText("N/A");
     }
 
-#ifndef RCLCPP__RCLCPP_HPP_
     // Socket comm. status check
-    const bool is_socket_connected = datc_interface_->isSocketConnected();
+    if (tcp_widget_ != NULL && (force || snapshot.tcp_running != prev.tcp_running)) {
+        tcp_widget_->ui_.pushButton_tcp_start->setEnabled(!snapshot.tcp_running);
+        tcp_widget_->ui_.pushButton_tcp_stop ->setEnabled(snapshot.tcp_running);
+    }
 
-    tcp_widget_->ui_.pushButton_tcp_start->setEnabled(!is_socket_connected);
-    tcp_widget_->ui_.pushButton_tcp_stop ->setEnabled(is_socket_connected);
+    snapshot_prev_    = snapshot;
+    snapshot_applied_ = true;
+}
 
-    setButtonStyle(tcp_widget_->ui_.pushButton_tcp_start);
-    setButtonStyle(tcp_widget_->ui_.pushButton_tcp_stop);
+void MainWindow::syncSliderSpinbox(QSlider *slider, QDoubleSpinBox *spinbox) {
+    QObject::connect(slider, &QSlider::valueChanged, spinbox, [spinbox] (int value) {
+        // Keep the fractional part the user typed if the slider only followed the spin box
+        if ((int) spinbox->value() != value) {
+            spinbox->setValue((double) value);
+        }
+    });
 
-    datc_interface_->setTcpSendStatus(tcp_widget_->ui_.checkBox_tcp_send_status->isChecked());
-#endif
+    QObject::connect(spinbox, QOverload<double>::of(&QDoubleSpinBox::valueChanged), slider, [slider] (double value) {
+        if (slider->value() != (int) value) {
+            QSignalBlocker blocker(slider);
+            slider->setValue((int) value);
+        }
+    });
+}
 
-    // Slider control
-    static std::function syncSliderSpinboxFn(
-            [] (int &slider_data_prev, double &spinbox_data_prev, QSlider *slider, QDoubleSpinBox *spinbox) {
-        int slider_data     = slider->value();
-        double spinbox_data = spinbox->value();
+// While the box is checked, moving the slider streams the position and the release sends the exact
+// value of the spin box. The spin box only moves the slider with its signals blocked, so valueChanged
+// here is always the user's own move (drag, keys or a click on the groove).
+void MainWindow::setupJog(QSlider *slider, QDoubleSpinBox *spinbox, QCheckBox *checkbox, QPushButton *btn_set) {
+    checkbox->setStyleSheet("QCheckBox::indicator {width:20px; height: 20px;}");
 
-        if (slider_data != slider_data_prev) {
-            spinbox->setValue((double) slider_data);
-        } else if (fabs(spinbox_data - spinbox_data_prev) >= 0.09) {
-            slider->setValue((int) spinbox_data);
+    QObject::connect(slider, &QSlider::sliderPressed, this, [this, checkbox] () {
+        if (checkbox->isChecked()) {
+            jog_.resetSent();
         }
+    });
 
-        slider_data_prev  = slider->value();
-        spinbox_data_prev = spinbox->value();
+    QObject::connect(slider, &QSlider::valueChanged, this, [this, checkbox, btn_set] (int value) {
+        if (checkbox->isChecked()) {
+            jogFingerPos(value * 10, btn_set);
+        }
     });
 
-    // Finger position control side
-    static int slider_finger_pos_prev  = datc_ctrl_widget_->ui_.horizontalSlider_finger_pos->value();
-    static int slider_torque_prev      = datc_ctrl_widget_->ui_.verticalSlider_torque->value();
-    static int slider_speed_prev       = datc_ctrl_widget_->ui_.verticalSlider_speed ->value();
-    static int slider_finger_pos_prev2 = impedance_ctrl_widget_->ui_.horizontalSlider_finger_pos->value();
-
-    static double finger_pos_prev  = datc_ctrl_widget_->ui_.doubleSpinBox_finger_pos->value();
-    static double torque_prev      = datc_ctrl_widget_->ui_.doubleSpinBox_torque->value();
-    static double speed_prev       = datc_ctrl_widget_->ui_.doubleSpinBox_speed->value();
-    static double finger_pos_prev2 = impedance_ctrl_widget_->ui_.doubleSpinBox_finger_pos->value();
-
-    syncSliderSpinboxFn(slider_finger_pos_prev, finger_pos_prev,
-                        datc_ctrl_widget_->ui_.horizontalSlider_finger_pos,
-                        datc_ctrl_widget_->ui_.doubleSpinBox_finger_pos);
-    syncSliderSpinboxFn(slider_torque_prev, torque_prev,
-                        datc_ctrl_widget_->ui_.verticalSlider_torque,
-                        datc_ctrl_widget_->ui_.doubleSpinBox_torque);
-    syncSliderSpinboxFn(slider_speed_prev, speed_prev,
-                        datc_ctrl_widget_->ui_.verticalSlider_speed,
-                        datc_ctrl_widget_->ui_.doubleSpinBox_speed);
-    syncSliderSpinboxFn(slider_finger_pos_prev2, finger_pos_prev2,
-                        impedance_ctrl_widget_->ui_.horizontalSlider_finger_pos,
-                        impedance_ctrl_widget_->ui_.doubleSpinBox_finger_pos);
-
-    // Advanced control side
-    const int vel_min_percent = (int) ((double) kVelMin / (double) kVelMax * 100);
+    QObject::connect(slider, &QSlider::sliderReleased, this, [this, spinbox, checkbox, btn_set] () {
+        if (checkbox->isChecked()) {
+            jogFingerPos(spinbox->value() * 10, btn_set);
+        }
+    });
+}
+
+// Coalesced: at most one send is queued on command_runner_, and it takes the latest target when it runs
+void MainWindow::jogFingerPos(uint16_t finger_pos, QPushButton *btn_set) {
+    if (!jog_.setTarget(finger_pos)) {
+        return;
+    }
+
+    // One command per poll period, so that the reads keep their share of the bus
+    jog_.setPeriod(1.0 / datc_interface_->get_parameter("poll_rate").as_double());
+
+    const quint64 id = command_runner_->submit("set_finger_pos", [this] () {
+        return jog_.send([this] (uint16_t target) {
+            return datc_interface_->acceptCommand("set_finger_pos") && datc_interface_->setFingerPos(target);
+        });
+    });
+
+    // A failure shows on the Set button, which stays usable meanwhile
+    pending_commands_[id] = {NULL, [this, btn_set] (bool success) {
+        if (!pending_buttons_.contains(btn_set)) {
+            setCommandState(btn_set, success ? "" : "failed");
+        }
+    }};
+}
+
+void MainWindow::setMenuButtonActive(QPushButton *btn, bool active) {
+    const QVariant value(active);
+
+    if (btn->property("active") != value) {
+        btn->setProperty("active", value);
+        btn->style()->unpolish(btn);
+        btn->style()->polish(btn);
+    }
+}
+
+// Commands run on command_runner_; widget values are read here, on the GUI thread, before submitting.
+// The clicked button shows the pending/failed state through its cmd_state property.
+void MainWindow::runCommand(const QString &name, function<bool()> job, function<void(bool)> on_done, bool urgent) {
+    // sender() is still the clicked button here, since this is only called from the click slots
+    QPushButton *btn = qobject_cast<QPushButton *>(sender());
+
+    if (btn != NULL) {
+        if (pending_buttons_.contains(btn)) {
+            return;
+        }
+
+        pending_buttons_.insert(btn);
+        setCommandState(btn, "pending");
+    }
+
+    if (!kUngatedCommands.contains(name)) {
+        job = [this, name, job] () {
+            return datc_interface_->acceptCommand(name.toStdString().c_str()) && job();
+        };
+    }
+
+    const quint64 id = command_runner_->submit(name, job, urgent);
+    pending_commands_[id] = {btn, on_done};
+}
+
+void MainWindow::onCommandFinished(quint64 id, bool success, qint64 elapsed_ms) {
+    auto it = pending_commands_.find(id);
+
+    if (it == pending_commands_.end()) {
+        return;
+    }
+
+    PendingCommand cmd = it->second;
+    pending_commands_.erase(it);
+
+    if (cmd.button != NULL) {
+        pending_buttons_.remove(cmd.button);
+        setCommandState(cmd.button, success ? "" : "failed");
+        cmd.button->setToolTip((success ? "OK (" : "Failed (") + QString::number(elapsed_ms) + " ms)");
+    }
 
-    if (advanced_ctrl_widget_->ui_.horizontalSlider_motor_speed->value() < vel_min_percent) {
-        advanced_ctrl_widget_->ui_.horizontalSlider_motor_speed->setValue(vel_min_percent);
+    if (cmd.on_done) {
+        cmd.on_done(success);
     }
+}
 
-    static int slider_vel_prev = advanced_ctrl_widget_->ui_.horizontalSlider_motor_speed->value();
-    static int slider_cur_prev = advanced_ctrl_widget_->ui_.horizontalSlider_motor_current->value();
+void MainWindow::setCommandState(QPushButton *btn, const QString &state) {
+    // Buttons without a style sheet of their own get the state rules on first use. A widget's own
+    // sheet takes precedence over the #id rules of the page sheet.
+    if (btn->styleSheet().isEmpty()) {
+        btn->setStyleSheet(cmd_state_qss_);
+    }
 
-    static double vel_prev = advanced_ctrl_widget_->ui_.doubleSpinBox_motor_speed->value();
-    static double cur_prev = advanced_ctrl_widget_->ui_.doubleSpinBox_motor_current->value();
+    const QVariant value(state);
 
-    syncSliderSpinboxFn(slider_vel_prev, vel_prev,
-                        advanced_ctrl_widget_->ui_.horizontalSlider_motor_speed,
-                        advanced_ctrl_widget_->ui_.doubleSpinBox_motor_speed);
-    syncSliderSpinboxFn(slider_cur_prev, cur_prev,
-                        advanced_ctrl_widget_->ui_.horizontalSlider_motor_current,
-                        advanced_ctrl_widget_->ui_.doubleSpinBox_motor_current);
+    if (btn->property("cmd_state") != value) {
+        btn->setProperty("cmd_state", value);
+        btn->style()->unpolish(btn);
+        btn->style()->polish(btn);
+    }
 }
 
 // Enable Disable
 void MainWindow::datcEnable() {
-    datc_interface_->motorEnable();
+    runCommand("motor_enable", [this] () {return datc_interface_->motorEnable();});
 }
 
 void MainWindow::datcDisable() {
-    datc_interface_->motorDisable();
+    runCommand("motor_disable", [this] () {return datc_interface_->motorDisable();});
 }
 
 // Datc control
 void MainWindow::datcFingerPosCtrl() {
-    datc_interface_->setFingerPos(datc_ctrl_widget_->ui_.doubleSpinBox_finger_pos->value() * 10);
+    const uint16_t finger_pos = datc_ctrl_widget_->ui_.doubleSpinBox_finger_pos->value() * 10;
+    runCommand("set_finger_pos", [this, finger_pos] () {return datc_interface_->setFingerPos(finger_pos);});
 }
 
 void MainWindow::datcFingerPosCtrl2() {
-    datc_interface_->setFingerPos(impedance_ctrl_widget_->ui_.doubleSpinBox_finger_pos->value() * 10);
+    const uint16_t finger_pos = impedance_ctrl_widget_->ui_.doubleSpinBox_finger_pos->value() * 10;
+    runCommand("set_finger_pos", [this, finger_pos] () {return datc_interface_->setFingerPos(finger_pos);});
 }
 
 void MainWindow::datcMotorVelCtrl() {
     int16_t vel = advanced_ctrl_widget_->ui_.doubleSpinBox_motor_speed->value() * kVelMax / 100;
     vel *= (advanced_ctrl_widget_->ui_.checkBox_motor_speed_reverse->isChecked()) ? -1 : 1;
-    datc_interface_->motorVelCtrl(vel);
+    runCommand("motor_vel_ctrl", [this, vel] () {return datc_interface_->motorVelCtrl(vel);});
 }
 
 void MainWindow::datcMotorCurCtrl() {
     int16_t cur = advanced_ctrl_widget_->ui_.doubleSpinBox_motor_current->value() * kCurMax / 100;
     cur *= (advanced_ctrl_widget_->ui_.checkBox_motor_current_reverse->isChecked()) ? -1 : 1;
-    datc_interface_->motorCurCtrl(cur);
+    runCommand("motor_cur_ctrl", [this, cur] () {return datc_interface_->motorCurCtrl(cur);});
 }
 
 void MainWindow::datcInit() {
-    datc_interface_->grpInitialize();
+    runCommand("gripper_initialize", [this] () {return datc_interface_->grpInitialize();});
 }
 
 void MainWindow::datcOpen() {
-    datc_interface_->grpOpen();
+    runCommand("grp_open", [this] () {return datc_interface_->grpOpen();});
 }
 
 void MainWindow::datcClose() {
-    datc_interface_->grpClose();
+    runCommand("grp_close", [this] () {return datc_interface_->grpClose();});
 }
 
 void MainWindow::datcStop() {
-    datc_interface_->motorStop();
+    // Goes ahead of a queued jog send, which must not move the gripper again afterwards
+    jog_.cancel();
+    runCommand("motor_stop", [this] () {return datc_interface_->motorStop();}, nullptr, true);
 }
 
 void MainWindow::datcVacuumGrpOn() {
-    datc_interface_->vacuumGrpOn();
+    runCommand("vacuum_grp_on", [this] () {return datc_interface_->vacuumGrpOn();});
 }
 
 void MainWindow::datcVacuumGrpOff() {
-    datc_interface_->vacuumGrpOff();
+    runCommand("vacuum_grp_off", [this] () {return datc_interface_->vacuumGrpOff();});
 }
 
 void MainWindow::datcSetTorque() {
-    datc_interface_->setMotorTorque((uint16_t) datc_ctrl_widget_->ui_.doubleSpinBox_torque->value());
+    const uint16_t torque = (uint16_t) datc_ctrl_widget_->ui_.doubleSpinBox_torque->value();
+    runCommand("set_motor_torque", [this, torque] () {return datc_interface_->setMotorTorque(torque);});
 }
 
 void MainWindow::datcSetSpeed() {
-    datc_interface_->setMotorSpeed((uint16_t) datc_ctrl_widget_->ui_.doubleSpinBox_speed->value());
+    const uint16_t speed = (uint16_t) datc_ctrl_widget_->ui_.doubleSpinBox_speed->value();
+    runCommand("set_motor_speed", [this, speed] () {return datc_interface_->setMotorSpeed(speed);});
 }
 
 // Impedance related functions
+// Impedance on / off, then initialize once the mode has settled. Run as a sequence, so the delay is
+// timed on the poll thread and the bus stays free in between.
 void MainWindow::datcImpedanceOn() {
-    datc_interface_->impedanceOn();
-    usleep(100000);
-    datc_interface_->grpInitialize();
+    runCommand("impedance_on", [this] () {
+        return runImpedanceSequence(DATC_COMMAND::IMPEDANCE_ON);
+    });
 }
 
 void MainWindow::datcImpedanceOff() {
-    datc_interface_->impedanceOff();
-    usleep(100000);
-    datc_interface_->grpInitialize();
+    runCommand("impedance_off", [this] () {
+        return runImpedanceSequence(DATC_COMMAND::IMPEDANCE_OFF);
+    });
+}
+
+bool MainWindow::runImpedanceSequence(DATC_COMMAND cmd) {
+    string error;
+
+    const bool successed = datc_interface_->runSequence({
+        SequenceStep::makeCommand((uint16_t) cmd),
+        SequenceStep::makeDelay(kImpedanceSettleMs),
+        SequenceStep::makeCommand((uint16_t) DATC_COMMAND::GRIPPER_INITIALIZE),
+    }, error);
+
+    if (!successed) {
+        COUT("Impedance sequence: " << error);
+    }
+
+    return successed;
 }
 
 void MainWindow::datcSetImpedanceParams() {
     int16_t slave_num       = impedance_ctrl_widget_->ui_.spinBox_impedance_slave_num->value();
     int16_t stiffness_level = impedance_ctrl_widget_->ui_.spinBox_impedance_stiffness_level->value();
 
-    datc_interface_->setImpedanceParams(slave_num, stiffness_level);
+    runCommand("set_impedance_params", [this, slave_num, stiffness_level] () {
+        return datc_interface_->setImpedanceParams(slave_num, stiffness_level);
+    });
 }
 
 // Modbus RTU related
 void MainWindow::initModbus() {
+    const string port = modbus_widget_->ui_.comboBox_serial_port->currentText().toStdString();
+    const uint16_t slave_addr = modbus_widget_->ui_.spinBox_slave_addr->value();
+    const int baudrate = modbus_widget_->ui_.comboBox_baudrate->currentText().toInt();
+
     COUT("--------------------------------------------");
-    COUT("[INFO] Port: " + modbus_widget_->ui_.comboBox_serial_port->currentText().toStdString());
+    COUT("[INFO] Port: " + port);
     COUT("[INFO] Slave address #" + modbus_widget_->ui_.spinBox_slave_addr->text().toStdString());
     COUT("--------------------------------------------");
 
-    const char* port = modbus_widget_->ui_.comboBox_serial_port->currentText().toStdString().c_str();
-    uint16_t slave_addr = modbus_widget_->ui_.spinBox_slave_addr->value();
-
-    // 왜인지 이렇게 우회해야만 release mode에서 정상적으로 동작함
-    auto baudrate_qstr = modbus_widget_->ui_.comboBox_baudrate->currentText();
-    auto baudrate = baudrate_qstr.toInt();
-
-    if (datc_interface_->init(port, slave_addr, baudrate)) {
-        // Successed
-    } else {
-        ui_->lineEdit_monitor_mode->setText("Invalid port or permission.");
-        COUT("[ERROR] Port name or slave address invlaid !");
-    }
+    runCommand("modbus_init", [this, port, slave_addr, baudrate] () {
+        return datc_interface_->bringUp(port, slave_addr, baudrate);
+    }, [this] (bool success) {
+        if (!success) {
+            ui_->lineEdit_monitor_mode->setText("Invalid port or permission.");
+            COUT("[ERROR] Port name or slave address invlaid !");
+        }
+    });
 }
 
 void MainWindow::releaseModbus() {
-    datc_interface_->modbusRelease();
-    ui_->lineEdit_monitor_mode->setText("");
+    runCommand("modbus_release", [this] () {return datc_interface_->bringDown();}, [this] (bool) {
+        ui_->lineEdit_monitor_mode->setText("");
+    });
 }
 
 void MainWindow::changeSlaveAddress() {
     uint16_t slave_addr = modbus_widget_->ui_.spinBox_slave_addr->value();
 
-    if (datc_interface_->modbusSlaveChange(slave_addr)) {
-        // Successed
-    } else {
-        COUT("[ERROR] Slave change failed !");
-    }
+    runCommand("modbus_slave_change", [this, slave_addr] () {
+        return datc_interface_->modbusSlaveChange(slave_addr);
+    });
 }
 
 void MainWindow::setSlaveAddr() {
     uint16_t slave_addr = modbus_widget_->ui_.spinBox_slave_addr_4set->value();
 
-    if (datc_interface_->setModbusAddr(slave_addr)) {
-        // Successed
-    } else {
-        COUT("[ERROR] Slave change failed !");
-    }
+    runCommand("set_modbus_addr", [this, slave_addr] () {
+        return datc_interface_->setModbusAddr(slave_addr);
+    });
 }
 
-#ifndef RCLCPP__RCLCPP_HPP_
 // TCP comm. related functions
 void MainWindow::startTcpComm() {
     string addr          = tcp_widget_->ui_.lineEdit_tcp_addr->text().toStdString();
     uint16_t socket_port = tcp_widget_->ui_.lineEdit_tcp_port->text().toUInt();
 
-    datc_interface_->initTcp(addr, socket_port);
+    const bool success = datc_interface_->initTcp(addr, socket_port);
+
+    setCommandState(tcp_widget_->ui_.pushButton_tcp_start, success ? "" : "failed");
 }
 
 void MainWindow::stopTcpComm() {
     datc_interface_->releaseTcp();
 }
-#endif
 
 void MainWindow::on_pushButton_select_modbus_clicked() {
-    ui_->stackedWidget->setCurrentIndex((int) WidgetSeq::MODBUS_WIDGET);
-
-    ui_->pushButton_select_modbus    ->setStyleSheet(menu_btn_active_str_);
-    ui_->pushButton_select_datc_ctrl ->setStyleSheet(menu_btn_inactive_str_);
-    ui_->pushButton_select_adv       ->setStyleSheet(menu_btn_inactive_str_);
-    ui_->pushButton_select_tcp       ->setStyleSheet(menu_btn_inactive_str_);
-    ui_->pushButton_select_imped_ctrl->setStyleSheet(menu_btn_inactive_str_);
+    selectPage(WidgetSeq::MODBUS_WIDGET);
 }
 
 void MainWindow::on_pushButton_select_datc_ctrl_clicked() {
-    ui_->stackedWidget->setCurrentIndex((int) WidgetSeq::DATC_CTRL_WIDGET);
-
-    ui_->pushButton_select_modbus    ->setStyleSheet(menu_btn_inactive_str_);
-    ui_->pushButton_select_datc_ctrl ->setStyleSheet(menu_btn_active_str_);
-    ui_->pushButton_select_adv       ->setStyleSheet(menu_btn_inactive_str_);
-    ui_->pushButton_select_tcp       ->setStyleSheet(menu_btn_inactive_str_);
-    ui_->pushButton_select_imped_ctrl->setStyleSheet(menu_btn_inactive_str_);
+    selectPage(WidgetSeq::DATC_CTRL_WIDGET);
 }
 
 void MainWindow::on_pushButton_select_adv_clicked() {
-    ui_->stackedWidget->setCurrentIndex((int) WidgetSeq::ADVANCED_CTRL_WIDGET);
-
-    ui_->pushButton_select_modbus    ->setStyleSheet(menu_btn_inactive_str_);
-    ui_->pushButton_select_datc_ctrl ->setStyleSheet(menu_btn_inactive_str_);
-    ui_->pushButton_select_adv       ->setStyleSheet(menu_btn_active_str_);
-    ui_->pushButton_select_tcp       ->setStyleSheet(menu_btn_inactive_str_);
-    ui_->pushButton_select_imped_ctrl->setStyleSheet(menu_btn_inactive_str_);
+    selectPage(WidgetSeq::ADVANCED_CTRL_WIDGET);
 }
 
 void MainWindow::on_pushButton_select_tcp_clicked() {
-    ui_->stackedWidget->setCurrentIndex((int) WidgetSeq::TCP_WIDGET);
-
-    ui_->pushButton_select_modbus    ->setStyleSheet(menu_btn_inactive_str_);
-    ui_->pushButton_select_datc_ctrl ->setStyleSheet(menu_btn_inactive_str_);
-    ui_->pushButton_select_adv       ->setStyleSheet(menu_btn_inactive_str_);
-    ui_->pushButton_select_tcp       ->setStyleSheet(menu_btn_active_str_);
-    ui_->pushButton_select_imped_ctrl->setStyleSheet(menu_btn_inactive_str_);
+    selectPage(WidgetSeq::TCP_WIDGET);
 }
 
 void MainWindow::on_pushButton_select_imped_ctrl_clicked() {
-    ui_->stackedWidget->setCurrentIndex((int) WidgetSeq::IMPEDANCE_CTRL_WIDGET);
+    selectPage(WidgetSeq::IMPEDANCE_CTRL_WIDGET);
+}
 
-    ui_->pushButton_select_modbus    ->setStyleSheet(menu_btn_inactive_str_);
-    ui_->pushButton_select_datc_ctrl ->setStyleSheet(menu_btn_inactive_str_);
-    ui_->pushButton_select_adv       ->setStyleSheet(menu_btn_inactive_str_);
-    ui_->pushButton_select_tcp       ->setStyleSheet(menu_btn_inactive_str_);
-    ui_->pushButton_select_imped_ctrl->setStyleSheet(menu_btn_active_str_);
+void MainWindow::on_pushButton_select_plot_clicked() {
+    selectPage(WidgetSeq::TELEMETRY_WIDGET);
 }
 
+// Port enumeration runs on a worker thread, the result is applied by updateSerialPortList()
 void MainWindow::on_pushButton_modbus_refresh_clicked() {
-    modbus_widget_->ui_.comboBox_serial_port->clear();
+    if (port_scan_thread_.joinable()) {
+        return;
+    }
+
+    modbus_widget_->ui_.pushButton_modbus_refresh->setEnabled(false);
+
+    port_scan_thread_ = thread([this] () {
+        port_list_pending_ = getSerialPortLists();
+        QMetaObject::invokeMethod(this, "updateSerialPortList", Qt::QueuedConnection);
+    });
+}
+
+void MainWindow::updateSerialPortList() {
+    port_scan_thread_.join();
+
+    QStringList ports;
+
+    for (const auto &port : port_list_pending_) {
+        ports << QString::fromStdString(port);
+    }
 
-    std::vector<std::string> ser_port_str_vec = getSerialPortLists();
+    setSerialPortList(ports);
 
-    for (auto i : ser_port_str_vec) {
-        modbus_widget_->ui_.comboBox_serial_port->addItem(QString::fromStdString(i));
+    modbus_widget_->ui_.pushButton_modbus_refresh->setEnabled(true);
+
+    if (!port_list_traced_) {
+        port_list_traced_ = true;
+        traceStartup("Serial ports listed");
     }
+}
+
+// Keeps the selected port if it is still there, otherwise selects the last one as before
+void MainWindow::setSerialPortList(const QStringList &ports) {
+    QComboBox *combo = modbus_widget_->ui_.comboBox_serial_port;
+    const QString selected = combo->currentText();
+
+    QSignalBlocker blocker(combo);
 
-    if (!ser_port_str_vec.empty()) {
-        modbus_widget_->ui_.comboBox_serial_port->setCurrentIndex(ser_port_str_vec.size() - 1);
+    combo->clear();
+    combo->addItems(ports);
+
+    const int index = ports.indexOf(selected);
+
+    if (index >= 0) {
+        combo->setCurrentIndex(index);
+    } else if (!ports.isEmpty()) {
+        combo->setCurrentIndex(ports.size() - 1);
     }
 }
 
@@ -534,31 +850,8 @@ std::vector<std::string> MainWindow::getSerialPortLists() {
 
     return comPorts;
 #else
-    std::vector<std::string> serialPorts;
-
-    // Open the /dev directory
-    DIR *dir = opendir("/dev");
-
-    if (!dir) {
-        std::cerr << "Error opening /dev directory." << std::endl;
-        return serialPorts;
-    }
-
-    // Read the contents of the directory
-    struct dirent *entry;
-
-    while ((entry = readdir(dir)) != nullptr) {
-        // Check if the entry is a character device file and has "tty" in its name
-        if (entry->d_type == DT_CHR && std::strstr(entry->d_name, "ttyUSB") != nullptr) {
-            std::string portName = "/dev/" + std::string(entry->d_name);
-            serialPorts.push_back(portName);
-        }
-    }
-
-    // Close the directory
-    closedir(dir);
-
-    return serialPorts;
+    // ttyUSB*, ttyACM* and the /dev/serial/by-id aliases
+    return SerialPortWatcher::scanPorts();
 #endif
 }
 
@@ -0,0 +1,185 @@
+/**
+ * @file rt_profile.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "rt_profile.hpp"
+
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+const size_t kPrefaultStackBytes = 256 * 1024;
+const size_t kPrefaultHeapBytes  = 8 * 1024 * 1024;
+
+// "2-3,5" -> {2, 3, 5}
+static vector<int> parseCpuList(const string &str) {
+    vector<int> cpus;
+    stringstream ss(str);
+    string item;
+
+    while (getline(ss, item, ',')) {
+        int first, last;
+
+        if (sscanf(item.c_str(), "%d-%d", &first, &last) == 2) {
+            for (int cpu = first; cpu <= last; cpu++) {
+                cpus.push_back(cpu);
+            }
+        } else if (sscanf(item.c_str(), "%d", &first) == 1) {
+            cpus.push_back(first);
+        }
+    }
+
+    return cpus;
+}
+
+static void prefaultStack() {
+    volatile unsigned char stack[kPrefaultStackBytes];
+
+    for (size_t i = 0; i < kPrefaultStackBytes; i += 4096) {
+        stack[i] = 0;
+    }
+
+    (void) stack[0];
+}
+
+static void prefaultHeap() {
+    // Keep freed memory in the process so that later allocations do not fault again
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+
+    unsigned char *heap = (unsigned char *) malloc(kPrefaultHeapBytes);
+
+    if (heap == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < kPrefaultHeapBytes; i += 4096) {
+        heap[i] = 0;
+    }
+
+    free(heap);
+}
+
+RtProfileResult applyRtProfile(const RtProfile &profile) {
+    RtProfileResult result;
+    stringstream applied;
+
+    // Memory first: a page fault in the loop costs more than anything else here
+    if (profile.lock_memory) {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0) {
+            prefaultStack();
+            prefaultHeap();
+            applied << "memory locked, ";
+        } else {
+            result.errors.push_back(string("mlockall: ") + strerror(errno) +
+                                    " (raise 'ulimit -l' / memlock in /etc/security/limits.conf)");
+        }
+    }
+
+    // CPU pinning
+    vector<int> cpus = profile.cpus;
+
+    if (profile.isolated_core) {
+        ifstream file("/sys/devices/system/cpu/isolated");
+        string line;
+        getline(file, line);
+
+        const vector<int> isolated = parseCpuList(line);
+
+        if (isolated.empty()) {
+            result.errors.push_back("isolated_core: no isolated CPU (boot with isolcpus=...)");
+        } else {
+            cpus = {isolated.front()};
+        }
+    }
+
+    if (!cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+
+        for (int cpu : cpus) {
+            CPU_SET(cpu, &set);
+        }
+
+        const int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+
+        if (err == 0) {
+            applied << "CPU";
+
+            for (int cpu : cpus) {
+                applied << " " << cpu;
+            }
+
+            applied << ", ";
+        } else {
+            result.errors.push_back(string("CPU affinity: ") + strerror(err));
+        }
+    }
+
+    // Scheduling
+    int policy = SCHED_OTHER;
+
+    if (profile.policy == "fifo") {
+        policy = SCHED_FIFO;
+    } else if (profile.policy == "rr") {
+        policy = SCHED_RR;
+    } else if (profile.policy != "other") {
+        result.errors.push_back("Unknown scheduling policy '" + profile.policy + "' (other, fifo or rr)");
+    }
+
+    if (policy != SCHED_OTHER) {
+        sched_param param;
+        param.sched_priority = std::clamp(profile.priority, sched_get_priority_min(policy), sched_get_priority_max(policy));
+
+        const int err = pthread_setschedparam(pthread_self(), policy, &param);
+
+        if (err == 0) {
+            applied << "SCHED_" << (policy == SCHED_FIFO ? "FIFO" : "RR") << " " << param.sched_priority;
+        } else {
+            result.errors.push_back(string("SCHED_") + (policy == SCHED_FIFO ? "FIFO" : "RR") + ": " + strerror(err) +
+                                    " (needs CAP_SYS_NICE or rtprio in /etc/security/limits.conf)");
+            applied << "SCHED_OTHER";
+        }
+    } else {
+        applied << "SCHED_OTHER";
+    }
+
+    result.applied = applied.str();
+
+    return result;
+}
+
+string LatencyRecorder::report() {
+    if (count_ == 0) {
+        return "no samples";
+    }
+
+    sort(samples_.begin(), samples_.begin() + count_);
+
+    auto percentile = [this] (double p) {
+        return samples_[std::min(count_ - 1, (size_t) (p / 100.0 * count_))] / 1000;
+    };
+
+    stringstream ss;
+    ss << "p50 "   << percentile(50)   << " us, "
+       << "p90 "   << percentile(90)   << " us, "
+       << "p99 "   << percentile(99)   << " us, "
+       << "p99.9 " << percentile(99.9) << " us, "
+       << "max "   << samples_[count_ - 1] / 1000 << " us "
+       << "(" << count_ << " cycles)";
+
+    return ss.str();
+}
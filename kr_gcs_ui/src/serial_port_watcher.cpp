@@ -0,0 +1,297 @@
+/**
+ * @file serial_port_watcher.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "serial_port_watcher.hpp"
+#include "async_logger.hpp"
+
+#include <dirent.h>
+#include <limits.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+
+const char kDevDir[]     = "/dev";
+const char kSerialDir[]  = "/dev/serial";
+const char kSerialById[] = "/dev/serial/by-id";
+
+static bool isSerialPortName(const char *name) {
+    return strncmp(name, "ttyUSB", 6) == 0 || strncmp(name, "ttyACM", 6) == 0;
+}
+
+static void listDir(const char *dir_name, bool only_serial_names, set<string> &out) {
+    DIR *dir = opendir(dir_name);
+
+    if (!dir) {
+        return;
+    }
+
+    struct dirent *entry;
+
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+
+        if (!only_serial_names || isSerialPortName(entry->d_name)) {
+            out.insert(string(dir_name) + "/" + entry->d_name);
+        }
+    }
+
+    closedir(dir);
+}
+
+SerialPortWatcher::~SerialPortWatcher() {
+    stop();
+}
+
+bool SerialPortWatcher::start(Callback callback) {
+    if (thread_.joinable()) {
+        return true;
+    }
+
+    callback_ = callback;
+
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    wake_fd_    = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (inotify_fd_ < 0 || wake_fd_ < 0) {
+        DATC_LOG_ERROR("Serial port watcher: %s", strerror(errno));
+        stop();
+        return false;
+    }
+
+    wd_dev_ = inotify_add_watch(inotify_fd_, kDevDir, IN_CREATE | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM);
+
+    if (wd_dev_ < 0) {
+        DATC_LOG_ERROR("Serial port watcher: cannot watch %s: %s", kDevDir, strerror(errno));
+        stop();
+        return false;
+    }
+
+    // Watches first, then the scan, so nothing created in between is missed
+    watchById(false);
+
+    {
+        unique_lock<mutex> lg(mutex_);
+        ports_ = set<string>();
+
+        for (const auto &path : scanPorts()) {
+            ports_.insert(path);
+        }
+    }
+
+    thread_ = thread(&SerialPortWatcher::run, this);
+
+    return true;
+}
+
+void SerialPortWatcher::stop() {
+    if (thread_.joinable()) {
+        uint64_t one = 1;
+
+        if (write(wake_fd_, &one, sizeof(one)) < 0) {
+            DATC_LOG_ERROR("Serial port watcher: %s", strerror(errno));
+        }
+
+        thread_.join();
+    }
+
+    if (inotify_fd_ >= 0) {
+        close(inotify_fd_);
+        inotify_fd_ = -1;
+    }
+
+    if (wake_fd_ >= 0) {
+        close(wake_fd_);
+        wake_fd_ = -1;
+    }
+
+    wd_dev_ = wd_serial_ = wd_by_id_ = -1;
+}
+
+vector<string> SerialPortWatcher::getPorts() {
+    unique_lock<mutex> lg(mutex_);
+    return vector<string>(ports_.begin(), ports_.end());
+}
+
+vector<string> SerialPortWatcher::scanPorts() {
+    set<string> ports;
+
+    listDir(kDevDir, true, ports);
+    listDir(kSerialById, false, ports);
+
+    return vector<string>(ports.begin(), ports.end());
+}
+
+string SerialPortWatcher::getStablePath(const string &path) {
+    if (path.compare(0, strlen(kSerialById), kSerialById) == 0) {
+        return path;
+    }
+
+    char target[PATH_MAX], alias_target[PATH_MAX];
+
+    if (realpath(path.c_str(), target) == NULL) {
+        return "";
+    }
+
+    set<string> aliases;
+    listDir(kSerialById, false, aliases);
+
+    for (const auto &alias : aliases) {
+        if (realpath(alias.c_str(), alias_target) != NULL && strcmp(target, alias_target) == 0) {
+            return alias;
+        }
+    }
+
+    return "";
+}
+
+void SerialPortWatcher::run() {
+    alignas(struct inotify_event) char buf[4096];
+
+    pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {wake_fd_, POLLIN, 0}};
+
+    while (true) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            DATC_LOG_ERROR("Serial port watcher: %s", strerror(errno));
+            return;
+        }
+
+        if (fds[1].revents) {
+            return;
+        }
+
+        ssize_t len;
+
+        while ((len = read(inotify_fd_, buf, sizeof(buf))) > 0) {
+            for (char *ptr = buf; ptr < buf + len; ) {
+                const struct inotify_event *event = (const struct inotify_event *) ptr;
+                ptr += sizeof(struct inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW) {
+                    rescan();
+                    continue;
+                }
+
+                if (event->wd == wd_by_id_ && (event->mask & IN_IGNORED)) {
+                    // by-id was removed together with the last adapter
+                    wd_by_id_ = -1;
+                    rescan();
+                    continue;
+                }
+
+                if (event->wd == wd_serial_ && (event->mask & IN_IGNORED)) {
+                    wd_serial_ = -1;
+                    continue;
+                }
+
+                if (event->len == 0) {
+                    continue;
+                }
+
+                string path;
+
+                if (event->wd == wd_dev_ && isSerialPortName(event->name)) {
+                    path = string(kDevDir) + "/" + event->name;
+                } else if (event->wd == wd_by_id_) {
+                    path = string(kSerialById) + "/" + event->name;
+                } else {
+                    continue;
+                }
+
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    addPort(path);
+                } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                    removePort(path);
+                }
+            }
+        }
+
+        // /dev/serial or by-id may have just been created
+        watchById(true);
+    }
+}
+
+void SerialPortWatcher::addPort(const string &path) {
+    {
+        unique_lock<mutex> lg(mutex_);
+
+        if (!ports_.insert(path).second) {
+            return;
+        }
+    }
+
+    if (callback_) {
+        callback_(SERIAL_PORT_EVENT::ADDED, path);
+    }
+}
+
+void SerialPortWatcher::removePort(const string &path) {
+    {
+        unique_lock<mutex> lg(mutex_);
+
+        if (ports_.erase(path) == 0) {
+            return;
+        }
+    }
+
+    if (callback_) {
+        callback_(SERIAL_PORT_EVENT::REMOVED, path);
+    }
+}
+
+void SerialPortWatcher::watchById(bool add_existing) {
+    const uint32_t mask = IN_CREATE | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM;
+
+    if (wd_serial_ < 0) {
+        wd_serial_ = inotify_add_watch(inotify_fd_, kSerialDir, IN_CREATE);
+    }
+
+    if (wd_by_id_ < 0 && wd_serial_ >= 0) {
+        wd_by_id_ = inotify_add_watch(inotify_fd_, kSerialById, mask);
+
+        if (wd_by_id_ >= 0 && add_existing) {
+            // Links created before the watch was in place
+            set<string> aliases;
+            listDir(kSerialById, false, aliases);
+
+            for (const auto &alias : aliases) {
+                addPort(alias);
+            }
+        }
+    }
+}
+
+void SerialPortWatcher::rescan() {
+    const vector<string> current = scanPorts();
+    const vector<string> previous = getPorts();
+
+    const set<string> current_set(current.begin(), current.end());
+    const set<string> previous_set(previous.begin(), previous.end());
+
+    for (const auto &path : previous) {
+        if (current_set.count(path) == 0) {
+            removePort(path);
+        }
+    }
+
+    for (const auto &path : current) {
+        if (previous_set.count(path) == 0) {
+            addPort(path);
+        }
+    }
+}
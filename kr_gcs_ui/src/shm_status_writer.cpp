@@ -0,0 +1,110 @@
+/**
+ * @file shm_status_writer.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "shm_status_writer.hpp"
+
+#include <errno.h>
+#include <string.h>
+
+ShmStatusWriter::~ShmStatusWriter() {
+    close();
+}
+
+bool ShmStatusWriter::open(const string &name, string &error) {
+    close();
+
+    if (name.size() < 2 || name[0] != '/' || name.find('/', 1) != string::npos) {
+        error = "shared memory name must be '/' followed by a name without '/'";
+        return false;
+    }
+
+    // A fresh segment every time: a reader still mapping the old one sees its samples age
+    shm_unlink(name.c_str());
+
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+
+    if (fd < 0) {
+        error = string("shm_open: ") + strerror(errno);
+        return false;
+    }
+
+    if (ftruncate(fd, sizeof(datc_shm_segment_t)) != 0) {
+        error = string("ftruncate: ") + strerror(errno);
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    void *addr = mmap(NULL, sizeof(datc_shm_segment_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (addr == MAP_FAILED) {
+        error = string("mmap: ") + strerror(errno);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    segment_   = (datc_shm_segment_t *) addr;
+    name_      = name;
+    sequence_  = 0;
+
+    // Zero filled by ftruncate; the magic goes last so that a reader never accepts a half-made header
+    segment_->version    = DATC_SHM_VERSION;
+    segment_->writer_pid = (uint32_t) getpid();
+    __atomic_store_n(&segment_->magic, DATC_SHM_MAGIC, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+void ShmStatusWriter::close() {
+    if (segment_ == NULL) {
+        return;
+    }
+
+    munmap(segment_, sizeof(datc_shm_segment_t));
+    shm_unlink(name_.c_str());
+
+    segment_ = NULL;
+    name_.clear();
+}
+
+void ShmStatusWriter::write(const DatcStatus &status, uint8_t flags, int64_t stamp_ns) {
+    if (segment_ == NULL) {
+        return;
+    }
+
+    datc_shm_sample_t sample;
+    memset(&sample, 0, sizeof(sample));
+
+    sample.sequence   = ++sequence_;
+    sample.stamp_ns   = stamp_ns;
+    sample.states     = status.states;
+    sample.motor_pos  = status.motor_pos;
+    sample.motor_vel  = status.motor_vel;
+    sample.motor_cur  = status.motor_cur;
+    sample.finger_pos = status.finger_pos;
+    sample.voltage    = status.voltage;
+    sample.flags      = flags;
+
+    uint64_t words[DATC_SHM_SAMPLE_WORDS];
+    memcpy(words, &sample, sizeof(words));
+
+    // Seqlock: odd, payload, even. The release fence keeps the payload stores after the odd count.
+    const uint32_t seq = segment_->seq;
+
+    __atomic_store_n(&segment_->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    for (size_t i = 0; i < DATC_SHM_SAMPLE_WORDS; i++) {
+        __atomic_store_n(&segment_->data.words[i], words[i], __ATOMIC_RELAXED);
+    }
+
+    __atomic_store_n(&segment_->seq, seq + 2, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,136 @@
+/**
+ * @file state_estimator.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "state_estimator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+const double kVelocityResetHorizon = 0.5; // s; velocity std after a reset = accel_std * this
+
+double CvKalmanFilter::getVelocityVarReset() const {
+    const double vel_std = noise_.accel_std * kVelocityResetHorizon;
+    return vel_std * vel_std;
+}
+
+void CvKalmanFilter::resetVelocity() {
+    v_   = 0;
+    p01_ = 0;
+    p11_ = getVelocityVarReset();
+}
+
+double CvKalmanFilter::update(double pos, int64_t time_ns) {
+    const double r = noise_.pos_std * noise_.pos_std;
+
+    if (!initialized_) {
+        x_   = pos;
+        p00_ = r;
+        resetVelocity();
+
+        time_ns_     = time_ns;
+        initialized_ = true;
+
+        return 0;
+    }
+
+    const AxisEstimate prior = predict(time_ns);
+
+    const double innovation = pos - prior.pos;
+    const double s  = prior.cov[0] + r;
+    const double k0 = prior.cov[0] / s;
+    const double k1 = prior.cov[1] / s;
+
+    x_   = prior.pos + k0 * innovation;
+    v_   = prior.vel + k1 * innovation;
+    p00_ = (1 - k0) * prior.cov[0];
+    p01_ = (1 - k0) * prior.cov[1];
+    p11_ = prior.cov[3] - k1 * prior.cov[1];
+
+    time_ns_ = std::max(time_ns_, time_ns);
+
+    return innovation;
+}
+
+// White acceleration (accel_std) over dt
+AxisEstimate CvKalmanFilter::predict(int64_t time_ns) const {
+    const double dt = std::max<int64_t>(0, time_ns - time_ns_) * 1e-9;
+    const double q  = noise_.accel_std * noise_.accel_std;
+
+    AxisEstimate estimate;
+
+    estimate.pos    = x_ + v_ * dt;
+    estimate.vel    = v_;
+    estimate.cov[0] = p00_ + dt * (2 * p01_ + dt * p11_) + q * dt * dt * dt * dt / 4;
+    estimate.cov[1] = p01_ + dt * p11_ + q * dt * dt * dt / 2;
+    estimate.cov[2] = estimate.cov[1];
+    estimate.cov[3] = p11_ + q * dt * dt;
+
+    return estimate;
+}
+
+void StateEstimator::setNoise(const EstimatorNoise &finger, const EstimatorNoise &motor) {
+    finger_.setNoise(finger);
+    motor_.setNoise(motor);
+}
+
+void StateEstimator::reset() {
+    finger_.reset();
+    motor_.reset();
+    finger_error_.clear();
+    motor_error_.clear();
+}
+
+void StateEstimator::resetVelocity() {
+    finger_.resetVelocity();
+    motor_.resetVelocity();
+}
+
+void StateEstimator::update(const DatcStatus &status, int64_t time_ns) {
+    const bool had_prior = isReady();
+
+    const double finger_innovation = finger_.update(status.finger_pos, time_ns);
+    const double motor_innovation  = motor_.update(status.motor_pos, time_ns);
+
+    if (had_prior) {
+        finger_error_.add(finger_innovation);
+        motor_error_.add(motor_innovation);
+    }
+
+    sample_ns_ = time_ns;
+}
+
+void StateEstimator::predict(int64_t time_ns, AxisEstimate &finger, AxisEstimate &motor) const {
+    finger = finger_.predict(time_ns);
+    motor  = motor_.predict(time_ns);
+}
+
+void StateEstimator::ErrorWindow::add(double error) {
+    const double square = error * error;
+
+    if (count == kEstimatorErrorWindow) {
+        sum -= squares[next];
+    } else {
+        count++;
+    }
+
+    squares[next] = square;
+    sum += square;
+    next = (next + 1) % kEstimatorErrorWindow;
+}
+
+void StateEstimator::ErrorWindow::clear() {
+    sum   = 0;
+    next  = 0;
+    count = 0;
+}
+
+double StateEstimator::ErrorWindow::getRms() const {
+    return count > 0 ? std::sqrt(std::max(0.0, sum) / count) : 0.0;
+}
@@ -0,0 +1,573 @@
+/**
+ * @file tcp_bridge.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "tcp_bridge.hpp"
+#include "async_logger.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+#include <array>
+
+const size_t kTcpCommandSize = 8;
+const size_t kTcpPingSize    = 2;
+const size_t kTcpResultSize  = 5;
+const size_t kTcpStatusSize  = 17;
+const size_t kTcpPongSize    = 2;
+
+const size_t kMaxClients         = 32;
+const size_t kSendBufferSoft     = 16 * 1024; // Pending bytes from which a client skips status frames
+const size_t kSendBufferHard     = 64 * 1024; // Pending bytes from which its frames are no longer read
+const size_t kMaxPendingCommands = 16;        // Commands per client queued or running at once
+const int kMaxEvents             = 16;
+
+static uint8_t *putU16(uint8_t *ptr, uint16_t value) {
+    ptr[0] = value & 0xFF;
+    ptr[1] = value >> 8;
+    return ptr + 2;
+}
+
+static uint8_t *putU32(uint8_t *ptr, uint32_t value) {
+    return putU16(putU16(ptr, value & 0xFFFF), value >> 16);
+}
+
+static uint8_t *putHeader(uint8_t *ptr, uint8_t type, uint16_t length) {
+    ptr[0] = kTcpMagic;
+    ptr[1] = type;
+    return putU16(ptr + 2, length);
+}
+
+static uint16_t getU16(const uint8_t *ptr) {
+    return ptr[0] | (ptr[1] << 8);
+}
+
+TcpBridge::~TcpBridge() {
+    stop();
+}
+
+bool TcpBridge::start(const string &addr, uint16_t port, CommandHandler handler) {
+    if (thread_.joinable()) {
+        return true;
+    }
+
+    handler_ = handler;
+
+    sockaddr_in sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sin_family      = AF_INET;
+    sa.sin_port        = htons(port);
+    sa.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    if (!addr.empty() && inet_pton(AF_INET, addr.c_str(), &sa.sin_addr) != 1) {
+        DATC_LOG_ERROR("TCP bridge: invalid address %s", addr.c_str());
+        return false;
+    }
+
+    listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    epoll_fd_  = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_   = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (listen_fd_ < 0 || epoll_fd_ < 0 || wake_fd_ < 0) {
+        DATC_LOG_ERROR("TCP bridge: %s", strerror(errno));
+        stop();
+        return false;
+    }
+
+    const int one = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    if (bind(listen_fd_, (sockaddr *) &sa, sizeof(sa)) < 0 || listen(listen_fd_, SOMAXCONN) < 0) {
+        DATC_LOG_ERROR("TCP bridge: cannot listen on %s:%d: %s", addr.empty() ? "*" : addr.c_str(), (int) port,
+                       strerror(errno));
+        stop();
+        return false;
+    }
+
+    socklen_t sa_len = sizeof(sa);
+    getsockname(listen_fd_, (sockaddr *) &sa, &sa_len);
+    port_ = ntohs(sa.sin_port);
+
+    for (int fd : {listen_fd_, wake_fd_}) {
+        epoll_event ev {};
+        ev.events  = EPOLLIN;
+        ev.data.fd = fd;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+    }
+
+    running_        = true;
+    thread_         = thread(&TcpBridge::run, this);
+    command_thread_ = thread(&TcpBridge::runCommands, this);
+
+    return true;
+}
+
+void TcpBridge::stop() {
+    running_ = false;
+
+    if (thread_.joinable()) {
+        wake();
+        thread_.join();
+    }
+
+    // A command already running finishes first
+    if (command_thread_.joinable()) {
+        {
+            unique_lock<mutex> lg(command_mutex_);
+            commands_.clear();
+        }
+
+        command_cv_.notify_all();
+        command_thread_.join();
+    }
+
+    {
+        unique_lock<mutex> lg(mutex_);
+
+        for (const auto &client : clients_) {
+            close(client.first);
+        }
+
+        clients_.clear();
+    }
+
+    for (int *fd : {&listen_fd_, &epoll_fd_, &wake_fd_}) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+
+    port_ = 0;
+}
+
+size_t TcpBridge::getClientCount() {
+    unique_lock<mutex> lg(mutex_);
+    return clients_.size();
+}
+
+void TcpBridge::broadcastStatus(const DatcStatus &status, uint8_t flags) {
+    if (!running_) {
+        return;
+    }
+
+    array<uint8_t, kTcpHeaderSize + kTcpStatusSize> frame;
+    bool queued = false;
+
+    {
+        unique_lock<mutex> lg(mutex_);
+
+        uint8_t *ptr = putHeader(frame.data(), kTcpTypeStatus, kTcpStatusSize);
+        ptr = putU32(ptr, ++status_seq_);
+        ptr = putU16(ptr, status.states);
+        ptr = putU16(ptr, status.motor_pos);
+        ptr = putU16(ptr, status.motor_vel);
+        ptr = putU16(ptr, status.motor_cur);
+        ptr = putU16(ptr, status.finger_pos);
+        ptr = putU16(ptr, status.voltage);
+        *ptr = flags;
+
+        for (auto &client : clients_) {
+            vector<uint8_t> &tx = client.second.tx;
+
+            if (tx.size() >= kSendBufferSoft) {
+                dropped_frames_++;
+                continue;
+            }
+
+            tx.insert(tx.end(), frame.begin(), frame.end());
+            queued = true;
+        }
+
+        last_status_.assign(frame.begin(), frame.end());
+
+        // Under the lock: stop() empties clients_ before it closes wake_fd_
+        if (queued) {
+            wake();
+        }
+    }
+}
+
+void TcpBridge::wake() {
+    uint64_t one = 1;
+
+    if (write(wake_fd_, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+        DATC_LOG_ERROR("TCP bridge: %s", strerror(errno));
+    }
+}
+
+void TcpBridge::run() {
+    epoll_event events[kMaxEvents];
+
+    while (running_) {
+        const int n = epoll_wait(epoll_fd_, events, kMaxEvents, -1);
+
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            DATC_LOG_ERROR("TCP bridge: %s", strerror(errno));
+            break;
+        }
+
+        for (int i = 0; i < n; i++) {
+            const int fd = events[i].data.fd;
+
+            if (fd == listen_fd_) {
+                acceptClients();
+            } else if (fd == wake_fd_) {
+                uint64_t value;
+
+                if (read(wake_fd_, &value, sizeof(value)) < 0 && errno != EAGAIN) {
+                    DATC_LOG_ERROR("TCP bridge: %s", strerror(errno));
+                }
+
+                flushAll();
+            } else {
+                // Also reported for a client that is not being read
+                if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+                    closeClient(fd);
+                    continue;
+                }
+
+                if ((events[i].events & (EPOLLIN | EPOLLRDHUP)) && !readClient(fd)) {
+                    closeClient(fd);
+                    continue;
+                }
+
+                if (events[i].events & EPOLLOUT) {
+                    bool ok = true;
+
+                    {
+                        unique_lock<mutex> lg(mutex_);
+                        auto it = clients_.find(fd);
+
+                        if (it != clients_.end()) {
+                            ok = flushClient(fd, it->second);
+                        }
+                    }
+
+                    if (!ok) {
+                        closeClient(fd);
+                    }
+                }
+            }
+        }
+
+        // Sent or answered enough since they were paused
+        resumeClients();
+    }
+
+    running_ = false;
+}
+
+void TcpBridge::runCommands() {
+    while (true) {
+        Command command;
+
+        {
+            unique_lock<mutex> lg(command_mutex_);
+            command_cv_.wait(lg, [this] {return !running_ || !commands_.empty();});
+
+            if (!running_) {
+                return;
+            }
+
+            command = commands_.front();
+            commands_.pop_front();
+        }
+
+        // The bus transaction runs without mutex_, so status keeps being queued meanwhile
+        DATC_TRACE(service_entry, "tcp_command");
+        const bool success = handler_ && handler_(command.code, command.value_1, command.value_2);
+        DATC_TRACE(service_exit, "tcp_command", success);
+
+        array<uint8_t, kTcpHeaderSize + kTcpResultSize> reply;
+
+        uint8_t *ptr = putHeader(reply.data(), kTcpTypeResult, kTcpResultSize);
+        ptr = putU16(ptr, command.seq);
+        ptr = putU16(ptr, command.code);
+        *ptr = success;
+
+        unique_lock<mutex> lg(mutex_);
+        auto it = clients_.find(command.fd);
+
+        // Closed in the meantime
+        if (it == clients_.end() || it->second.id != command.client_id) {
+            continue;
+        }
+
+        // Results are never dropped, only status frames are. They are bounded by kMaxPendingCommands.
+        Client &client = it->second;
+        client.pending--;
+        client.tx.insert(client.tx.end(), reply.begin(), reply.end());
+
+        // The bridge thread sends it
+        wake();
+    }
+}
+
+void TcpBridge::acceptClients() {
+    while (true) {
+        const int fd = accept4(listen_fd_, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                DATC_LOG_ERROR("TCP bridge: accept: %s", strerror(errno));
+            }
+
+            return;
+        }
+
+        unique_lock<mutex> lg(mutex_);
+
+        if (clients_.size() >= kMaxClients) {
+            DATC_LOG_ERROR("TCP bridge: too many clients (%d), connection refused", (int) kMaxClients);
+            close(fd);
+            continue;
+        }
+
+        // Frames are small and latency matters more than packet count
+        const int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        epoll_event ev {};
+        ev.events  = EPOLLIN | EPOLLRDHUP;
+        ev.data.fd = fd;
+
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            DATC_LOG_ERROR("TCP bridge: %s", strerror(errno));
+            close(fd);
+            continue;
+        }
+
+        // A new client starts with the current status instead of waiting for the next change
+        Client &client = clients_[fd];
+        client.id     = ++next_client_id_;
+        client.events = ev.events;
+        client.tx     = last_status_;
+
+        if (!client.tx.empty()) {
+            flushClient(fd, client);
+        }
+    }
+}
+
+void TcpBridge::closeClient(int fd) {
+    unique_lock<mutex> lg(mutex_);
+
+    if (clients_.erase(fd) > 0) {
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, NULL);
+        close(fd);
+    }
+}
+
+// Bridge thread. Returns false when the client has to be closed.
+bool TcpBridge::readClient(int fd) {
+    Client *client;
+
+    {
+        // Only this thread inserts or erases clients, and rx is only used here
+        unique_lock<mutex> lg(mutex_);
+        auto it = clients_.find(fd);
+
+        if (it == clients_.end()) {
+            return true;
+        }
+
+        client = &it->second;
+
+        // Frames left over from a pause come first
+        if (!processFrames(fd, *client)) {
+            return false;
+        }
+    }
+
+    uint8_t buf[1024];
+
+    while (client->reading) {
+        const ssize_t len = recv(fd, buf, sizeof(buf), 0);
+
+        if (len == 0) {
+            return false;
+        }
+
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+
+            return false;
+        }
+
+        client->rx.insert(client->rx.end(), buf, buf + len);
+
+        unique_lock<mutex> lg(mutex_);
+
+        if (!processFrames(fd, *client)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Complete frames in rx, until the client reaches a limit. Then it is paused: its frames stay in the
+// socket, so TCP flow control holds the sender back, until resumeClients() picks it up again.
+bool TcpBridge::processFrames(int fd, Client &client) {
+    vector<uint8_t> &rx = client.rx;
+    size_t pos = 0;
+
+    while (rx.size() - pos >= kTcpHeaderSize) {
+        if (client.tx.size() >= kSendBufferHard || client.pending >= kMaxPendingCommands) {
+            client.reading = false;
+            updateEvents(fd, client);
+            break;
+        }
+
+        const uint8_t *frame  = rx.data() + pos;
+        const uint16_t length = getU16(frame + 2);
+
+        if (frame[0] != kTcpMagic || length > kTcpPayloadMax) {
+            DATC_LOG_ERROR("TCP bridge: protocol error, closing the client");
+            return false;
+        }
+
+        if (rx.size() - pos < kTcpHeaderSize + length) {
+            break;
+        }
+
+        const uint8_t *payload = frame + kTcpHeaderSize;
+
+        if (frame[1] == kTcpTypeCommand && length >= kTcpCommandSize) {
+            {
+                unique_lock<mutex> lg(command_mutex_);
+                commands_.push_back({fd, client.id, getU16(payload), getU16(payload + 2),
+                                     (int16_t) getU16(payload + 4), (int16_t) getU16(payload + 6)});
+            }
+
+            command_cv_.notify_one();
+            client.pending++;
+        } else if (frame[1] == kTcpTypePing && length >= kTcpPingSize) {
+            array<uint8_t, kTcpHeaderSize + kTcpPongSize> reply;
+            putU16(putHeader(reply.data(), kTcpTypePong, kTcpPongSize), getU16(payload));
+
+            client.tx.insert(client.tx.end(), reply.begin(), reply.end());
+        }
+
+        // Unknown types are skipped, so that newer clients still work with this server
+        pos += kTcpHeaderSize + length;
+    }
+
+    rx.erase(rx.begin(), rx.begin() + pos);
+
+    return client.tx.empty() || flushClient(fd, client);
+}
+
+// mutex_ held. Sends what the socket takes and waits for EPOLLOUT for the rest.
+bool TcpBridge::flushClient(int fd, Client &client) {
+    size_t sent = 0;
+
+    while (sent < client.tx.size()) {
+        const ssize_t len = send(fd, client.tx.data() + sent, client.tx.size() - sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+
+            return false;
+        }
+
+        sent += len;
+    }
+
+    client.tx.erase(client.tx.begin(), client.tx.begin() + sent);
+    client.want_write = !client.tx.empty();
+    updateEvents(fd, client);
+
+    return true;
+}
+
+// mutex_ held
+void TcpBridge::updateEvents(int fd, Client &client) {
+    const uint32_t events = (client.reading ? (uint32_t) (EPOLLIN | EPOLLRDHUP) : 0) |
+                            (client.want_write ? (uint32_t) EPOLLOUT : 0);
+
+    if (events != client.events) {
+        epoll_event ev {};
+        ev.events  = events;
+        ev.data.fd = fd;
+
+        epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev);
+        client.events = events;
+    }
+}
+
+void TcpBridge::flushAll() {
+    vector<int> failed;
+
+    {
+        unique_lock<mutex> lg(mutex_);
+
+        for (auto &client : clients_) {
+            if (!client.second.tx.empty() && !flushClient(client.first, client.second)) {
+                failed.push_back(client.first);
+            }
+        }
+    }
+
+    for (int fd : failed) {
+        closeClient(fd);
+    }
+}
+
+// Bridge thread. Picks up the paused clients that are back under the limits.
+void TcpBridge::resumeClients() {
+    vector<int> resumed;
+
+    {
+        unique_lock<mutex> lg(mutex_);
+
+        for (auto &client : clients_) {
+            Client &c = client.second;
+
+            if (!c.reading && c.tx.size() < kSendBufferHard && c.pending < kMaxPendingCommands) {
+                c.reading = true;
+                updateEvents(client.first, c);
+                resumed.push_back(client.first);
+            }
+        }
+    }
+
+    for (int fd : resumed) {
+        if (!readClient(fd)) {
+            closeClient(fd);
+        }
+    }
+}
@@ -0,0 +1,256 @@
+/**
+ * @file telemetry_plot.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief Finger position / motor current history plot.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "telemetry_plot.hpp"
+
+#include <QPainter>
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QFileDialog>
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+const QColor kFingerColor("#1F77B4");
+const QColor kCurrentColor("#FF7F0E");
+const QColor kGridColor("#DDDDDD");
+const QColor kTextColor("#555555");
+
+TelemetryPlot::TelemetryPlot(TelemetryBuffer &buffer, QWidget *parent) : QWidget(parent), buffer_(buffer) {
+    setMinimumSize(400, 200);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
+    updateTimeLabels();
+
+    timer_ = new QTimer(this);
+    connect(timer_, SIGNAL(timeout()), this, SLOT(refresh()));
+    timer_->start(kTelemetryRefreshMs);
+}
+
+void TelemetryPlot::setWindowLength(double sec) {
+    window_sec_ = sec;
+    updateTimeLabels();
+    update();
+}
+
+void TelemetryPlot::setPaused(bool paused) {
+    paused_ = paused;
+    count_drawn_ = 0;
+}
+
+void TelemetryPlot::refresh() {
+    if (paused_ || !isVisible()) {
+        return;
+    }
+
+    const uint64_t count = buffer_.getCount();
+
+    if (count == count_drawn_) {
+        return;
+    }
+
+    count_drawn_ = count;
+    buffer_.getLatestTime(t_end_);
+    update();
+}
+
+QRectF TelemetryPlot::plotArea() const {
+    return QRectF(60, 10, std::max(width() - 130, 1), std::max(height() - 40, 1));
+}
+
+void TelemetryPlot::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+
+    const size_t n_columns = (size_t) plotArea().width();
+
+    columns_.resize(n_columns);
+    lines_finger_.resize(2 * n_columns);
+    lines_cur_.resize(2 * n_columns);
+}
+
+void TelemetryPlot::updateTimeLabels() {
+    for (int i = 0; i < 5; i++) {
+        time_labels_[i] = QString::number(-window_sec_ * (4 - i) / 4, 'g', 3) + " s";
+    }
+}
+
+void TelemetryPlot::paintEvent(QPaintEvent *) {
+    QPainter painter(this);
+    painter.fillRect(rect(), Qt::white);
+
+    const QRectF area = plotArea();
+    const size_t n_columns = columns_.size();
+
+    // Grid & time axis
+    painter.setPen(kGridColor);
+
+    for (int i = 0; i <= 4; i++) {
+        const double y = area.top() + area.height() * i / 4;
+        const double x = area.left() + area.width() * i / 4;
+
+        painter.drawLine(QPointF(area.left(), y), QPointF(area.right(), y));
+        painter.drawLine(QPointF(x, area.top()), QPointF(x, area.bottom()));
+    }
+
+    painter.setPen(kTextColor);
+
+    for (int i = 0; i <= 4; i++) {
+        const double x = area.left() + area.width() * i / 4;
+        painter.drawText(QRectF(x - 40, area.bottom() + 4, 80, 20), Qt::AlignHCenter | Qt::AlignTop, time_labels_[i]);
+    }
+
+    // Data
+    buffer_.decimate(t_end_ - window_sec_, t_end_, columns_.data(), n_columns);
+
+    float cur_abs = 100;
+
+    for (size_t i = 0; i < n_columns; i++) {
+        if (columns_[i].valid) {
+            cur_abs = std::max(cur_abs, std::max(std::fabs(columns_[i].cur_min), std::fabs(columns_[i].cur_max)));
+        }
+    }
+
+    const int cur_range = (int) std::ceil(cur_abs / 100) * 100;
+
+    if (cur_range != cur_range_) {
+        cur_range_ = cur_range;
+        cur_labels_[0] = "+" + QString::number(cur_range) + " mA";
+        cur_labels_[1] = "-" + QString::number(cur_range) + " mA";
+    }
+
+    auto fingerY = [&] (float v) {return area.bottom() - v / 100.0 * area.height();};
+    auto curY    = [&] (float v) {return area.center().y() - v / cur_range * area.height() / 2;};
+
+    size_t n_finger = 0, n_cur = 0;
+    long prev = -1;
+
+    for (size_t i = 0; i < n_columns; i++) {
+        const TelemetryColumn &col = columns_[i];
+
+        if (!col.valid) {
+            continue;
+        }
+
+        const double x = area.left() + i + 0.5;
+
+        if (prev >= 0 && prev == (long) i - 1) {
+            // Adjacent columns: stretch the vertical span so the trace stays connected
+            const TelemetryColumn &p = columns_[prev];
+
+            lines_finger_[n_finger++] = QLineF(x, fingerY(std::min(col.finger_min, p.finger_max)),
+                                               x, fingerY(std::max(col.finger_max, p.finger_min)));
+            lines_cur_[n_cur++]       = QLineF(x, curY(std::min(col.cur_min, p.cur_max)),
+                                               x, curY(std::max(col.cur_max, p.cur_min)));
+        } else {
+            if (prev >= 0) {
+                // Columns without samples in between: bridge with a straight segment
+                const TelemetryColumn &p = columns_[prev];
+                const double x_prev = area.left() + prev + 0.5;
+
+                lines_finger_[n_finger++] = QLineF(x_prev, fingerY((p.finger_min + p.finger_max) / 2),
+                                                   x, fingerY((col.finger_min + col.finger_max) / 2));
+                lines_cur_[n_cur++]       = QLineF(x_prev, curY((p.cur_min + p.cur_max) / 2),
+                                                   x, curY((col.cur_min + col.cur_max) / 2));
+            }
+
+            lines_finger_[n_finger++] = QLineF(x, fingerY(col.finger_min), x, fingerY(col.finger_max));
+            lines_cur_[n_cur++]       = QLineF(x, curY(col.cur_min), x, curY(col.cur_max));
+        }
+
+        prev = i;
+    }
+
+    painter.setClipRect(area);
+
+    painter.setPen(QPen(kCurrentColor, 1));
+    painter.drawLines(lines_cur_.data(), (int) n_cur);
+
+    painter.setPen(QPen(kFingerColor, 1));
+    painter.drawLines(lines_finger_.data(), (int) n_finger);
+
+    painter.setClipping(false);
+
+    // Value axes
+    painter.setPen(kFingerColor);
+    painter.drawText(QRectF(0, area.top() - 8, area.left() - 6, 16), Qt::AlignRight | Qt::AlignVCenter, "100 %");
+    painter.drawText(QRectF(0, area.bottom() - 8, area.left() - 6, 16), Qt::AlignRight | Qt::AlignVCenter, "0 %");
+
+    painter.setPen(kCurrentColor);
+    painter.drawText(QRectF(area.right() + 6, area.top() - 8, 70, 16), Qt::AlignLeft | Qt::AlignVCenter, cur_labels_[0]);
+    painter.drawText(QRectF(area.right() + 6, area.bottom() - 8, 70, 16), Qt::AlignLeft | Qt::AlignVCenter, cur_labels_[1]);
+}
+
+TelemetryWidget::TelemetryWidget(TelemetryBuffer &buffer, QWidget *parent) : QWidget(parent), buffer_(buffer) {
+    setStyleSheet("TelemetryWidget{background-color:#FFFFFF;}");
+    setAttribute(Qt::WA_StyledBackground);
+
+    plot_ = new TelemetryPlot(buffer_, this);
+
+    comboBox_window_ = new QComboBox(this);
+    comboBox_window_->addItem("10 s"  , 10.0);
+    comboBox_window_->addItem("30 s"  , 30.0);
+    comboBox_window_->addItem("1 min" , 60.0);
+    comboBox_window_->addItem("5 min" , 300.0);
+    comboBox_window_->addItem("10 min", 600.0);
+    comboBox_window_->setCurrentIndex(1);
+
+    pushButton_pause_ = new QPushButton("Pause", this);
+    pushButton_pause_->setCheckable(true);
+
+    pushButton_export_ = new QPushButton("Export CSV", this);
+
+    auto control_layout = new QHBoxLayout();
+    control_layout->addWidget(comboBox_window_);
+    control_layout->addWidget(pushButton_pause_);
+    control_layout->addStretch();
+    control_layout->addWidget(pushButton_export_);
+
+    auto layout = new QVBoxLayout(this);
+    layout->addLayout(control_layout);
+    layout->addWidget(plot_, 1);
+
+    connect(comboBox_window_, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this] (int index) {
+        plot_->setWindowLength(comboBox_window_->itemData(index).toDouble());
+    });
+
+    connect(pushButton_pause_, &QPushButton::toggled, this, [this] (bool checked) {
+        plot_->setPaused(checked);
+        pushButton_pause_->setText(checked ? "Resume" : "Pause");
+    });
+
+    connect(pushButton_export_, SIGNAL(clicked()), this, SLOT(exportCsv()));
+}
+
+void TelemetryWidget::exportCsv() {
+    QString file_name = QFileDialog::getSaveFileName(this, "Export telemetry", "telemetry.csv", "CSV (*.csv)");
+
+    if (file_name.isEmpty()) {
+        return;
+    }
+
+    vector<TelemetrySample> samples;
+    buffer_.copyTo(samples);
+
+    std::ofstream file(file_name.toStdString());
+
+    if (!file) {
+        std::cerr << "[ERROR] Failed to open " << file_name.toStdString() << std::endl;
+        return;
+    }
+
+    file << "time_sec,finger_position_percent,motor_current_mA\n";
+
+    for (const auto &s : samples) {
+        file << s.time << "," << s.finger_pos << "," << s.motor_cur << "\n";
+    }
+
+    std::cout << "[INFO] Exported " << samples.size() << " samples to " << file_name.toStdString() << std::endl;
+}
@@ -0,0 +1,370 @@
+/**
+ * @file tcp_bridge_test.cpp
+ * @author Inhwan Yoon (inhwan94@korea.ac.kr)
+ * @brief TcpBridge over loopback: framing, results to the sender only, the status stream, and that a
+ *        slow command or a client that does not read holds up no one else.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "tcp_bridge.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+
+using namespace std;
+
+const int kTimeoutMs = 2000;
+
+struct Frame {
+    uint8_t type = 0;
+    vector<uint8_t> payload;
+
+    uint16_t u16(size_t pos) const {return payload[pos] | (payload[pos + 1] << 8);}
+    uint32_t u32(size_t pos) const {return u16(pos) | ((uint32_t) u16(pos + 2) << 16);}
+};
+
+class LoopbackClient {
+public:
+    // buffer_size > 0: small socket buffers, so that the bridge sees a slow reader sooner
+    explicit LoopbackClient(uint16_t port, int buffer_size = 0) {
+        fd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+        if (buffer_size > 0) {
+            setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+            setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+        }
+
+        sockaddr_in sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sin_family      = AF_INET;
+        sa.sin_port        = htons(port);
+        sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        connected_ = connect(fd_, (sockaddr *) &sa, sizeof(sa)) == 0;
+    }
+
+    ~LoopbackClient() {
+        close(fd_);
+    }
+
+    bool isConnected() const {return connected_;}
+
+    bool sendFrame(uint8_t type, const vector<uint16_t> &values) {
+        vector<uint8_t> frame = {kTcpMagic, type, (uint8_t) (2 * values.size()), 0};
+
+        for (uint16_t value : values) {
+            frame.push_back(value & 0xFF);
+            frame.push_back(value >> 8);
+        }
+
+        return sendRaw(frame);
+    }
+
+    bool sendRaw(const vector<uint8_t> &bytes) {
+        return send(fd_, bytes.data(), bytes.size(), MSG_NOSIGNAL) == (ssize_t) bytes.size();
+    }
+
+    // The next frame of the given type, skipping status frames unless they are asked for
+    bool recvFrame(Frame &frame, uint8_t type, int timeout_ms = kTimeoutMs) {
+        while (true) {
+            uint8_t header[kTcpHeaderSize];
+
+            if (!recvAll(header, sizeof(header), timeout_ms) || header[0] != kTcpMagic) {
+                return false;
+            }
+
+            frame.type = header[1];
+            frame.payload.resize(header[2] | (header[3] << 8));
+
+            if (!recvAll(frame.payload.data(), frame.payload.size(), timeout_ms)) {
+                return false;
+            }
+
+            if (frame.type == type) {
+                return true;
+            }
+        }
+    }
+
+    // Up to size bytes, whatever has arrived within the timeout
+    size_t recvSome(uint8_t *buf, size_t size) {
+        pollfd pfd = {fd_, POLLIN, 0};
+
+        if (poll(&pfd, 1, kTimeoutMs) <= 0) {
+            return 0;
+        }
+
+        const ssize_t len = recv(fd_, buf, size, 0);
+        return len > 0 ? len : 0;
+    }
+
+    // true once the server has closed the connection
+    bool waitClosed() {
+        uint8_t buf[256];
+
+        while (true) {
+            pollfd pfd = {fd_, POLLIN, 0};
+
+            if (poll(&pfd, 1, kTimeoutMs) <= 0) {
+                return false;
+            }
+
+            const ssize_t len = recv(fd_, buf, sizeof(buf), 0);
+
+            if (len <= 0) {
+                return true;
+            }
+        }
+    }
+
+private:
+    int fd_ = -1;
+    bool connected_ = false;
+
+    bool recvAll(uint8_t *buf, size_t size, int timeout_ms) {
+        size_t received = 0;
+
+        while (received < size) {
+            pollfd pfd = {fd_, POLLIN, 0};
+
+            if (poll(&pfd, 1, timeout_ms) <= 0) {
+                return false;
+            }
+
+            const ssize_t len = recv(fd_, buf + received, size - received, 0);
+
+            if (len <= 0) {
+                return false;
+            }
+
+            received += len;
+        }
+
+        return true;
+    }
+};
+
+class TcpBridgeTest : public ::testing::Test {
+protected:
+    TcpBridge bridge_;
+
+    void start(TcpBridge::CommandHandler handler) {
+        ASSERT_TRUE(bridge_.start("127.0.0.1", 0, handler));
+        ASSERT_NE(bridge_.getPort(), 0);
+    }
+
+    void TearDown() override {
+        bridge_.stop();
+    }
+};
+
+TEST_F(TcpBridgeTest, CommandResultGoesToTheSender) {
+    uint16_t code = 0;
+    int16_t value_1 = 0, value_2 = 0;
+
+    start([&] (uint16_t c, int16_t v1, int16_t v2) {
+        code = c;
+        value_1 = v1;
+        value_2 = v2;
+        return c == (uint16_t) DATC_COMMAND::GRIPPER_CLOSE;
+    });
+
+    LoopbackClient client(bridge_.getPort());
+    ASSERT_TRUE(client.isConnected());
+
+    ASSERT_TRUE(client.sendFrame(kTcpTypeCommand, {7, (uint16_t) DATC_COMMAND::GRIPPER_CLOSE, 500, (uint16_t) -3}));
+
+    Frame result;
+    ASSERT_TRUE(client.recvFrame(result, kTcpTypeResult));
+    ASSERT_EQ(result.payload.size(), 5u);
+    EXPECT_EQ(result.u16(0), 7);
+    EXPECT_EQ(result.u16(2), (uint16_t) DATC_COMMAND::GRIPPER_CLOSE);
+    EXPECT_EQ(result.payload[4], 1);
+
+    EXPECT_EQ(code, (uint16_t) DATC_COMMAND::GRIPPER_CLOSE);
+    EXPECT_EQ(value_1, 500);
+    EXPECT_EQ(value_2, -3);
+
+    ASSERT_TRUE(client.sendFrame(kTcpTypeCommand, {8, (uint16_t) DATC_COMMAND::MOTOR_STOP, 0, 0}));
+    ASSERT_TRUE(client.recvFrame(result, kTcpTypeResult));
+    EXPECT_EQ(result.u16(0), 8);
+    EXPECT_EQ(result.payload[4], 0);
+}
+
+TEST_F(TcpBridgeTest, PingAndUnknownFrames) {
+    start(nullptr);
+
+    LoopbackClient client(bridge_.getPort());
+    ASSERT_TRUE(client.isConnected());
+
+    // Unknown types are skipped
+    ASSERT_TRUE(client.sendFrame(0x7F, {1, 2, 3}));
+    ASSERT_TRUE(client.sendFrame(kTcpTypePing, {42}));
+
+    Frame pong;
+    ASSERT_TRUE(client.recvFrame(pong, kTcpTypePong));
+    EXPECT_EQ(pong.u16(0), 42);
+}
+
+TEST_F(TcpBridgeTest, StatusToEveryClient) {
+    start(nullptr);
+
+    LoopbackClient client_1(bridge_.getPort()), client_2(bridge_.getPort());
+    ASSERT_TRUE(client_1.isConnected() && client_2.isConnected());
+
+    // Connected once a ping is answered
+    Frame frame;
+
+    for (LoopbackClient *client : {&client_1, &client_2}) {
+        ASSERT_TRUE(client->sendFrame(kTcpTypePing, {0}));
+        ASSERT_TRUE(client->recvFrame(frame, kTcpTypePong));
+    }
+
+    DatcStatus status;
+    status.motor_pos  = 1234;
+    status.finger_pos = -56;
+    bridge_.broadcastStatus(status, kTcpFlagConnected | kTcpFlagActive);
+
+    for (LoopbackClient *client : {&client_1, &client_2}) {
+        ASSERT_TRUE(client->recvFrame(frame, kTcpTypeStatus));
+        ASSERT_EQ(frame.payload.size(), 17u);
+        EXPECT_EQ(frame.u32(0), 1u);
+        EXPECT_EQ(frame.u16(6), 1234);
+        EXPECT_EQ((int16_t) frame.u16(12), -56);
+        EXPECT_EQ(frame.payload[16], kTcpFlagConnected | kTcpFlagActive);
+    }
+
+    // A late client starts with the last status
+    LoopbackClient client_3(bridge_.getPort());
+    ASSERT_TRUE(client_3.recvFrame(frame, kTcpTypeStatus));
+    EXPECT_EQ(frame.u32(0), 1u);
+}
+
+TEST_F(TcpBridgeTest, SlowCommandDoesNotStallOtherClients) {
+    promise<void> release;
+    shared_future<void> released = release.get_future().share();
+
+    start([released] (uint16_t, int16_t, int16_t) {
+        released.wait();
+        return true;
+    });
+
+    LoopbackClient slow(bridge_.getPort()), other(bridge_.getPort());
+    ASSERT_TRUE(slow.isConnected() && other.isConnected());
+
+    ASSERT_TRUE(slow.sendFrame(kTcpTypeCommand, {1, (uint16_t) DATC_COMMAND::GRIPPER_INITIALIZE, 0, 0}));
+
+    // Answered while the command is still running
+    Frame frame;
+    ASSERT_TRUE(other.sendFrame(kTcpTypePing, {9}));
+    ASSERT_TRUE(other.recvFrame(frame, kTcpTypePong));
+    EXPECT_EQ(frame.u16(0), 9);
+
+    EXPECT_FALSE(slow.recvFrame(frame, kTcpTypeResult, 100));
+
+    release.set_value();
+    ASSERT_TRUE(slow.recvFrame(frame, kTcpTypeResult));
+    EXPECT_EQ(frame.u16(0), 1);
+}
+
+TEST_F(TcpBridgeTest, QueuedCommandsAreAllAnswered) {
+    promise<void> release;
+    shared_future<void> released = release.get_future().share();
+
+    start([released] (uint16_t, int16_t, int16_t) {
+        released.wait();
+        return true;
+    });
+
+    LoopbackClient client(bridge_.getPort());
+    ASSERT_TRUE(client.isConnected());
+
+    // More than a client may have pending: the rest wait in the socket
+    const uint16_t kCommands = 40;
+
+    for (uint16_t seq = 0; seq < kCommands; seq++) {
+        ASSERT_TRUE(client.sendFrame(kTcpTypeCommand, {seq, (uint16_t) DATC_COMMAND::MOTOR_STOP, 0, 0}));
+    }
+
+    release.set_value();
+
+    Frame frame;
+
+    for (uint16_t seq = 0; seq < kCommands; seq++) {
+        ASSERT_TRUE(client.recvFrame(frame, kTcpTypeResult));
+        EXPECT_EQ(frame.u16(0), seq);
+    }
+}
+
+TEST_F(TcpBridgeTest, ClientThatDoesNotReadIsPaused) {
+    start(nullptr);
+
+    LoopbackClient flood(bridge_.getPort(), 16 * 1024), other(bridge_.getPort());
+    ASSERT_TRUE(flood.isConnected() && other.isConnected());
+
+    // Far more pongs than the socket buffers (up to 4 MB on the bridge side) and the send limit hold,
+    // from a thread of its own: once the bridge stops reading, the send blocks
+    const int kPings = 2000000;
+
+    auto sender = async(launch::async, [&flood] {
+        vector<uint8_t> bytes;
+
+        for (int i = 0; i < kPings; i++) {
+            bytes.insert(bytes.end(), {kTcpMagic, kTcpTypePing, 2, 0, (uint8_t) (i & 0xFF), (uint8_t) ((i >> 8) & 0xFF)});
+        }
+
+        return flood.sendRaw(bytes);
+    });
+
+    EXPECT_EQ(sender.wait_for(chrono::milliseconds(500)), future_status::timeout);
+
+    Frame frame;
+    ASSERT_TRUE(other.sendFrame(kTcpTypePing, {5}));
+    ASSERT_TRUE(other.recvFrame(frame, kTcpTypePong));
+
+    // Reading again resumes it, and no pong is lost on the way
+    const uint8_t kPongSize = kTcpHeaderSize + 2;
+    vector<uint8_t> rx(64 * 1024);
+    size_t rx_len = 0;
+
+    for (int i = 0; i < kPings; ) {
+        const size_t len = flood.recvSome(rx.data() + rx_len, rx.size() - rx_len);
+        ASSERT_GT(len, 0u) << "after " << i << " pongs";
+        rx_len += len;
+
+        size_t pos = 0;
+
+        for (; rx_len - pos >= kPongSize; pos += kPongSize, i++) {
+            ASSERT_EQ(rx[pos + 1], kTcpTypePong);
+            ASSERT_EQ(rx[pos + 4] | (rx[pos + 5] << 8), i & 0xFFFF);
+        }
+
+        rx.erase(rx.begin(), rx.begin() + pos);
+        rx.resize(64 * 1024);
+        rx_len -= pos;
+    }
+
+    EXPECT_TRUE(sender.get());
+}
+
+TEST_F(TcpBridgeTest, ProtocolErrorClosesTheClient) {
+    start(nullptr);
+
+    LoopbackClient client(bridge_.getPort());
+    ASSERT_TRUE(client.isConnected());
+
+    ASSERT_TRUE(client.sendRaw({0x00, kTcpTypePing, 2, 0, 0, 0}));
+    EXPECT_TRUE(client.waitClosed());
+}